@@ -47,9 +47,12 @@
 #include "nrf_gpio.h"
 #include "nrf_drv_i2s.h"
 #include "nrf_drv_twi.h"
+#include "app_util_platform.h"
 #include "string.h"
 
 #include "ping_config.h"
+#include "ping_ring.h"
+#include "ping_profile.h"
 
 static nrf_drv_twi_t              m_twi_instance   = NRF_DRV_TWI_INSTANCE(DRV_SGTL5000_TWI_INSTANCE);
 
@@ -64,9 +67,15 @@ static float                      m_volume;
 static struct
 {
     uint32_t * tx_buffer;
-    uint32_t * rx_buffer;
     uint32_t   buffer_size_words; 
 } m_external_i2s_buffer;
+
+/* Buffer rotation state. RX buffers come from the ping_ring.c pool, TX alternates between the two halves of tx_buffer.
+   The first buffer request after a start is expected to have nothing released, any later one means the buffers were
+   supplied too late and the peripheral has reused the previous ones, overwriting a frame. */
+static uint8_t                    m_tx_next_half;
+static bool                       m_first_request;
+static volatile drv_sgtl5000_stats_t m_stats;
      
 /* Definition of TWI states */
 static volatile enum
@@ -115,6 +124,36 @@ static void twi_event_handler(nrf_drv_twi_evt_t const * p_event, void * p_contex
     }
 }
 
+/* Resets the buffer rotation and returns the buffers for nrf_drv_i2s_start. The second TX half and the next RX buffer follow on the first request. */
+static nrf_drv_i2s_buffers_t sgtl5000_rotation_start(void)
+{
+    nrf_drv_i2s_buffers_t initial_buffers;
+
+    initial_buffers.p_rx_buffer = ping_ring_start();
+    initial_buffers.p_tx_buffer = m_external_i2s_buffer.tx_buffer;
+
+    m_tx_next_half  = 1;
+    m_first_request = true;
+
+    return initial_buffers;
+}
+
+
+/* Supplies the next RX/TX pair. Called on every NRFX_I2S_STATUS_NEXT_BUFFERS_NEEDED event, so both halves keep rotating whatever the module state. */
+static uint32_t * sgtl5000_rotation_next(uint32_t * p_rx_released, bool publish)
+{
+    nrf_drv_i2s_buffers_t next_buffers;
+
+    next_buffers.p_rx_buffer = ping_ring_supply(p_rx_released, publish);
+    next_buffers.p_tx_buffer = &m_external_i2s_buffer.tx_buffer[m_tx_next_half * (m_external_i2s_buffer.buffer_size_words/2)];
+    m_tx_next_half ^= 1;
+
+    APP_ERROR_CHECK(nrf_drv_i2s_next_buffers_set(&next_buffers));
+
+    return next_buffers.p_rx_buffer;
+}
+
+
 /* I2S event handler matching SDK v14.2 implementation - will be invoked from the SDK v15 I2S event handler in order to ensure compatibility */
 static void i2s_data_handler_old(uint32_t const * p_data_received, uint32_t * p_data_to_send, uint16_t number_of_words)
 {
@@ -165,11 +204,6 @@ static void i2s_data_handler_old(uint32_t const * p_data_received, uint32_t * p_
 
 uint32_t Num_Mic_Samples = 0;
 
-int16_t *Current_RX_Buffer;
-
-bool bCaptureRx = false;
-uint32_t RxTimeBeg, RxTimeDelta;
-
 /* I2S event handler. Based on the module state, will play sample, playback microphone data, or forward events to the application */
 static void i2s_data_handler(nrf_drv_i2s_buffers_t const * p_released,
                          uint32_t                      status)
@@ -179,59 +213,68 @@ static void i2s_data_handler(nrf_drv_i2s_buffers_t const * p_released,
         return;
     }
     
-    if (p_released == NULL) 
-    {
-        // Regardless of module state, when p_released is NULL, we provide the next buffers (to keep implementation a little simpler)
-        nrf_drv_i2s_buffers_t const next_buffers = {
-            .p_rx_buffer = &m_external_i2s_buffer.rx_buffer[m_external_i2s_buffer.buffer_size_words/2],
-            .p_tx_buffer = &m_external_i2s_buffer.tx_buffer[m_external_i2s_buffer.buffer_size_words/2],
-        };
-        APP_ERROR_CHECK(nrf_drv_i2s_next_buffers_set(&next_buffers));
-        
-        //  i2s_data_handler_old(NULL, &m_external_i2s_buffer.tx_buffer[m_external_i2s_buffer.buffer_size_words/2], m_external_i2s_buffer.buffer_size_words/2);
-    }
-    else if (p_released->p_rx_buffer == NULL)
+    PING_PROFILE_BEGIN(PING_PROFILE_I2S_ISR);
+
+    if (p_released == NULL || p_released->p_rx_buffer == NULL)
     {
+        // Nothing received. Expected right after a start, otherwise the previous buffers were supplied too late
+        // and the peripheral has filled the same RX buffer twice, losing a frame.
+        uint32_t * p_tx_next = &m_external_i2s_buffer.tx_buffer[m_tx_next_half * (m_external_i2s_buffer.buffer_size_words/2)];
 
-	NRF_LOG_RAW_INFO("RX is NULL\r\n");
-	
-        // If RX buffer is NULL, no data has been received, and we need to provide the next buffers. Nothing else done (to keep implementation a little simpler).
-        nrf_drv_i2s_buffers_t const next_buffers = {
-            .p_rx_buffer = &m_external_i2s_buffer.rx_buffer[m_external_i2s_buffer.buffer_size_words/2],
-            .p_tx_buffer = &m_external_i2s_buffer.tx_buffer[m_external_i2s_buffer.buffer_size_words/2],
-        };
-        APP_ERROR_CHECK(nrf_drv_i2s_next_buffers_set(&next_buffers));
+        if (m_first_request)
+        {
+            m_first_request = false;
+        }
+        else
+        {
+            m_stats.late_supplies++;
+            m_stats.dropped_frames++;
+        }
+
+        (void) sgtl5000_rotation_next(NULL, false);
         
-        i2s_data_handler_old(NULL, &m_external_i2s_buffer.tx_buffer[m_external_i2s_buffer.buffer_size_words/2], m_external_i2s_buffer.buffer_size_words/2);
+        if (p_released != NULL)
+        {
+            i2s_data_handler_old(NULL, p_tx_next, m_external_i2s_buffer.buffer_size_words/2);
+        }
     }
     else
     {
+        bool running = (m_state == SGTL5000_STATE_RUNNING);
+        uint32_t * p_rx_next;
 
 	Num_Mic_Samples++;
-		
-        if (m_state == SGTL5000_STATE_RUNNING)
-        {
-		if(bCaptureRx)
-		{
 
-			NRF_LOG_RAW_INFO("Capturing!!\r\n");
-		
-			RxTimeBeg = ElapsedTimeInMilliseconds();
-			Current_RX_Buffer = (int16_t *) p_released->p_rx_buffer ;
-
-			// Capture sample
-			memcpy(Rx_Buffer, Current_RX_Buffer, FFT_SAMPLE_SIZE * sizeof(uint32_t));
-			bCaptureRx = false;
-
-			RxTimeDelta = ElapsedTimeInMilliseconds() -RxTimeBeg ;
-		}
+        m_first_request = false;
+        m_stats.frames_received++;
 
+        // The filled buffer goes to the processing loop as it is and a free one from the pool
+        // takes its place, no copy.  When the I2S only provides a clock the same buffer is reused.
+        p_rx_next = sgtl5000_rotation_next(p_released->p_rx_buffer, running);
+		
+        if (!running)
+        {
+            // I2S only running in order to provide clock
         }
-        else 
+        else if (p_rx_next == p_released->p_rx_buffer)
         {
-            // We do not handle this scenario
+            // The processing loop holds every spare buffer, this frame is overwritten
+            m_stats.dropped_frames++;
+        }
+        else
+        {
+            drv_sgtl5000_evt_t evt;
+
+            // Let the application know about every frame handed over, it now belongs to the frame ring consumer
+            evt.evt                                     = DRV_SGTL5000_EVT_I2S_RX_BUF_RECEIVED;
+            evt.param.rx_buf_received.number_of_words   = m_external_i2s_buffer.buffer_size_words/2;
+            evt.param.rx_buf_received.p_data_received   = p_released->p_rx_buffer;
+
+            m_i2s_evt_handler(&evt);
         }
     }
+
+    PING_PROFILE_END(PING_PROFILE_I2S_ISR);
 }
 
 
@@ -262,7 +305,6 @@ uint32_t drv_sgtl5000_init(drv_sgtl5000_init_t * p_params)
     
     
     if (p_params->i2s_tx_buffer             == 0 ||
-        p_params->i2s_rx_buffer             == 0 ||
         p_params->i2s_buffer_size_words     == 0 ||
         p_params->i2s_evt_handler           == 0 ||
         p_params->fs                        != DRV_SGTL5000_FS_31250HZ)
@@ -280,7 +322,6 @@ uint32_t drv_sgtl5000_init(drv_sgtl5000_init_t * p_params)
     // Update configuration
     m_i2s_evt_handler                           = p_params->i2s_evt_handler;
     m_external_i2s_buffer.tx_buffer             = p_params->i2s_tx_buffer;
-    m_external_i2s_buffer.rx_buffer             = p_params->i2s_rx_buffer;
     m_external_i2s_buffer.buffer_size_words     = p_params->i2s_buffer_size_words;
     
     // Initialize TWI interface 
@@ -543,10 +584,7 @@ static void sgtl5000_mclk_enable(void)
     
     APP_ERROR_CHECK(err_code);
     
-    nrf_drv_i2s_buffers_t const initial_buffers = {
-        .p_tx_buffer = m_external_i2s_buffer.tx_buffer,
-        .p_rx_buffer = m_external_i2s_buffer.rx_buffer,
-    };
+    nrf_drv_i2s_buffers_t const initial_buffers = sgtl5000_rotation_start();
     err_code = nrf_drv_i2s_start(&initial_buffers, (m_external_i2s_buffer.buffer_size_words/2), 0);
     APP_ERROR_CHECK(err_code);
 }
@@ -682,10 +720,7 @@ uint32_t drv_sgtl5000_start(void)
     if (m_state == SGTL5000_STATE_IDLE)
     {
         m_state = SGTL5000_STATE_RUNNING;
-        nrf_drv_i2s_buffers_t const initial_buffers = {
-            .p_tx_buffer = m_external_i2s_buffer.tx_buffer,
-            .p_rx_buffer = m_external_i2s_buffer.rx_buffer,
-        };
+        nrf_drv_i2s_buffers_t const initial_buffers = sgtl5000_rotation_start();
         (void)nrf_drv_i2s_start(&initial_buffers, (m_external_i2s_buffer.buffer_size_words/2), 0);
         
         return NRF_SUCCESS;
@@ -702,10 +737,7 @@ uint32_t drv_sgtl5000_start_mic_listen(void)
     if (m_state == SGTL5000_STATE_IDLE)
     {
         m_state = SGTL5000_STATE_RUNNING;
-        nrf_drv_i2s_buffers_t const initial_buffers = {
-            .p_tx_buffer = m_external_i2s_buffer.tx_buffer,
-            .p_rx_buffer = m_external_i2s_buffer.rx_buffer,
-        };
+        nrf_drv_i2s_buffers_t const initial_buffers = sgtl5000_rotation_start();
         (void)nrf_drv_i2s_start(&initial_buffers, (m_external_i2s_buffer.buffer_size_words/2), 0);
         
         return NRF_SUCCESS;
@@ -720,10 +752,7 @@ uint32_t drv_sgtl5000_start_mic_loopback(void)
     if (m_state == SGTL5000_STATE_IDLE)
     {
         m_state = SGTL5000_STATE_RUNNING_LOOPBACK;
-        nrf_drv_i2s_buffers_t const initial_buffers = {
-            .p_tx_buffer = m_external_i2s_buffer.tx_buffer,
-            .p_rx_buffer = m_external_i2s_buffer.rx_buffer,
-        };
+        nrf_drv_i2s_buffers_t const initial_buffers = sgtl5000_rotation_start();
         (void)nrf_drv_i2s_start(&initial_buffers, (m_external_i2s_buffer.buffer_size_words/2), 0);
         
         return NRF_SUCCESS;
@@ -748,6 +777,24 @@ uint32_t drv_sgtl5000_stop(void)
 }
 
 
+/* Copies the I2S streaming counters. Frames received plus dropped frames account for every frame period since the counters were cleared. */
+void drv_sgtl5000_stats_get(drv_sgtl5000_stats_t * p_stats)
+{
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_stats;
+    CRITICAL_REGION_EXIT();
+}
+
+
+/* Clears the I2S streaming counters */
+void drv_sgtl5000_stats_clear(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset((void *) &m_stats, 0, sizeof(m_stats));
+    CRITICAL_REGION_EXIT();
+}
+
+
 /* drv_sgtl5000_volume_set has not been tested nor verified working */
 uint32_t drv_sgtl5000_volume_set(float volume_db)
 {
@@ -72,8 +72,8 @@
 #define DRV_SGTL5000_TWI_PIN_SCL        ARDUINO_SCL_PIN  /* 27 for both DKs */
 #define DRV_SGTL5000_TWI_PIN_SDA        ARDUINO_SDA_PIN  /* 26 for both DKs */
 
-/* I2S Settings */
-#define DRV_SGTL5000_I2S_IRQPriority    DRV_SGTL5000_EGU_IRQPriority
+/* I2S Settings - one level above the lowest, so the application can run its frame processing at the lowest priority without delaying the buffer rotation */
+#define DRV_SGTL5000_I2S_IRQPriority    APP_IRQ_PRIORITY_LOW
 
 /* I2S pin mapping */
 #define DRV_SGTL5000_I2S_PIN_MCLK       ARDUINO_11_PIN  /* 23 for nRF52832 DK, 1,13 for 52840 */
@@ -130,10 +130,17 @@ typedef struct
     drv_sgtl5000_handler_t     i2s_evt_handler;
     drv_sgtl5000_sample_freq_t fs;
     void *                     i2s_tx_buffer;           /* Pointer to I2S TX double-buffer (should be 2 x uncompressed frame size) */
-    void *                     i2s_rx_buffer;           /* Pointer to I2S RX  */
-    uint32_t                   i2s_buffer_size_words;   /* Size of buffer (number of 32-bit words) */ 
+    uint32_t                   i2s_buffer_size_words;   /* Size of buffer (number of 32-bit words), RX frames come from the ping_ring.c pool */ 
 } drv_sgtl5000_init_t;
 
+/* SGTL5000 I2S streaming counters, see drv_sgtl5000_stats_get */
+typedef struct
+{
+    uint32_t frames_received;   /* RX buffers released by the I2S peripheral */
+    uint32_t late_supplies;     /* Buffer requests answered after the peripheral had already reused the previous buffers */
+    uint32_t dropped_frames;    /* Frames overwritten, either by a late supply or because the processing loop held every spare buffer */
+} drv_sgtl5000_stats_t;
+
 
 /****************************************/
 /* SGTL5000 driver function definitions */
@@ -146,6 +153,8 @@ extern uint32_t drv_sgtl5000_stop(void);
 extern uint32_t drv_sgtl5000_volume_set(float volume_db);
 extern uint32_t drv_sgtl5000_volume_get(float * p_volume_db);
 extern uint32_t drv_sgtl5000_start_mic_listen(void);
+extern void drv_sgtl5000_stats_get(drv_sgtl5000_stats_t * p_stats);
+extern void drv_sgtl5000_stats_clear(void);
 
 
 /* SGTL5000 Register definitions */
@@ -0,0 +1,21 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		app_util_platform.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Host stand-in for the nRF5 SDK header of the same name.  The replay
+//						runs everything on one thread, so critical regions are empty.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef APP_UTIL_PLATFORM_H__
+#define APP_UTIL_PLATFORM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CRITICAL_REGION_ENTER()		{
+#define CRITICAL_REGION_EXIT()		}
+
+#endif //  APP_UTIL_PLATFORM_H__
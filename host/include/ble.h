@@ -0,0 +1,15 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ble.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Host stand-in for the nRF5 SDK header of the same name, nothing the
+//						pipeline sources use
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BLE_H
+#define BLE_H
+
+#endif //  BLE_H
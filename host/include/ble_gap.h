@@ -0,0 +1,24 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ble_gap.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Host stand-in for the S132 header of the same name, for the types
+//						ping_config.h refers to
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BLE_GAP_H__
+#define BLE_GAP_H__
+
+#include <stdint.h>
+
+typedef struct
+{
+	uint8_t addr_id_peer : 1;
+	uint8_t addr_type    : 7;
+	uint8_t addr[6];
+} ble_gap_addr_t;
+
+#endif //  BLE_GAP_H__
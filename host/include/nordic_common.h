@@ -0,0 +1,23 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		nordic_common.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Host stand-in for the nRF5 SDK header of the same name
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NORDIC_COMMON_H__
+#define NORDIC_COMMON_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MIN(a, b)				((a) < (b) ? (a) : (b))
+#define MAX(a, b)				((a) < (b) ? (b) : (a))
+
+#define UNUSED_PARAMETER(X)		((void) (X))
+#define UNUSED_VARIABLE(X)		((void) (X))
+
+#endif //  NORDIC_COMMON_H__
@@ -0,0 +1,21 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		nrf.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Host stand-in for the nRF5 SDK header of the same name, only what the
+//						pipeline sources use
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NRF_H
+#define NRF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Full barrier, as the Cortex-M4 DMB
+#define __DMB()		__sync_synchronize()
+
+#endif //  NRF_H
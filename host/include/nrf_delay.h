@@ -0,0 +1,15 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		nrf_delay.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Host stand-in for the nRF5 SDK header of the same name, nothing the
+//						pipeline sources use
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NRF_DELAY_H
+#define NRF_DELAY_H
+
+#endif //  NRF_DELAY_H
@@ -0,0 +1,15 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		nrf_gpio.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Host stand-in for the nRF5 SDK header of the same name, nothing the
+//						pipeline sources use
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NRF_GPIO_H
+#define NRF_GPIO_H
+
+#endif //  NRF_GPIO_H
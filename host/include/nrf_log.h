@@ -0,0 +1,24 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		nrf_log.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Host stand-in for the nRF5 SDK header of the same name.  Log output
+//						goes to stderr, stdout is left to the tools.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NRF_LOG_H_
+#define NRF_LOG_H_
+
+#include <stdio.h>
+
+#define NRF_LOG_RAW_INFO(...)		fprintf(stderr, __VA_ARGS__)
+#define NRF_LOG_INFO(...)			(fprintf(stderr, __VA_ARGS__), fputs("\n", stderr))
+#define NRF_LOG_ERROR(...)			(fprintf(stderr, __VA_ARGS__), fputs("\n", stderr))
+#define NRF_LOG_PUSH(pStr)			(pStr)
+#define NRF_LOG_FLUSH()				((void) 0)
+#define NRF_LOG_PROCESS()			false
+
+#endif //  NRF_LOG_H_
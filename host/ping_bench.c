@@ -0,0 +1,1200 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_bench.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Detection accuracy and latency benchmark of the detector modes
+//
+//	Runs every detector mode over a labeled corpus (see ping_corpus.c) and writes a JSON
+//	report: per mode the time per frame, an ROC table and the outcome of every clip.
+//
+//	A clip is detected when the decoder of its label confirms at or after the onset; the
+//	time to detect runs from the onset to the confirmation.  Every confirmation of either
+//	decoder on audio without an alarm (the negative clips, and the alarm clips before their
+//	onset) is a false alarm.  The ROC points come from gating the tone decision with a
+//	minimum peak amplitude, 0 being what the firmware does.  The detectors run once per clip,
+//	only the temporal decoders are rerun for every point.
+//
+//	Frame times are the edge detector, siren tracker, capture and detect time on the host,
+//	for comparing runs only; cycles on target come from the "Profile" BLE command.  The
+//	gated and analysed counts are the inputs the energy gate skipped and passed to the
+//	detector.
+//
+//	The features object budgets the mel and MFCC stage (ping_mel.c): its constant tables and
+//	RAM, the arithmetic per spectrum, and its time per spectrum from the FFT detector run
+//	over the corpus at PING_MEL_FFT_SIZE.  The classifier object does the same for
+//	ping_nn.c per inference over that run, with the ping_nn_selftest() hash the target logs
+//	at boot.  Both are left out when -m picks another detector, or without PING_NN_ENABLED.
+//
+//	The edges object checks the pulse edge detector (ping_flux.c) against the nominal pulse
+//	timing of every alarm clip from its onset: an edge within BENCH_EDGE_TOLERANCE_MS of a
+//	pulse start or end of the same type matches it, any other edge is spurious.  It also
+//	counts what temporal decoders fed with the edges instead of the tone decisions confirm,
+//	scored as the modes are.  It is null without PING_FLUX_ENABLED.
+//
+//	The sirens object checks the sweep tracker (ping_siren.c) on the siren set of
+//	ping_corpus_sirens().  Every nominal rise and fall from the onset that ends at least
+//	BENCH_SWEEP_MARGIN_MS before the end of the clip is matched by a sweep of the right
+//	class and direction whose middle falls inside it, any other sweep is spurious.  The
+//	shapes and mean rates of the matched sweeps are checked against the siren, and the
+//	sweeps found on the corpus clips, none of which holds a siren, are counted as false.
+//	It is null without PING_SIREN_ENABLED.
+//
+//	Usage: ping_bench [-m mode] [-n fft_length] [-c manifest] [-s] [-o report.json]
+//
+//	-m	run only this detector (default all of PingHostModeName[])
+//	-n	analysis length (default PING_FFT_DEFAULT_SIZE)
+//	-c	add the recordings listed in a manifest, see ping_corpus_load()
+//	-s	leave out the synthetic corpus and the siren set
+//	-o	report file (default stdout)
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "nrf.h"
+#include "nordic_common.h"
+#include "nrf_log.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_fft.h"
+#include "ping_temporal.h"
+#include "ping_profile.h"
+#include "ping_tables.h"
+#include "ping_mel.h"
+#include "ping_nn.h"
+#include "ping_flux.h"
+#include "ping_siren.h"
+
+#include "ping_wav.h"
+#include "ping_host.h"
+#include "ping_corpus.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Minimum peak amplitudes of the ROC points, LSB
+static const float BenchMinAmplitude[] = { 0.0f, 25.0f, 50.0f, 100.0f, 200.0f, 400.0f, 800.0f, 1600.0f };
+
+#define BENCH_NUM_POINTS		(sizeof(BenchMinAmplitude) / sizeof(BenchMinAmplitude[0]))
+
+// Detector output of one frame that completed an input
+typedef struct
+{
+	uint32_t TimeMs;
+	ping_peak_t Peak;
+} bench_frame_t;
+
+// Detector output of one clip in one mode
+typedef struct
+{
+	bench_frame_t *pFrame;
+	uint32_t nFrames;
+	uint32_t nAlloc;
+} bench_run_t;
+
+// Capture plus detect time of every frame of every clip of one mode
+typedef struct
+{
+	uint32_t *pTicks;
+	uint32_t nTicks;
+	uint32_t nAlloc;
+} bench_ticks_t;
+
+// Context of Collect()
+typedef struct
+{
+	bench_run_t *pRun;
+	bench_ticks_t *pTicks;
+} bench_collect_t;
+
+// Outcome of one clip at one operating point
+typedef struct
+{
+	bool bDetected;
+	uint32_t TtdMs;
+	uint32_t nFalseAlarms;
+	uint32_t NegativeMs;		// audio without an alarm
+} bench_score_t;
+
+// Largest distance between a pulse edge and the nominal one it matches
+#define BENCH_EDGE_TOLERANCE_MS		25
+
+// One edge found in a clip
+typedef struct
+{
+	uint8_t Type;
+	uint32_t TimeMs;
+} bench_edge_t;
+
+// Context of CollectEdges(), the edges of one clip and the decoders they feed
+typedef struct
+{
+	const ping_corpus_clip_t *pClip;
+	bench_edge_t *pEdge;
+	uint32_t nEdges;
+	uint32_t nAlloc;
+	ping_temporal_t Decoder[PING_CORPUS_NUM_LABELS];
+	bench_score_t Score;
+} bench_edges_t;
+
+// Time the sweep tracker needs after the end of a sweep to see the siren turn, a sweep
+// ending closer to the end of its clip is not expected
+#define BENCH_SWEEP_MARGIN_MS		250
+
+// Sweeps found in a clip
+typedef struct
+{
+	ping_siren_sweep_t *pSweep;
+	uint32_t nSweeps;
+	uint32_t nAlloc;
+} bench_sweeps_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static void *GrowArray(void *pArray, uint32_t nCount, uint32_t *pAlloc, size_t nSize)
+{
+	void *pGrown;
+
+	if(nCount < *pAlloc)
+	{
+		return pArray;
+	}
+
+	*pAlloc = MAX(1024, 2 * *pAlloc);
+	pGrown = realloc(pArray, *pAlloc * nSize);
+
+	if(pGrown == NULL)
+	{
+		NRF_LOG_RAW_INFO("out of memory\n");
+		exit(1);
+	}
+
+	return pGrown;
+}
+
+static int CompareU32(const void *pA, const void *pB)
+{
+	uint32_t A = *(const uint32_t *) pA, B = *(const uint32_t *) pB;
+
+	return (A > B) - (A < B);
+}
+
+// Nearest rank percentile of a sorted array
+static uint32_t Percentile(const uint32_t *pSorted, uint32_t nCount, uint32_t nPercent)
+{
+	uint32_t nRank = (nCount * nPercent + 99) / 100;
+
+	return pSorted[(nRank > 0) ? nRank - 1 : 0];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The Collect() function is the ping_host_stream() handler, it records the frame time and,
+// for frames that completed an input, the peak.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void Collect(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+	bench_collect_t *pCollect = pContext;
+	bench_run_t *pRun = pCollect->pRun;
+	bench_ticks_t *pTicks = pCollect->pTicks;
+
+	pTicks->pTicks = GrowArray(pTicks->pTicks, pTicks->nTicks, &pTicks->nAlloc, sizeof(uint32_t));
+	pTicks->pTicks[pTicks->nTicks++] = pResult->FluxTicks + pResult->SirenTicks + pResult->CaptureTicks + pResult->DetectTicks;
+
+	if(!pResult->bReady)
+	{
+		return;
+	}
+
+	pRun->pFrame = GrowArray(pRun->pFrame, pRun->nFrames, &pRun->nAlloc, sizeof(bench_frame_t));
+	pRun->pFrame[pRun->nFrames].TimeMs = TimeMs;
+	pRun->pFrame[pRun->nFrames].Peak = pResult->Peak;
+	pRun->nFrames++;
+}
+
+#if PING_FLUX_ENABLED
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The CollectEdges() function is the ping_host_stream() handler of the edge run.  It keeps
+// the edges and feeds the pulse state to the decoders, at the edge time on an edge and at
+// the end of the frame otherwise, scoring their confirmations as Score() does.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void CollectEdges(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+	bench_edges_t *pEdges = pContext;
+	const ping_corpus_clip_t *pClip = pEdges->pClip;
+	uint32_t DecodeMs = TimeMs;
+	uint8_t Label;
+
+	if(pResult->Edge != PING_FLUX_EDGE_NONE)
+	{
+		pEdges->pEdge = GrowArray(pEdges->pEdge, pEdges->nEdges, &pEdges->nAlloc, sizeof(bench_edge_t));
+		pEdges->pEdge[pEdges->nEdges].Type = pResult->Edge;
+		pEdges->pEdge[pEdges->nEdges].TimeMs = pResult->EdgeMs;
+		pEdges->nEdges++;
+		DecodeMs = pResult->EdgeMs;
+	}
+
+	for(Label = PING_CORPUS_LABEL_T3; Label <= PING_CORPUS_LABEL_T4; Label++)
+	{
+		if(ping_temporal_update(&pEdges->Decoder[Label], bPingFluxPulse, DecodeMs) != PING_TEMPORAL_EVT_CONFIRMED)
+		{
+			continue;
+		}
+
+		if((pClip->Label == PING_CORPUS_LABEL_NONE) || (DecodeMs < pClip->OnsetMs))
+		{
+			pEdges->Score.nFalseAlarms++;
+		}
+		else if((Label == pClip->Label) && !pEdges->Score.bDetected)
+		{
+			pEdges->Score.bDetected = true;
+			pEdges->Score.TtdMs = DecodeMs - pClip->OnsetMs;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The MatchEdge() function looks for the unused edge of a type nearest to a nominal time.
+//
+// Parameter(s):
+//
+//	pEdges		edges of the clip
+//	pUsed		edges already matched, the one found is marked
+//	Type			PING_FLUX_EDGE_xxx
+//	NominalMs	time the edge should be at
+//	pErrorMs		receives the distance of the edge found
+//
+// Returns false if no edge is within BENCH_EDGE_TOLERANCE_MS
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool MatchEdge(const bench_edges_t *pEdges, bool *pUsed, uint8_t Type, uint32_t NominalMs, uint32_t *pErrorMs)
+{
+	uint32_t nIdx, nBest = UINT32_MAX;
+	uint32_t ErrorMs, BestMs = BENCH_EDGE_TOLERANCE_MS + 1;
+
+	for(nIdx=0; nIdx < pEdges->nEdges; nIdx++)
+	{
+		if(pUsed[nIdx] || (pEdges->pEdge[nIdx].Type != Type))
+		{
+			continue;
+		}
+
+		ErrorMs = (pEdges->pEdge[nIdx].TimeMs > NominalMs) ? pEdges->pEdge[nIdx].TimeMs - NominalMs : NominalMs - pEdges->pEdge[nIdx].TimeMs;
+
+		if(ErrorMs < BestMs)
+		{
+			BestMs = ErrorMs;
+			nBest = nIdx;
+		}
+	}
+
+	if(nBest == UINT32_MAX)
+	{
+		return false;
+	}
+
+	pUsed[nBest] = true;
+	*pErrorMs = BestMs;
+
+	return true;
+}
+
+#endif // PING_FLUX_ENABLED
+
+#if PING_SIREN_ENABLED
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The CollectSweeps() function is the ping_host_stream() handler of the siren run, it keeps
+// the sweeps.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void CollectSweeps(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+	bench_sweeps_t *pSweeps = pContext;
+
+	if(pResult->SirenEvent != PING_SIREN_EVT_SWEEP)
+	{
+		return;
+	}
+
+	pSweeps->pSweep = GrowArray(pSweeps->pSweep, pSweeps->nSweeps, &pSweeps->nAlloc, sizeof(ping_siren_sweep_t));
+	pSweeps->pSweep[pSweeps->nSweeps++] = pResult->Sweep;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The MatchSweep() function looks for the unused sweep of a class and direction whose
+// middle is nearest to that of a nominal one, and inside it.
+//
+// Parameter(s):
+//
+//	pSweeps		sweeps of the clip
+//	pUsed		sweeps already matched, the one found is marked
+//	Class		PING_SIREN_CLASS_xxx
+//	bRise		a rise rather than a fall
+//	StartMs		nominal start
+//	EndMs		nominal end
+//
+// Returns the sweep found, or NULL
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static const ping_siren_sweep_t *MatchSweep(const bench_sweeps_t *pSweeps, bool *pUsed, uint8_t Class, bool bRise, uint32_t StartMs, uint32_t EndMs)
+{
+	const ping_siren_sweep_t *pSweep;
+	uint32_t nIdx, nBest = UINT32_MAX;
+	uint32_t MiddleMs, ErrorMs, BestMs = UINT32_MAX;
+
+	for(nIdx=0; nIdx < pSweeps->nSweeps; nIdx++)
+	{
+		pSweep = &pSweeps->pSweep[nIdx];
+		MiddleMs = pSweep->StartMs + pSweep->DurationMs / 2;
+
+		if(pUsed[nIdx] || (pSweep->Class != Class) || ((pSweep->fRateHzS > 0.0f) != bRise) || (MiddleMs < StartMs) || (MiddleMs > EndMs))
+		{
+			continue;
+		}
+
+		ErrorMs = (2 * MiddleMs > StartMs + EndMs) ? 2 * MiddleMs - (StartMs + EndMs) : (StartMs + EndMs) - 2 * MiddleMs;
+
+		if(ErrorMs < BestMs)
+		{
+			BestMs = ErrorMs;
+			nBest = nIdx;
+		}
+	}
+
+	if(nBest == UINT32_MAX)
+	{
+		return NULL;
+	}
+
+	pUsed[nBest] = true;
+
+	return &pSweeps->pSweep[nBest];
+}
+
+#endif // PING_SIREN_ENABLED
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The Score() function runs the temporal decoders over the detector output of one clip.
+//
+// Parameter(s):
+//
+//	pClip			clip the frames came from
+//	pRun				its detector output
+//	fMinAmplitude		tone gate of the operating point
+//	pScore			receives the outcome
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void Score(const ping_corpus_clip_t *pClip, const bench_run_t *pRun, float fMinAmplitude, bench_score_t *pScore)
+{
+	ping_temporal_t Decoder[PING_CORPUS_NUM_LABELS];
+	const bench_frame_t *pFrame;
+	uint32_t nIdx;
+	uint8_t Label;
+	bool bTone;
+
+	memset(pScore, 0, sizeof(*pScore));
+
+	ping_temporal_init(&Decoder[PING_CORPUS_LABEL_T3], &PingT3Config);
+	ping_temporal_init(&Decoder[PING_CORPUS_LABEL_T4], &PingT4Config);
+
+	for(nIdx=0; nIdx < pRun->nFrames; nIdx++)
+	{
+		pFrame = &pRun->pFrame[nIdx];
+		bTone = ping_host_tone(&pFrame->Peak, fMinAmplitude);
+
+		for(Label = PING_CORPUS_LABEL_T3; Label <= PING_CORPUS_LABEL_T4; Label++)
+		{
+			if(ping_temporal_update(&Decoder[Label], bTone, pFrame->TimeMs) != PING_TEMPORAL_EVT_CONFIRMED)
+			{
+				continue;
+			}
+
+			if((pClip->Label == PING_CORPUS_LABEL_NONE) || (pFrame->TimeMs < pClip->OnsetMs))
+			{
+				pScore->nFalseAlarms++;
+			}
+			else if((Label == pClip->Label) && !pScore->bDetected)
+			{
+				pScore->bDetected = true;
+				pScore->TtdMs = pFrame->TimeMs - pClip->OnsetMs;
+			}
+		}
+	}
+
+	if(pClip->Label == PING_CORPUS_LABEL_NONE)
+	{
+		pScore->NegativeMs = (uint32_t) ((uint64_t) pClip->Wav.nSamples * 1000 / PING_SAMPLE_RATE_HZ);
+	}
+	else
+	{
+		pScore->NegativeMs = pClip->OnsetMs;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The BenchMode() function runs one detector over the corpus and writes its report object.
+//
+// Parameter(s):
+//
+//	pOut			report file
+//	pCorpus		clips
+//	nMode		one of the PING_DETECTOR_xxx modes
+//	nFftLength	analysis length
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void BenchMode(FILE *pOut, const ping_corpus_t *pCorpus, uint8_t nMode, uint32_t nFftLength)
+{
+	bench_run_t *pRun;
+	bench_ticks_t Ticks;
+	bench_collect_t Collector;
+	bench_score_t Score0;
+	bench_score_t ClipScore;
+	uint32_t *pTtd;
+	uint32_t nPoint, nClip, nPositives, nDetected, nFalseAlarms;
+	uint64_t NegativeMs, SumTicks;
+	uint32_t GatedStart, AnalysedStart;
+	double fHours;
+
+	pRun = calloc(pCorpus->nClips, sizeof(bench_run_t));
+	pTtd = malloc(MAX(1, pCorpus->nClips) * sizeof(uint32_t));
+	memset(&Ticks, 0, sizeof(Ticks));
+
+	if((pRun == NULL) || (pTtd == NULL))
+	{
+		NRF_LOG_RAW_INFO("out of memory\n");
+		exit(1);
+	}
+
+	GatedStart = PingGateGated;
+	AnalysedStart = PingGateAnalysed;
+
+	for(nClip=0; nClip < pCorpus->nClips; nClip++)
+	{
+		NRF_LOG_RAW_INFO("%s: %s\n", PingHostModeName[nMode], pCorpus->pClip[nClip].Name);
+
+		Collector.pRun = &pRun[nClip];
+		Collector.pTicks = &Ticks;
+
+		ping_host_open(nMode, nFftLength);
+		ping_host_stream(&pCorpus->pClip[nClip].Wav, Collect, &Collector);
+	}
+
+	fprintf(pOut, "    {\n      \"mode\": \"%s\",\n", PingHostModeName[nMode]);
+
+	// Time per frame
+	SumTicks = 0;
+
+	for(nClip=0; nClip < Ticks.nTicks; nClip++)
+	{
+		SumTicks += Ticks.pTicks[nClip];
+	}
+
+	if(Ticks.nTicks > 0)
+	{
+		qsort(Ticks.pTicks, Ticks.nTicks, sizeof(uint32_t), CompareU32);
+
+		fprintf(pOut, "      \"frames\": %lu,\n", (unsigned long) Ticks.nTicks);
+		fprintf(pOut, "      \"frame_us\": { \"mean\": %.3f, \"p50\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n",
+			(double) SumTicks / Ticks.nTicks / PING_PROFILE_TICKS_PER_US,
+			(double) Percentile(Ticks.pTicks, Ticks.nTicks, 50) / PING_PROFILE_TICKS_PER_US,
+			(double) Percentile(Ticks.pTicks, Ticks.nTicks, 99) / PING_PROFILE_TICKS_PER_US,
+			(double) Ticks.pTicks[Ticks.nTicks - 1] / PING_PROFILE_TICKS_PER_US);
+	}
+
+	fprintf(pOut, "      \"gated\": %lu,\n      \"analysed\": %lu,\n",
+		(unsigned long) (PingGateGated - GatedStart), (unsigned long) (PingGateAnalysed - AnalysedStart));
+
+	// Operating points
+	fprintf(pOut, "      \"roc\": [\n");
+
+	for(nPoint=0; nPoint < BENCH_NUM_POINTS; nPoint++)
+	{
+		nPositives = 0;
+		nDetected = 0;
+		nFalseAlarms = 0;
+		NegativeMs = 0;
+
+		for(nClip=0; nClip < pCorpus->nClips; nClip++)
+		{
+			Score(&pCorpus->pClip[nClip], &pRun[nClip], BenchMinAmplitude[nPoint], &ClipScore);
+
+			nFalseAlarms += ClipScore.nFalseAlarms;
+			NegativeMs += ClipScore.NegativeMs;
+
+			if(pCorpus->pClip[nClip].Label != PING_CORPUS_LABEL_NONE)
+			{
+				nPositives++;
+
+				if(ClipScore.bDetected)
+				{
+					pTtd[nDetected++] = ClipScore.TtdMs;
+				}
+			}
+		}
+
+		fHours = NegativeMs / 3600000.0;
+
+		fprintf(pOut, "        { \"min_amplitude\": %.0f, \"positives\": %lu, \"detected\": %lu, \"detection_rate\": %.4f, "
+			"\"false_alarms\": %lu, \"negative_hours\": %.4f, \"false_alarms_per_hour\": %.2f, ",
+			BenchMinAmplitude[nPoint], (unsigned long) nPositives, (unsigned long) nDetected,
+			(nPositives > 0) ? (double) nDetected / nPositives : 0.0,
+			(unsigned long) nFalseAlarms, fHours, (fHours > 0.0) ? nFalseAlarms / fHours : 0.0);
+
+		if(nDetected > 0)
+		{
+			qsort(pTtd, nDetected, sizeof(uint32_t), CompareU32);
+
+			fprintf(pOut, "\"ttd_ms\": { \"p50\": %lu, \"p90\": %lu, \"max\": %lu } }",
+				(unsigned long) Percentile(pTtd, nDetected, 50), (unsigned long) Percentile(pTtd, nDetected, 90),
+				(unsigned long) pTtd[nDetected - 1]);
+		}
+		else
+		{
+			fprintf(pOut, "\"ttd_ms\": null }");
+		}
+
+		fprintf(pOut, "%s\n", (nPoint + 1 < BENCH_NUM_POINTS) ? "," : "");
+	}
+
+	fprintf(pOut, "      ],\n");
+
+	// Every clip at the firmware operating point
+	fprintf(pOut, "      \"clips\": [\n");
+
+	for(nClip=0; nClip < pCorpus->nClips; nClip++)
+	{
+		Score(&pCorpus->pClip[nClip], &pRun[nClip], BenchMinAmplitude[0], &Score0);
+
+		fprintf(pOut, "        { \"name\": \"%s\", \"detected\": %s, ", pCorpus->pClip[nClip].Name, Score0.bDetected ? "true" : "false");
+
+		if(Score0.bDetected)
+		{
+			fprintf(pOut, "\"ttd_ms\": %lu, ", (unsigned long) Score0.TtdMs);
+		}
+		else
+		{
+			fprintf(pOut, "\"ttd_ms\": null, ");
+		}
+
+		fprintf(pOut, "\"false_alarms\": %lu }%s\n", (unsigned long) Score0.nFalseAlarms, (nClip + 1 < pCorpus->nClips) ? "," : "");
+	}
+
+	fprintf(pOut, "      ]\n    }");
+
+	for(nClip=0; nClip < pCorpus->nClips; nClip++)
+	{
+		free(pRun[nClip].pFrame);
+	}
+
+	free(Ticks.pTicks);
+	free(pTtd);
+	free(pRun);
+}
+
+#if PING_NN_ENABLED
+
+// ping_host_stream() handler for runs where only the profile counts
+static void Ignore(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The BenchFeatures() function writes the budgets of the feature stage and the classifier.
+//
+// Parameter(s):
+//
+//	pOut			report file
+//	pCorpus		clips
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void BenchFeatures(FILE *pOut, const ping_corpus_t *pCorpus)
+{
+	const ping_profile_scope_t *pFeatures = &PingProfile[PING_PROFILE_FEATURES];
+	const ping_profile_scope_t *pFft = &PingProfile[PING_PROFILE_FFT];
+	const ping_profile_scope_t *pNn = &PingProfile[PING_PROFILE_NN];
+	uint32_t nClip, Inferences, Begin, SelfTestTicks;
+	size_t FlashBytes, RamBytes;
+
+	Begin = ping_profile_now();
+	ping_nn_selftest();
+	SelfTestTicks = ping_profile_now() - Begin;
+
+	ping_profile_reset();
+	Inferences = PingNnInferences;
+
+	for(nClip=0; nClip < pCorpus->nClips; nClip++)
+	{
+		NRF_LOG_RAW_INFO("features: %s\n", pCorpus->pClip[nClip].Name);
+
+		ping_host_open(PING_DETECTOR_FFT, PING_MEL_FFT_SIZE);
+		ping_host_stream(&pCorpus->pClip[nClip].Wav, Ignore, NULL);
+	}
+
+	FlashBytes = sizeof(PingMelFirstBin) + sizeof(PingMelBinCount) + sizeof(PingMelWeight) + sizeof(PingMfccDct);
+	RamBytes = sizeof(PingLogMel) + sizeof(PingMfcc) + sizeof(PingMfccHead) + sizeof(PingMfccFrames);
+
+	fprintf(pOut, "  \"features\": {\n");
+	fprintf(pOut, "    \"fft_length\": %d,\n    \"hop_ms\": %.3f,\n    \"mel_bands\": %d,\n    \"mfcc_coeffs\": %d,\n    \"history\": %d,\n",
+		PING_MEL_FFT_SIZE, PING_MEL_FFT_SIZE * 1000.0 / PING_SAMPLE_RATE_HZ, PING_MEL_BANDS, PING_MFCC_COEFFS, PING_MFCC_HISTORY);
+	fprintf(pOut, "    \"flash_bytes\": %lu,\n    \"ram_bytes\": %lu,\n",
+		(unsigned long) FlashBytes, (unsigned long) RamBytes);
+	fprintf(pOut, "    \"macs_per_frame\": %d,\n    \"logs_per_frame\": %d,\n",
+		PING_MEL_WEIGHTS + PING_MEL_BANDS * PING_MFCC_COEFFS, PING_MEL_BANDS);
+	fprintf(pOut, "    \"frames\": %lu,\n", (unsigned long) pFeatures->Count);
+
+	if((pFeatures->Count > 0) && (pFft->Count > 0))
+	{
+		fprintf(pOut, "    \"frame_us\": { \"mean\": %.3f, \"max\": %.3f },\n    \"fft_us\": { \"mean\": %.3f }\n",
+			(double) pFeatures->Sum / pFeatures->Count / PING_PROFILE_TICKS_PER_US,
+			(double) pFeatures->Max / PING_PROFILE_TICKS_PER_US,
+			(double) pFft->Sum / pFft->Count / PING_PROFILE_TICKS_PER_US);
+	}
+	else
+	{
+		fprintf(pOut, "    \"frame_us\": null,\n    \"fft_us\": null\n");
+	}
+
+	fprintf(pOut, "  },\n");
+
+	FlashBytes = sizeof(PingNnConv1Weight) + sizeof(PingNnConv1Bias) + sizeof(PingNnDwWeight) + sizeof(PingNnDwBias) +
+		sizeof(PingNnPwWeight) + sizeof(PingNnPwBias) + sizeof(PingNnFcWeight) + sizeof(PingNnFcBias) + sizeof(PingNnShift);
+
+	fprintf(pOut, "  \"classifier\": {\n");
+	fprintf(pOut, "    \"classes\": %d,\n    \"hop_ms\": %.3f,\n",
+		PING_NN_CLASSES, PING_NN_HOP_ROWS * PING_MEL_FFT_SIZE * 1000.0 / PING_SAMPLE_RATE_HZ);
+	fprintf(pOut, "    \"flash_bytes\": %lu,\n    \"ram_bytes\": %d,\n    \"macs_per_inference\": %d,\n",
+		(unsigned long) FlashBytes, PING_NN_RAM_BYTES, PING_NN_MACS);
+	fprintf(pOut, "    \"selftest_hash\": \"0x%08lx\",\n    \"selftest_us\": %.3f,\n",
+		(unsigned long) PingNnSelfTest, (double) SelfTestTicks / PING_PROFILE_TICKS_PER_US);
+	fprintf(pOut, "    \"inferences\": %lu,\n", (unsigned long) (PingNnInferences - Inferences));
+
+	if(pNn->Count > 0)
+	{
+		fprintf(pOut, "    \"inference_us\": { \"mean\": %.3f, \"max\": %.3f }\n",
+			(double) pNn->Sum / pNn->Count / PING_PROFILE_TICKS_PER_US,
+			(double) pNn->Max / PING_PROFILE_TICKS_PER_US);
+	}
+	else
+	{
+		fprintf(pOut, "    \"inference_us\": null\n");
+	}
+
+	fprintf(pOut, "  },\n");
+}
+
+#endif // PING_NN_ENABLED
+
+#if PING_FLUX_ENABLED
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The BenchEdges() function runs the pulse edge detector over the corpus and writes its
+// report object.  The edges do not depend on the detector mode, the Goertzel bank runs
+// along as the cheapest.
+//
+// Parameter(s):
+//
+//	pOut			report file
+//	pCorpus		clips
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void BenchEdges(FILE *pOut, const ping_corpus_t *pCorpus)
+{
+	const ping_profile_scope_t *pFlux = &PingProfile[PING_PROFILE_FLUX];
+	const ping_temporal_config_t *pConfig;
+	const ping_corpus_clip_t *pClip;
+	bench_edges_t Edges;
+	bool *pUsed;
+	uint32_t *pError[2];
+	uint32_t nError[2], nAlloc[2];
+	uint32_t nClip, nPulse, nExpected, nMatched, nSpurious, nDetected, nPositives, nFalseAlarms;
+	uint32_t PulseMs, EndMs, ErrorMs;
+	uint64_t NegativeMs;
+	uint8_t Type;
+
+	memset(pError, 0, sizeof(pError));
+	memset(nError, 0, sizeof(nError));
+	memset(nAlloc, 0, sizeof(nAlloc));
+	nDetected = 0;
+	nPositives = 0;
+	nFalseAlarms = 0;
+	NegativeMs = 0;
+
+	ping_profile_reset();
+
+	fprintf(pOut, "  \"edges\": {\n");
+	fprintf(pOut, "    \"hop_ms\": %.3f,\n    \"onset_db\": %.1f,\n    \"tolerance_ms\": %d,\n",
+		PING_FLUX_HOP_MS, PING_FLUX_ONSET_DB, BENCH_EDGE_TOLERANCE_MS);
+	fprintf(pOut, "    \"clips\": [\n");
+
+	for(nClip=0; nClip < pCorpus->nClips; nClip++)
+	{
+		pClip = &pCorpus->pClip[nClip];
+
+		NRF_LOG_RAW_INFO("edges: %s\n", pClip->Name);
+
+		memset(&Edges, 0, sizeof(Edges));
+		Edges.pClip = pClip;
+		ping_temporal_init(&Edges.Decoder[PING_CORPUS_LABEL_T3], &PingT3Config);
+		ping_temporal_init(&Edges.Decoder[PING_CORPUS_LABEL_T4], &PingT4Config);
+
+		ping_host_open(PING_DETECTOR_GOERTZEL, PING_FFT_DEFAULT_SIZE);
+		ping_host_stream(&pClip->Wav, CollectEdges, &Edges);
+
+		pUsed = calloc(MAX(1, Edges.nEdges), sizeof(bool));
+
+		if(pUsed == NULL)
+		{
+			NRF_LOG_RAW_INFO("out of memory\n");
+			exit(1);
+		}
+
+		// Nominal pulses from the onset to the end of the clip, as the corpus lays them out
+		nExpected = 0;
+		nMatched = 0;
+		EndMs = (uint32_t) ((uint64_t) pClip->Wav.nSamples * 1000 / PING_SAMPLE_RATE_HZ);
+		pConfig = (pClip->Label == PING_CORPUS_LABEL_T3) ? &PingT3Config : &PingT4Config;
+		PulseMs = pClip->OnsetMs;
+
+		while((pClip->Label != PING_CORPUS_LABEL_NONE) && (PulseMs + pConfig->PulseMs + BENCH_EDGE_TOLERANCE_MS < EndMs))
+		{
+			for(nPulse=0; (nPulse < pConfig->PulsesPerGroup) && (PulseMs + pConfig->PulseMs + BENCH_EDGE_TOLERANCE_MS < EndMs); nPulse++)
+			{
+				for(Type = PING_FLUX_EDGE_ONSET; Type <= PING_FLUX_EDGE_OFFSET; Type++)
+				{
+					nExpected++;
+
+					if(MatchEdge(&Edges, pUsed, Type, PulseMs + ((Type == PING_FLUX_EDGE_OFFSET) ? pConfig->PulseMs : 0), &ErrorMs))
+					{
+						nMatched++;
+						pError[Type - 1] = GrowArray(pError[Type - 1], nError[Type - 1], &nAlloc[Type - 1], sizeof(uint32_t));
+						pError[Type - 1][nError[Type - 1]++] = ErrorMs;
+					}
+				}
+
+				PulseMs += pConfig->PulseMs + ((nPulse + 1 < pConfig->PulsesPerGroup) ? pConfig->GapMs : pConfig->PauseMs);
+			}
+		}
+
+		nSpurious = Edges.nEdges - nMatched;
+
+		if(pClip->Label == PING_CORPUS_LABEL_NONE)
+		{
+			NegativeMs += EndMs;
+		}
+		else
+		{
+			NegativeMs += pClip->OnsetMs;
+			nPositives++;
+			nDetected += Edges.Score.bDetected ? 1 : 0;
+		}
+
+		nFalseAlarms += Edges.Score.nFalseAlarms;
+
+		fprintf(pOut, "      { \"name\": \"%s\", \"expected\": %lu, \"matched\": %lu, \"spurious\": %lu, \"decoded\": %s, \"false_alarms\": %lu }%s\n",
+			pClip->Name, (unsigned long) nExpected, (unsigned long) nMatched, (unsigned long) nSpurious,
+			(pClip->Label == PING_CORPUS_LABEL_NONE) ? "null" : Edges.Score.bDetected ? "true" : "false",
+			(unsigned long) Edges.Score.nFalseAlarms, (nClip + 1 < pCorpus->nClips) ? "," : "");
+
+		free(pUsed);
+		free(Edges.pEdge);
+	}
+
+	fprintf(pOut, "    ],\n");
+
+	for(Type = PING_FLUX_EDGE_ONSET; Type <= PING_FLUX_EDGE_OFFSET; Type++)
+	{
+		fprintf(pOut, "    \"%s_error_ms\": ", (Type == PING_FLUX_EDGE_ONSET) ? "onset" : "offset");
+
+		if(nError[Type - 1] > 0)
+		{
+			qsort(pError[Type - 1], nError[Type - 1], sizeof(uint32_t), CompareU32);
+
+			fprintf(pOut, "{ \"edges\": %lu, \"p50\": %lu, \"p90\": %lu, \"max\": %lu },\n",
+				(unsigned long) nError[Type - 1], (unsigned long) Percentile(pError[Type - 1], nError[Type - 1], 50),
+				(unsigned long) Percentile(pError[Type - 1], nError[Type - 1], 90),
+				(unsigned long) pError[Type - 1][nError[Type - 1] - 1]);
+		}
+		else
+		{
+			fprintf(pOut, "null,\n");
+		}
+
+		free(pError[Type - 1]);
+	}
+
+	fprintf(pOut, "    \"decoded\": { \"positives\": %lu, \"detected\": %lu, \"false_alarms\": %lu, \"negative_hours\": %.4f },\n",
+		(unsigned long) nPositives, (unsigned long) nDetected, (unsigned long) nFalseAlarms, NegativeMs / 3600000.0);
+
+	if(pFlux->Count > 0)
+	{
+		fprintf(pOut, "    \"frame_us\": { \"mean\": %.3f, \"max\": %.3f }\n",
+			(double) pFlux->Sum / pFlux->Count / PING_PROFILE_TICKS_PER_US,
+			(double) pFlux->Max / PING_PROFILE_TICKS_PER_US);
+	}
+	else
+	{
+		fprintf(pOut, "    \"frame_us\": null\n");
+	}
+
+	fprintf(pOut, "  },\n");
+}
+
+#endif // PING_FLUX_ENABLED
+
+#if PING_SIREN_ENABLED
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The BenchSirens() function writes the sirens object, see the top of the file.  The
+// tracker runs on every frame whatever the mode, the Goertzel detector is selected only to
+// stream the clips.
+//
+// Parameter(s):
+//
+//	pOut			report file
+//	pCorpus		clips without a siren
+//	pSirens		siren set, may be empty
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void BenchSirens(FILE *pOut, const ping_corpus_t *pCorpus, const ping_corpus_t *pSirens)
+{
+	const ping_profile_scope_t *pSiren = &PingProfile[PING_PROFILE_SIREN];
+	const ping_corpus_clip_t *pClip;
+	const ping_siren_sweep_t *pSweep;
+	bench_sweeps_t Sweeps;
+	bool *pUsed;
+	uint32_t *pError = NULL;
+	uint32_t nError = 0, nAlloc = 0;
+	uint32_t nClip, nIdx, nExpected, nMatched, nUnexpected, nShapes, nTotalMatched, nTotalShapes, nFalse;
+	uint32_t SweepMs, LengthMs, EndMs;
+	float fNominal;
+	bool bRise;
+	uint8_t Class;
+
+	nTotalMatched = 0;
+	nTotalShapes = 0;
+
+	ping_profile_reset();
+
+	fprintf(pOut, "  \"sirens\": {\n");
+	fprintf(pOut, "    \"hop_ms\": %.3f,\n    \"band_hz\": [ %.1f, %.1f ],\n    \"ranges_hz_s\": {",
+		PING_SIREN_HOP_MS, PING_SIREN_FREQ_LO_HZ, PING_SIREN_FREQ_HI_HZ);
+
+	for(Class=0; Class < PING_SIREN_NUM_CLASSES; Class++)
+	{
+		fprintf(pOut, " \"%s\": [ %.0f, %.0f ]%s", PingSirenClassName[Class], PingSirenRange[Class].fMinHzS,
+			PingSirenRange[Class].fMaxHzS, (Class + 1 < PING_SIREN_NUM_CLASSES) ? "," : " },\n");
+	}
+
+	fprintf(pOut, "    \"clips\": [\n");
+
+	for(nClip=0; nClip < pSirens->nClips; nClip++)
+	{
+		pClip = &pSirens->pClip[nClip];
+
+		NRF_LOG_RAW_INFO("sirens: %s\n", pClip->Name);
+
+		memset(&Sweeps, 0, sizeof(Sweeps));
+		ping_host_open(PING_DETECTOR_GOERTZEL, PING_FFT_DEFAULT_SIZE);
+		ping_host_stream(&pClip->Wav, CollectSweeps, &Sweeps);
+
+		pUsed = calloc(MAX(1, Sweeps.nSweeps), sizeof(bool));
+
+		if(pUsed == NULL)
+		{
+			NRF_LOG_RAW_INFO("out of memory\n");
+			exit(1);
+		}
+
+		// Nominal rises and falls from the onset, as the corpus lays them out
+		nExpected = 0;
+		nMatched = 0;
+		nShapes = 0;
+		EndMs = (uint32_t) ((uint64_t) pClip->Wav.nSamples * 1000 / PING_SAMPLE_RATE_HZ);
+		SweepMs = pClip->OnsetMs;
+		bRise = true;
+
+		nUnexpected = 0;
+
+		while(SweepMs + (LengthMs = bRise ? pClip->pSiren->RiseMs : pClip->pSiren->FallMs) <= EndMs)
+		{
+			pSweep = MatchSweep(&Sweeps, pUsed, pClip->pSiren->Class, bRise, SweepMs, SweepMs + LengthMs);
+
+			if(SweepMs + LengthMs + BENCH_SWEEP_MARGIN_MS > EndMs)
+			{
+				// Too close to the end to be expected, but no spurious sweep if found
+				nUnexpected += (pSweep != NULL) ? 1 : 0;
+			}
+			else if(pSweep != NULL)
+			{
+				nMatched++;
+				nShapes += (pSweep->Shape == pClip->pSiren->Shape) ? 1 : 0;
+
+				fNominal = (pClip->pSiren->fHiHz - pClip->pSiren->fLoHz) * 1000.0f / LengthMs;
+				pError = GrowArray(pError, nError, &nAlloc, sizeof(uint32_t));
+				pError[nError++] = (uint32_t) (fabsf(fabsf(pSweep->fRateHzS) - fNominal) * 100.0f / fNominal + 0.5f);
+			}
+
+			nExpected += (SweepMs + LengthMs + BENCH_SWEEP_MARGIN_MS <= EndMs) ? 1 : 0;
+			SweepMs += LengthMs;
+			bRise = !bRise;
+		}
+
+		nTotalMatched += nMatched;
+		nTotalShapes += nShapes;
+
+		fprintf(pOut, "      { \"name\": \"%s\", \"expected\": %lu, \"matched\": %lu, \"spurious\": %lu, \"shape_correct\": %lu }%s\n",
+			pClip->Name, (unsigned long) nExpected, (unsigned long) nMatched, (unsigned long) (Sweeps.nSweeps - nMatched - nUnexpected),
+			(unsigned long) nShapes, (nClip + 1 < pSirens->nClips) ? "," : "");
+
+		free(pUsed);
+		free(Sweeps.pSweep);
+	}
+
+	fprintf(pOut, "    ],\n    \"false_sweeps\": [\n");
+
+	for(nClip=0; nClip < pCorpus->nClips; nClip++)
+	{
+		pClip = &pCorpus->pClip[nClip];
+
+		NRF_LOG_RAW_INFO("sirens: %s\n", pClip->Name);
+
+		memset(&Sweeps, 0, sizeof(Sweeps));
+		ping_host_open(PING_DETECTOR_GOERTZEL, PING_FFT_DEFAULT_SIZE);
+		ping_host_stream(&pClip->Wav, CollectSweeps, &Sweeps);
+
+		fprintf(pOut, "      { \"name\": \"%s\"", pClip->Name);
+
+		for(Class=0; Class < PING_SIREN_NUM_CLASSES; Class++)
+		{
+			nFalse = 0;
+
+			for(nIdx=0; nIdx < Sweeps.nSweeps; nIdx++)
+			{
+				nFalse += (Sweeps.pSweep[nIdx].Class == Class) ? 1 : 0;
+			}
+
+			fprintf(pOut, ", \"%s\": %lu", PingSirenClassName[Class], (unsigned long) nFalse);
+		}
+
+		fprintf(pOut, " }%s\n", (nClip + 1 < pCorpus->nClips) ? "," : "");
+
+		free(Sweeps.pSweep);
+	}
+
+	fprintf(pOut, "    ],\n");
+	fprintf(pOut, "    \"matched\": %lu,\n    \"shape_correct\": %lu,\n", (unsigned long) nTotalMatched, (unsigned long) nTotalShapes);
+
+	if(nError > 0)
+	{
+		qsort(pError, nError, sizeof(uint32_t), CompareU32);
+
+		fprintf(pOut, "    \"rate_error_pct\": { \"sweeps\": %lu, \"p50\": %lu, \"p90\": %lu, \"max\": %lu },\n",
+			(unsigned long) nError, (unsigned long) Percentile(pError, nError, 50),
+			(unsigned long) Percentile(pError, nError, 90), (unsigned long) pError[nError - 1]);
+	}
+	else
+	{
+		fprintf(pOut, "    \"rate_error_pct\": null,\n");
+	}
+
+	free(pError);
+
+	if(pSiren->Count > 0)
+	{
+		fprintf(pOut, "    \"frame_us\": { \"mean\": %.3f, \"max\": %.3f }\n",
+			(double) pSiren->Sum / pSiren->Count / PING_PROFILE_TICKS_PER_US,
+			(double) pSiren->Max / PING_PROFILE_TICKS_PER_US);
+	}
+	else
+	{
+		fprintf(pOut, "    \"frame_us\": null\n");
+	}
+
+	fprintf(pOut, "  }\n");
+}
+
+#endif // PING_SIREN_ENABLED
+
+int main(int argc, char *argv[])
+{
+	ping_corpus_t Corpus, Sirens;
+	const ping_corpus_clip_t *pClip;
+	const char *pManifest = NULL;
+	const char *pReport = NULL;
+	FILE *pOut = stdout;
+	uint32_t nFftLength = PING_FFT_DEFAULT_SIZE;
+	uint32_t nIdx;
+	uint8_t nMode, nFirstMode = 0, nLastMode = PING_DETECTOR_NUM_MODES - 1;
+	bool bSynthetic = true;
+	int nOption;
+
+	while((nOption = getopt(argc, argv, "m:n:c:so:")) != -1)
+	{
+		switch(nOption)
+		{
+			case 'm':
+				if(!ping_host_mode_parse(optarg, &nFirstMode))
+				{
+					NRF_LOG_RAW_INFO("unknown mode %s\n", optarg);
+					return 2;
+				}
+				nLastMode = nFirstMode;
+				break;
+
+			case 'n':
+				nFftLength = (uint32_t) strtoul(optarg, NULL, 0);
+				break;
+
+			case 'c':
+				pManifest = optarg;
+				break;
+
+			case 's':
+				bSynthetic = false;
+				break;
+
+			case 'o':
+				pReport = optarg;
+				break;
+
+			default:
+				NRF_LOG_RAW_INFO("usage: %s [-m mode] [-n fft_length] [-c manifest] [-s] [-o report.json]\n", argv[0]);
+				return 2;
+		}
+	}
+
+	if(!ping_host_open(nFirstMode, nFftLength))
+	{
+		NRF_LOG_RAW_INFO("fft length %lu not supported, %d..%d and a power of two\n", (unsigned long) nFftLength, PING_FFT_MIN_SIZE, PING_FFT_MAX_SIZE);
+		return 2;
+	}
+
+	memset(&Corpus, 0, sizeof(Corpus));
+
+	memset(&Sirens, 0, sizeof(Sirens));
+
+	if((bSynthetic && !ping_corpus_synthesize(&Corpus)) || ((pManifest != NULL) && !ping_corpus_load(&Corpus, pManifest)) ||
+		(bSynthetic && !ping_corpus_sirens(&Sirens)))
+	{
+		ping_corpus_free(&Sirens);
+		ping_corpus_free(&Corpus);
+		return 1;
+	}
+
+	if(Corpus.nClips == 0)
+	{
+		NRF_LOG_RAW_INFO("empty corpus\n");
+		return 2;
+	}
+
+	if(pReport != NULL)
+	{
+		pOut = fopen(pReport, "w");
+
+		if(pOut == NULL)
+		{
+			NRF_LOG_RAW_INFO("%s: cannot create\n", pReport);
+			ping_corpus_free(&Sirens);
+			ping_corpus_free(&Corpus);
+			return 1;
+		}
+	}
+
+	ping_profile_init();
+
+	fprintf(pOut, "{\n");
+	fprintf(pOut, "  \"sample_rate_hz\": %d,\n  \"frame_samples\": %d,\n  \"fft_length\": %lu,\n",
+		PING_SAMPLE_RATE_HZ, AUDIO_FRAME_NUM_SAMPLES, (unsigned long) nFftLength);
+	fprintf(pOut, "  \"alarm_band_hz\": [ %.1f, %.1f ],\n", PING_ALARM_FREQ_LO_HZ, PING_ALARM_FREQ_HI_HZ);
+
+	fprintf(pOut, "  \"corpus\": [\n");
+
+	for(nIdx=0; nIdx < Corpus.nClips; nIdx++)
+	{
+		pClip = &Corpus.pClip[nIdx];
+
+		fprintf(pOut, "    { \"name\": \"%s\", \"label\": \"%s\", \"seconds\": %.3f, \"onset_s\": %.3f }%s\n",
+			pClip->Name, PingCorpusLabelName[pClip->Label], (double) pClip->Wav.nSamples / PING_SAMPLE_RATE_HZ,
+			pClip->OnsetMs / 1000.0, (nIdx + 1 < Corpus.nClips) ? "," : "");
+	}
+
+	fprintf(pOut, "  ],\n  \"modes\": [\n");
+
+	for(nMode = nFirstMode; nMode <= nLastMode; nMode++)
+	{
+		BenchMode(pOut, &Corpus, nMode, nFftLength);
+		fprintf(pOut, "%s\n", (nMode < nLastMode) ? "," : "");
+	}
+
+	fprintf(pOut, "  ],\n");
+
+#if PING_NN_ENABLED
+	if((nFirstMode <= PING_DETECTOR_FFT) && (nLastMode >= PING_DETECTOR_FFT))
+	{
+		BenchFeatures(pOut, &Corpus);
+	}
+	else
+#endif
+	{
+		fprintf(pOut, "  \"features\": null,\n  \"classifier\": null,\n");
+	}
+
+#if PING_FLUX_ENABLED
+	BenchEdges(pOut, &Corpus);
+#else
+	fprintf(pOut, "  \"edges\": null,\n");
+#endif
+#if PING_SIREN_ENABLED
+	BenchSirens(pOut, &Corpus, &Sirens);
+#else
+	fprintf(pOut, "  \"sirens\": null\n");
+#endif
+
+	fprintf(pOut, "}\n");
+
+	if(pOut != stdout)
+	{
+		fclose(pOut);
+	}
+
+	ping_corpus_free(&Sirens);
+	ping_corpus_free(&Corpus);
+
+	return 0;
+}
@@ -0,0 +1,810 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_corpus.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Labeled audio corpus for the detector benchmark
+//
+//	ping_corpus_synthesize() builds the standard set, the same samples on every run:
+//
+//	t3_snr<n>, t4_snr<n>	T-3 and T-4 alarms at the centre of the alarm band in white noise,
+//						at PING_CORPUS_SNR_DB[] full band SNRs, starting after
+//						PING_CORPUS_ONSET_MS of noise alone
+//	piezo_snr<n>			T-3 alarms from a piezo sounder whose second harmonic is
+//						PING_CORPUS_PIEZO_SECOND times the fundamental, at
+//						PING_CORPUS_PIEZO_SNR_DB[] SNRs of the fundamental
+//	speech				voiced syllables through random formants, with fricatives
+//	music				notes and chords with up to 16 harmonics, some of which land in
+//						the alarm band
+//	hvac					rumble, mains hum and fan noise
+//	kitchen				clatter (decaying resonances anywhere up to 9 kHz) and appliance
+//						beeps
+//	quiet				an empty room, microphone and codec noise only
+//
+//	The negative clips are stand-ins, not recordings; ping_corpus_load() adds real ones.
+//
+//	ping_corpus_sirens() builds the siren set for the sweep tracker, every siren of
+//	PingCorpusSiren[] at PING_CORPUS_SIREN_SNR_DB[] in white noise from PING_CORPUS_ONSET_MS,
+//	named <siren>_snr<n>.  A siren is a band-limited square wave, the fundamental with its
+//	third and fifth harmonics, the SNR being that of the fundamental as for the alarms.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "nordic_common.h"
+#include "nrf_log.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_temporal.h"
+#include "ping_siren.h"
+
+#include "ping_wav.h"
+#include "ping_corpus.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PING_CORPUS_FS					((float) PING_SAMPLE_RATE_HZ)
+
+#define PING_CORPUS_ONSET_MS				2000
+#define PING_CORPUS_ALARM_SECONDS		16
+#define PING_CORPUS_NOISE_SECONDS		60
+#define PING_CORPUS_ALARM_HZ				((PING_ALARM_FREQ_LO_HZ + PING_ALARM_FREQ_HI_HZ) / 2)
+#define PING_CORPUS_NOISE_RMS			500.0f		// background of the alarm clips, LSB
+#define PING_CORPUS_CLUTTER_RMS			2000.0f		// level of the negative clips, LSB
+#define PING_CORPUS_QUIET_RMS			8.0f			// self noise of the quiet clip, LSB
+#define PING_CORPUS_RAMP_MS				5			// rise and fall of an alarm pulse
+#define PING_CORPUS_SIREN_SECONDS		12
+#define PING_CORPUS_PIEZO_SECOND			2.0f			// second harmonic over the fundamental, +6 dB
+
+static const int8_t PING_CORPUS_SNR_DB[] = { 20, 10, 0, -10, -20, -25 };
+static const int8_t PING_CORPUS_SIREN_SNR_DB[] = { 20, 10, 0, -10 };
+static const int8_t PING_CORPUS_PIEZO_SNR_DB[] = { 10, 0, -10 };
+
+const char * const PingCorpusLabelName[PING_CORPUS_NUM_LABELS] =
+{
+	"none",
+	"t3",
+	"t4",
+};
+
+// Electronic sirens as fitted to emergency vehicles, over the usual 650 Hz to 1.5 kHz
+const ping_corpus_siren_t PingCorpusSiren[PING_CORPUS_NUM_SIRENS] =
+{
+	{ "wail_linear", PING_SIREN_CLASS_WAIL, PING_SIREN_SHAPE_LINEAR, 650.0f, 1500.0f, 2000, 2000 },
+	{ "wail_exponential", PING_SIREN_CLASS_WAIL, PING_SIREN_SHAPE_EXPONENTIAL, 650.0f, 1500.0f, 2000, 2000 },
+	{ "yelp_linear", PING_SIREN_CLASS_YELP, PING_SIREN_SHAPE_LINEAR, 650.0f, 1500.0f, 150, 150 },
+	{ "yelp_exponential", PING_SIREN_CLASS_YELP, PING_SIREN_SHAPE_EXPONENTIAL, 650.0f, 1500.0f, 150, 150 },
+};
+
+static uint32_t RandomState = 1;
+
+// Two pole resonator.  The input is scaled by 1 - r only, ScaleToRms() sets the final level.
+typedef struct
+{
+	float fA1, fA2, fGain;
+	float fY1, fY2;
+} ping_resonator_t;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Random numbers, xorshift32, so every run of the benchmark sees the same corpus.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void RandomSeed(uint32_t nSeed)
+{
+	RandomState = (nSeed != 0) ? nSeed : 1;
+}
+
+static uint32_t RandomNext(void)
+{
+	RandomState ^= RandomState << 13;
+	RandomState ^= RandomState >> 17;
+	RandomState ^= RandomState << 5;
+
+	return RandomState;
+}
+
+// Uniform in [fLo, fHi)
+static float RandomUniform(float fLo, float fHi)
+{
+	return fLo + (fHi - fLo) * (float) (RandomNext() >> 8) / 16777216.0f;
+}
+
+// Standard normal, Box-Muller
+static float RandomGauss(void)
+{
+	float fU1 = RandomUniform(1.0e-7f, 1.0f);
+	float fU2 = RandomUniform(0.0f, 1.0f);
+
+	return sqrtf(-2.0f * logf(fU1)) * cosf(2.0f * (float) M_PI * fU2);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ResonatorInit() and ResonatorRun() functions implement ping_resonator_t.
+//
+// Parameter(s):
+//
+//	fFrequency	centre frequency in Hz
+//	fBandwidth	-3 dB bandwidth in Hz
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ResonatorInit(ping_resonator_t *pRes, float fFrequency, float fBandwidth)
+{
+	float fR = expf(-(float) M_PI * fBandwidth / PING_CORPUS_FS);
+
+	pRes->fA1 = 2.0f * fR * cosf(2.0f * (float) M_PI * fFrequency / PING_CORPUS_FS);
+	pRes->fA2 = -fR * fR;
+	pRes->fGain = 1.0f - fR;
+	pRes->fY1 = 0.0f;
+	pRes->fY2 = 0.0f;
+}
+
+static float ResonatorRun(ping_resonator_t *pRes, float fX)
+{
+	float fY = pRes->fGain * fX + pRes->fA1 * pRes->fY1 + pRes->fA2 * pRes->fY2;
+
+	pRes->fY2 = pRes->fY1;
+	pRes->fY1 = fY;
+
+	return fY;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ScaleToRms() function scales a mix to the given RMS level.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ScaleToRms(float *pMix, uint32_t nSamples, float fRms)
+{
+	double fSum = 0.0;
+	float fScale;
+	uint32_t nIdx;
+
+	for(nIdx=0; nIdx < nSamples; nIdx++)
+	{
+		fSum += (double) pMix[nIdx] * pMix[nIdx];
+	}
+
+	if(fSum <= 0.0)
+	{
+		return;
+	}
+
+	fScale = fRms / (float) sqrt(fSum / nSamples);
+
+	for(nIdx=0; nIdx < nSamples; nIdx++)
+	{
+		pMix[nIdx] *= fScale;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The AddWhite() function adds white Gaussian noise.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void AddWhite(float *pMix, uint32_t nSamples, float fRms)
+{
+	uint32_t nIdx;
+
+	for(nIdx=0; nIdx < nSamples; nIdx++)
+	{
+		pMix[nIdx] += fRms * RandomGauss();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The AddTone() function adds a sine burst with raised cosine ramps.
+//
+// Parameter(s):
+//
+//	nStart		first sample
+//	nLength		length in samples, cut at nSamples
+//	fFrequency	Hz
+//	fAmplitude	peak amplitude, LSB
+//	nRamp		length of each ramp in samples
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void AddTone(float *pMix, uint32_t nSamples, uint32_t nStart, uint32_t nLength, float fFrequency, float fAmplitude, uint32_t nRamp)
+{
+	float fGain;
+	uint32_t nIdx;
+
+	for(nIdx=0; (nIdx < nLength) && (nStart + nIdx < nSamples); nIdx++)
+	{
+		fGain = 1.0f;
+
+		if(nIdx < nRamp)
+		{
+			fGain = 0.5f - 0.5f * cosf((float) M_PI * nIdx / nRamp);
+		}
+		else if(nLength - nIdx <= nRamp)
+		{
+			fGain = 0.5f - 0.5f * cosf((float) M_PI * (nLength - nIdx) / nRamp);
+		}
+
+		// Phase in double, the sample index gets too large for a float argument
+		pMix[nStart + nIdx] += fGain * fAmplitude * (float) sin(2.0 * M_PI * fFrequency * (nStart + nIdx) / PING_SAMPLE_RATE_HZ);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The AddAlarm() function adds a temporal pattern at its nominal timing, from OnsetMs to the
+// end of the clip, with the second harmonic at fSecond times the fundamental (0 for none).
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void AddAlarm(float *pMix, uint32_t nSamples, uint32_t OnsetMs, const ping_temporal_config_t *pConfig, float fAmplitude, float fSecond)
+{
+	uint32_t TimeMs = OnsetMs;
+	uint32_t nPulse;
+	uint32_t nRamp = PING_CORPUS_RAMP_MS * PING_SAMPLE_RATE_HZ / 1000;
+
+	while((uint64_t) TimeMs * PING_SAMPLE_RATE_HZ / 1000 < nSamples)
+	{
+		for(nPulse=0; nPulse < pConfig->PulsesPerGroup; nPulse++)
+		{
+			AddTone(pMix, nSamples, (uint32_t) ((uint64_t) TimeMs * PING_SAMPLE_RATE_HZ / 1000),
+				pConfig->PulseMs * PING_SAMPLE_RATE_HZ / 1000, PING_CORPUS_ALARM_HZ, fAmplitude, nRamp);
+
+			if(fSecond > 0.0f)
+			{
+				AddTone(pMix, nSamples, (uint32_t) ((uint64_t) TimeMs * PING_SAMPLE_RATE_HZ / 1000),
+					pConfig->PulseMs * PING_SAMPLE_RATE_HZ / 1000, 2.0f * PING_CORPUS_ALARM_HZ, fSecond * fAmplitude, nRamp);
+			}
+
+			TimeMs += pConfig->PulseMs + ((nPulse + 1 < pConfig->PulsesPerGroup) ? pConfig->GapMs : pConfig->PauseMs);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The AddSiren() function adds a siren from OnsetMs to the end of the clip, starting at
+// the bottom of its rise.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void AddSiren(float *pMix, uint32_t nSamples, uint32_t OnsetMs, const ping_corpus_siren_t *pSiren, float fAmplitude)
+{
+	uint32_t nStart = (uint32_t) ((uint64_t) OnsetMs * PING_SAMPLE_RATE_HZ / 1000);
+	uint32_t nRamp = PING_CORPUS_RAMP_MS * PING_SAMPLE_RATE_HZ / 1000;
+	uint32_t nIdx;
+	double fCycle, fPhase = 0.0;
+	float fRise, fFrequency, fGain;
+
+	for(nIdx=nStart; nIdx < nSamples; nIdx++)
+	{
+		// Position within the rise (0 to 1) or the fall (1 to 0)
+		fCycle = fmod((double) (nIdx - nStart) * 1000.0 / PING_SAMPLE_RATE_HZ, pSiren->RiseMs + pSiren->FallMs);
+		fRise = (fCycle < pSiren->RiseMs) ? (float) (fCycle / pSiren->RiseMs) : 1.0f - (float) ((fCycle - pSiren->RiseMs) / pSiren->FallMs);
+
+		if(pSiren->Shape == PING_SIREN_SHAPE_LINEAR)
+			fFrequency = pSiren->fLoHz + (pSiren->fHiHz - pSiren->fLoHz) * fRise;
+		else
+			fFrequency = pSiren->fLoHz * powf(pSiren->fHiHz / pSiren->fLoHz, fRise);
+
+		fPhase += 2.0 * M_PI * fFrequency / PING_SAMPLE_RATE_HZ;
+		fGain = (nIdx - nStart < nRamp) ? 0.5f - 0.5f * cosf((float) M_PI * (nIdx - nStart) / nRamp) : 1.0f;
+
+		pMix[nIdx] += fGain * fAmplitude * (float) (sin(fPhase) + sin(3.0 * fPhase) / 3.0 + sin(5.0 * fPhase) / 5.0);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The AddSpeech() function adds speech-like syllables: a glottal pulse train with a gliding
+// pitch through three random formants, or a burst of high-passed noise for a fricative.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void AddSpeech(float *pMix, uint32_t nSamples)
+{
+	ping_resonator_t Formant[3];
+	uint32_t nPos = 0, nLength, nIdx;
+	float fPitch, fPitchEnd, fPhase = 0.0f, fEnvelope, fExcitation, fLast = 0.0f, fNoise;
+	bool bVoiced;
+
+	while(nPos < nSamples)
+	{
+		nLength = (uint32_t) (RandomUniform(0.12f, 0.35f) * PING_CORPUS_FS);
+		bVoiced = RandomUniform(0.0f, 1.0f) < 0.8f;
+		fPitch = RandomUniform(100.0f, 220.0f);
+		fPitchEnd = fPitch * RandomUniform(0.8f, 1.2f);
+
+		ResonatorInit(&Formant[0], RandomUniform(300.0f, 800.0f), 80.0f);
+		ResonatorInit(&Formant[1], RandomUniform(900.0f, 2300.0f), 120.0f);
+		ResonatorInit(&Formant[2], RandomUniform(2400.0f, 3000.0f), 160.0f);
+
+		for(nIdx=0; (nIdx < nLength) && (nPos + nIdx < nSamples); nIdx++)
+		{
+			fEnvelope = sinf((float) M_PI * nIdx / nLength);
+
+			if(bVoiced)
+			{
+				fPhase += (fPitch + (fPitchEnd - fPitch) * nIdx / nLength) / PING_CORPUS_FS;
+				fExcitation = 0.0f;
+
+				if(fPhase >= 1.0f)
+				{
+					fPhase -= 1.0f;
+					fExcitation = 1.0f;
+				}
+
+				pMix[nPos + nIdx] += fEnvelope * (ResonatorRun(&Formant[0], fExcitation) +
+					0.5f * ResonatorRun(&Formant[1], fExcitation) + 0.25f * ResonatorRun(&Formant[2], fExcitation));
+			}
+			else
+			{
+				// First difference of white noise, most of the energy above 4 kHz
+				fNoise = RandomGauss();
+				pMix[nPos + nIdx] += 0.01f * fEnvelope * (fNoise - fLast);
+				fLast = fNoise;
+			}
+		}
+
+		nPos += nLength + (uint32_t) (RandomUniform(0.03f, 0.25f) * PING_CORPUS_FS);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The AddMusic() function adds notes and chords of harmonic tones with a plucked envelope.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void AddMusic(float *pMix, uint32_t nSamples)
+{
+	uint32_t nPos = 0, nLength, nNotes, nNote, nHarmonic, nIdx;
+	float fFundamental, fEnvelope, fSample;
+
+	while(nPos < nSamples)
+	{
+		nLength = (uint32_t) (RandomUniform(0.15f, 0.6f) * PING_CORPUS_FS);
+		nNotes = 1 + RandomNext() % 3;
+
+		for(nNote=0; nNote < nNotes; nNote++)
+		{
+			// MIDI 45..88, 110 Hz to 1.3 kHz
+			fFundamental = 440.0f * powf(2.0f, ((float) (45 + RandomNext() % 44) - 69.0f) / 12.0f);
+
+			for(nIdx=0; (nIdx < nLength) && (nPos + nIdx < nSamples); nIdx++)
+			{
+				fEnvelope = MIN(1.0f, nIdx / (0.01f * PING_CORPUS_FS)) * expf(-(float) nIdx / (0.3f * PING_CORPUS_FS));
+				fSample = 0.0f;
+
+				for(nHarmonic=1; (nHarmonic <= 16) && (nHarmonic * fFundamental < PING_CORPUS_FS / 2); nHarmonic++)
+				{
+					fSample += sinf(2.0f * (float) M_PI * nHarmonic * fFundamental * nIdx / PING_CORPUS_FS) / nHarmonic;
+				}
+
+				pMix[nPos + nIdx] += fEnvelope * fSample;
+			}
+		}
+
+		nPos += nLength;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The AddHvac() function adds air handler noise: brown rumble, 60 Hz hum with harmonics, a
+// fan blade tone and broadband airflow, slowly modulated.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void AddHvac(float *pMix, uint32_t nSamples)
+{
+	float fBrown = 0.0f, fSwell;
+	double fTime;
+	uint32_t nIdx;
+
+	for(nIdx=0; nIdx < nSamples; nIdx++)
+	{
+		fTime = (double) nIdx / PING_SAMPLE_RATE_HZ;
+		fBrown = 0.995f * fBrown + 0.1f * RandomGauss();
+		fSwell = 1.0f + 0.2f * (float) sin(2.0 * M_PI * 0.2 * fTime);
+
+		pMix[nIdx] += fSwell * (fBrown + (float) (
+			0.5 * sin(2.0 * M_PI * 60.0 * fTime) +
+			0.3 * sin(2.0 * M_PI * 120.0 * fTime) +
+			0.15 * sin(2.0 * M_PI * 180.0 * fTime) +
+			0.2 * sin(2.0 * M_PI * 200.0 * fTime)) +
+			0.2f * RandomGauss());
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The AddKitchen() function adds a quiet room with clatter, decaying resonances at random
+// frequencies up to 9 kHz about three times a second, and a few appliance beeps.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void AddKitchen(float *pMix, uint32_t nSamples)
+{
+	ping_resonator_t Clatter;
+	uint32_t nIdx, nLength, nBeep, nBeeps, nStart;
+	float fDecay, fAmplitude, fFrequency;
+
+	AddWhite(pMix, nSamples, 0.02f);
+
+	for(nStart=0; nStart < nSamples; nStart += (uint32_t) (RandomUniform(0.05f, 0.6f) * PING_CORPUS_FS))
+	{
+		ResonatorInit(&Clatter, RandomUniform(1000.0f, 9000.0f), RandomUniform(50.0f, 400.0f));
+		fDecay = RandomUniform(0.01f, 0.08f) * PING_CORPUS_FS;
+		fAmplitude = RandomUniform(0.5f, 1.0f);
+		nLength = (uint32_t) (5.0f * fDecay);
+
+		for(nIdx=0; (nIdx < nLength) && (nStart + nIdx < nSamples); nIdx++)
+		{
+			pMix[nStart + nIdx] += 20.0f * fAmplitude * ResonatorRun(&Clatter, expf(-nIdx / fDecay) * RandomGauss());
+		}
+	}
+
+	for(nStart = (uint32_t) (5.0f * PING_CORPUS_FS); nStart < nSamples; nStart += (uint32_t) (RandomUniform(10.0f, 20.0f) * PING_CORPUS_FS))
+	{
+		nBeeps = 1 + RandomNext() % 3;
+		fFrequency = RandomUniform(2000.0f, 4000.0f);
+
+		for(nBeep=0; nBeep < nBeeps; nBeep++)
+		{
+			AddTone(pMix, nSamples, nStart + nBeep * (uint32_t) (0.3f * PING_CORPUS_FS), (uint32_t) (0.15f * PING_CORPUS_FS), fFrequency, 0.5f,
+				PING_CORPUS_RAMP_MS * PING_SAMPLE_RATE_HZ / 1000);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ClipAdd() function quantises a mix to 16 bits and appends it to the corpus.
+//
+// Parameter(s):
+//
+//	pName		clip name
+//	Label		one of the PING_CORPUS_LABEL_xxx labels
+//	OnsetMs		start of the alarm
+//	pMix			samples, LSB
+//	nSamples		length of pMix
+//
+// Returns false if out of memory
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool ClipAdd(ping_corpus_t *pCorpus, const char *pName, uint8_t Label, uint32_t OnsetMs, const float *pMix, uint32_t nSamples)
+{
+	ping_corpus_clip_t *pClip;
+	uint32_t nIdx;
+	float fSample;
+
+	pClip = realloc(pCorpus->pClip, (pCorpus->nClips + 1) * sizeof(ping_corpus_clip_t));
+
+	if(pClip == NULL)
+	{
+		return false;
+	}
+
+	pCorpus->pClip = pClip;
+	pClip = &pCorpus->pClip[pCorpus->nClips];
+	memset(pClip, 0, sizeof(*pClip));
+
+	snprintf(pClip->Name, sizeof(pClip->Name), "%s", pName);
+	pClip->Label = Label;
+	pClip->OnsetMs = OnsetMs;
+	pClip->Wav.nSamples = nSamples;
+	pClip->Wav.FileRateHz = PING_SAMPLE_RATE_HZ;
+	pClip->Wav.pLeft = malloc(nSamples * sizeof(int16_t));
+	pClip->Wav.pRight = malloc(nSamples * sizeof(int16_t));
+
+	if((pClip->Wav.pLeft == NULL) || (pClip->Wav.pRight == NULL))
+	{
+		ping_wav_free(&pClip->Wav);
+		return false;
+	}
+
+	for(nIdx=0; nIdx < nSamples; nIdx++)
+	{
+		fSample = MAX(-32768.0f, MIN(32767.0f, roundf(pMix[nIdx])));
+		pClip->Wav.pLeft[nIdx] = (int16_t) fSample;
+		pClip->Wav.pRight[nIdx] = (int16_t) fSample;
+	}
+
+	pCorpus->nClips++;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_corpus_synthesize() function appends the standard synthetic clips to a corpus,
+// see the top of the file.  The corpus must be zeroed before the first call.
+//
+// Returns false if out of memory
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_corpus_synthesize(ping_corpus_t *pCorpus)
+{
+	const uint32_t nAlarmSamples = PING_CORPUS_ALARM_SECONDS * PING_SAMPLE_RATE_HZ;
+	const uint32_t nNoiseSamples = PING_CORPUS_NOISE_SECONDS * PING_SAMPLE_RATE_HZ;
+	const ping_temporal_config_t *pConfig;
+	char cName[PING_CORPUS_MAX_NAME];
+	float *pMix;
+	float fAmplitude;
+	uint32_t nIdx;
+	uint8_t Label;
+	bool bOk = true;
+
+	pMix = malloc(MAX(nAlarmSamples, nNoiseSamples) * sizeof(float));
+
+	if(pMix == NULL)
+	{
+		return false;
+	}
+
+	for(Label = PING_CORPUS_LABEL_T3; Label <= PING_CORPUS_LABEL_T4; Label++)
+	{
+		pConfig = (Label == PING_CORPUS_LABEL_T3) ? &PingT3Config : &PingT4Config;
+
+		for(nIdx=0; nIdx < sizeof(PING_CORPUS_SNR_DB); nIdx++)
+		{
+			// Sine power A^2 / 2 against the full band noise power
+			fAmplitude = PING_CORPUS_NOISE_RMS * sqrtf(2.0f * powf(10.0f, PING_CORPUS_SNR_DB[nIdx] / 10.0f));
+
+			RandomSeed(1000 * Label + nIdx + 1);
+			memset(pMix, 0, nAlarmSamples * sizeof(float));
+			AddWhite(pMix, nAlarmSamples, PING_CORPUS_NOISE_RMS);
+			AddAlarm(pMix, nAlarmSamples, PING_CORPUS_ONSET_MS, pConfig, fAmplitude, 0.0f);
+
+			snprintf(cName, sizeof(cName), "%s_snr%+d", PingCorpusLabelName[Label], PING_CORPUS_SNR_DB[nIdx]);
+			bOk = bOk && ClipAdd(pCorpus, cName, Label, PING_CORPUS_ONSET_MS, pMix, nAlarmSamples);
+		}
+	}
+
+	for(nIdx=0; nIdx < sizeof(PING_CORPUS_PIEZO_SNR_DB); nIdx++)
+	{
+		fAmplitude = PING_CORPUS_NOISE_RMS * sqrtf(2.0f * powf(10.0f, PING_CORPUS_PIEZO_SNR_DB[nIdx] / 10.0f));
+
+		RandomSeed(3000 + nIdx + 1);
+		memset(pMix, 0, nAlarmSamples * sizeof(float));
+		AddWhite(pMix, nAlarmSamples, PING_CORPUS_NOISE_RMS);
+		AddAlarm(pMix, nAlarmSamples, PING_CORPUS_ONSET_MS, &PingT3Config, fAmplitude, PING_CORPUS_PIEZO_SECOND);
+
+		snprintf(cName, sizeof(cName), "piezo_snr%+d", PING_CORPUS_PIEZO_SNR_DB[nIdx]);
+		bOk = bOk && ClipAdd(pCorpus, cName, PING_CORPUS_LABEL_T3, PING_CORPUS_ONSET_MS, pMix, nAlarmSamples);
+	}
+
+	RandomSeed(1);
+	memset(pMix, 0, nNoiseSamples * sizeof(float));
+	AddSpeech(pMix, nNoiseSamples);
+	ScaleToRms(pMix, nNoiseSamples, PING_CORPUS_CLUTTER_RMS);
+	bOk = bOk && ClipAdd(pCorpus, "speech", PING_CORPUS_LABEL_NONE, 0, pMix, nNoiseSamples);
+
+	RandomSeed(2);
+	memset(pMix, 0, nNoiseSamples * sizeof(float));
+	AddMusic(pMix, nNoiseSamples);
+	ScaleToRms(pMix, nNoiseSamples, PING_CORPUS_CLUTTER_RMS);
+	bOk = bOk && ClipAdd(pCorpus, "music", PING_CORPUS_LABEL_NONE, 0, pMix, nNoiseSamples);
+
+	RandomSeed(3);
+	memset(pMix, 0, nNoiseSamples * sizeof(float));
+	AddHvac(pMix, nNoiseSamples);
+	ScaleToRms(pMix, nNoiseSamples, PING_CORPUS_CLUTTER_RMS);
+	bOk = bOk && ClipAdd(pCorpus, "hvac", PING_CORPUS_LABEL_NONE, 0, pMix, nNoiseSamples);
+
+	RandomSeed(4);
+	memset(pMix, 0, nNoiseSamples * sizeof(float));
+	AddKitchen(pMix, nNoiseSamples);
+	ScaleToRms(pMix, nNoiseSamples, PING_CORPUS_CLUTTER_RMS);
+	bOk = bOk && ClipAdd(pCorpus, "kitchen", PING_CORPUS_LABEL_NONE, 0, pMix, nNoiseSamples);
+
+	RandomSeed(5);
+	memset(pMix, 0, nNoiseSamples * sizeof(float));
+	AddWhite(pMix, nNoiseSamples, PING_CORPUS_QUIET_RMS);
+	bOk = bOk && ClipAdd(pCorpus, "quiet", PING_CORPUS_LABEL_NONE, 0, pMix, nNoiseSamples);
+
+	free(pMix);
+
+	return bOk;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_corpus_sirens() function appends the synthetic siren clips to a corpus, see the
+// top of the file.  They are labeled PING_CORPUS_LABEL_NONE, no temporal alarm, with the
+// siren in pSiren.
+//
+// Returns false if out of memory
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_corpus_sirens(ping_corpus_t *pCorpus)
+{
+	const uint32_t nSamples = PING_CORPUS_SIREN_SECONDS * PING_SAMPLE_RATE_HZ;
+	char cName[PING_CORPUS_MAX_NAME];
+	float *pMix;
+	float fAmplitude;
+	uint32_t nSiren, nIdx;
+	bool bOk = true;
+
+	pMix = malloc(nSamples * sizeof(float));
+
+	if(pMix == NULL)
+	{
+		return false;
+	}
+
+	for(nSiren=0; nSiren < PING_CORPUS_NUM_SIRENS; nSiren++)
+	{
+		for(nIdx=0; nIdx < sizeof(PING_CORPUS_SIREN_SNR_DB); nIdx++)
+		{
+			fAmplitude = PING_CORPUS_NOISE_RMS * sqrtf(2.0f * powf(10.0f, PING_CORPUS_SIREN_SNR_DB[nIdx] / 10.0f));
+
+			RandomSeed(100 * (nSiren + 1) + nIdx + 1);
+			memset(pMix, 0, nSamples * sizeof(float));
+			AddWhite(pMix, nSamples, PING_CORPUS_NOISE_RMS);
+			AddSiren(pMix, nSamples, PING_CORPUS_ONSET_MS, &PingCorpusSiren[nSiren], fAmplitude);
+
+			snprintf(cName, sizeof(cName), "%s_snr%+d", PingCorpusSiren[nSiren].pName, PING_CORPUS_SIREN_SNR_DB[nIdx]);
+			bOk = bOk && ClipAdd(pCorpus, cName, PING_CORPUS_LABEL_NONE, PING_CORPUS_ONSET_MS, pMix, nSamples);
+
+			if(bOk)
+			{
+				pCorpus->pClip[pCorpus->nClips - 1].pSiren = &PingCorpusSiren[nSiren];
+			}
+		}
+	}
+
+	free(pMix);
+
+	return bOk;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_corpus_load() function appends the recordings listed in a manifest.  Each line
+// of the manifest is
+//
+//	path,label,onset_s
+//
+// with label one of PingCorpusLabelName[] and onset_s the start of the alarm in seconds
+// (ignored for none).  Relative paths are taken from the directory of the manifest.  Empty
+// lines and lines starting with # are skipped.
+//
+// Parameter(s):
+//
+//	pManifest	manifest file
+//
+// Returns false, with a message on the log, on the first clip that cannot be used
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_corpus_load(ping_corpus_t *pCorpus, const char *pManifest)
+{
+	FILE *pFile;
+	char cLine[512], cPath[768];
+	char *pPath, *pLabel, *pOnset, *pSlash;
+	ping_corpus_clip_t *pClip;
+	uint32_t nLine = 0;
+	int nDirLength;
+	uint8_t Label;
+
+	pFile = fopen(pManifest, "r");
+
+	if(pFile == NULL)
+	{
+		NRF_LOG_RAW_INFO("%s: cannot open\n", pManifest);
+		return false;
+	}
+
+	pSlash = strrchr(pManifest, '/');
+	nDirLength = (pSlash != NULL) ? (int) (pSlash - pManifest + 1) : 0;
+
+	while(fgets(cLine, sizeof(cLine), pFile) != NULL)
+	{
+		nLine++;
+		cLine[strcspn(cLine, "\r\n")] = '\0';
+
+		if((cLine[0] == '\0') || (cLine[0] == '#'))
+		{
+			continue;
+		}
+
+		pPath = strtok(cLine, ",");
+		pLabel = strtok(NULL, ",");
+		pOnset = strtok(NULL, ",");
+
+		for(Label=0; (pLabel != NULL) && (Label < PING_CORPUS_NUM_LABELS); Label++)
+		{
+			if(strcmp(pLabel, PingCorpusLabelName[Label]) == 0)
+			{
+				break;
+			}
+		}
+
+		if((pPath == NULL) || (pLabel == NULL) || (Label == PING_CORPUS_NUM_LABELS) || ((Label != PING_CORPUS_LABEL_NONE) && (pOnset == NULL)))
+		{
+			NRF_LOG_RAW_INFO("%s:%lu: expected path,none|t3|t4,onset_s\n", pManifest, (unsigned long) nLine);
+			fclose(pFile);
+			return false;
+		}
+
+		if(pPath[0] == '/')
+		{
+			snprintf(cPath, sizeof(cPath), "%s", pPath);
+		}
+		else
+		{
+			snprintf(cPath, sizeof(cPath), "%.*s%s", nDirLength, pManifest, pPath);
+		}
+
+		pClip = realloc(pCorpus->pClip, (pCorpus->nClips + 1) * sizeof(ping_corpus_clip_t));
+
+		if(pClip == NULL)
+		{
+			fclose(pFile);
+			return false;
+		}
+
+		pCorpus->pClip = pClip;
+		pClip = &pCorpus->pClip[pCorpus->nClips];
+		memset(pClip, 0, sizeof(*pClip));
+
+		if(!ping_wav_load(cPath, &pClip->Wav))
+		{
+			fclose(pFile);
+			return false;
+		}
+
+		snprintf(pClip->Name, sizeof(pClip->Name), "%s", pPath);
+		pClip->Label = Label;
+		pClip->OnsetMs = (Label != PING_CORPUS_LABEL_NONE) ? (uint32_t) (strtof(pOnset, NULL) * 1000.0f + 0.5f) : 0;
+		pCorpus->nClips++;
+	}
+
+	fclose(pFile);
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_corpus_free() function releases every clip.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_corpus_free(ping_corpus_t *pCorpus)
+{
+	uint32_t nIdx;
+
+	for(nIdx=0; nIdx < pCorpus->nClips; nIdx++)
+	{
+		ping_wav_free(&pCorpus->pClip[nIdx].Wav);
+	}
+
+	free(pCorpus->pClip);
+	memset(pCorpus, 0, sizeof(*pCorpus));
+}
@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_corpus.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_corpus.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_CORPUS_H
+#define PING_CORPUS_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Clip labels, what the clip should be detected as
+
+#define PING_CORPUS_LABEL_NONE			0	// No alarm, every confirmation is a false alarm
+#define PING_CORPUS_LABEL_T3				1	// Temporal-Three alarm from OnsetMs
+#define PING_CORPUS_LABEL_T4				2	// Temporal-Four alarm from OnsetMs
+
+#define PING_CORPUS_NUM_LABELS			3
+
+#define PING_CORPUS_MAX_NAME				64
+
+// Sirens of ping_corpus_sirens(), see PingCorpusSiren[]
+
+#define PING_CORPUS_NUM_SIRENS			4
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// A siren, rising from fLoHz to fHiHz in RiseMs and falling back in FallMs over and over
+
+typedef struct
+{
+	const char *pName;
+	uint8_t Class;				// PING_SIREN_CLASS_xxx it should be reported as
+	uint8_t Shape;				// PING_SIREN_SHAPE_xxx
+	float fLoHz;
+	float fHiHz;
+	uint32_t RiseMs;
+	uint32_t FallMs;
+} ping_corpus_siren_t;
+
+typedef struct
+{
+	char Name[PING_CORPUS_MAX_NAME];
+	uint8_t Label;
+	uint32_t OnsetMs;			// start of the alarm or siren, 0 for neither
+	const ping_corpus_siren_t *pSiren;	// siren from OnsetMs, NULL for none
+	ping_wav_t Wav;
+} ping_corpus_clip_t;
+
+typedef struct
+{
+	ping_corpus_clip_t *pClip;
+	uint32_t nClips;
+} ping_corpus_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern const char * const PingCorpusLabelName[PING_CORPUS_NUM_LABELS];
+extern const ping_corpus_siren_t PingCorpusSiren[PING_CORPUS_NUM_SIRENS];
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern bool ping_corpus_synthesize(ping_corpus_t *pCorpus);
+extern bool ping_corpus_sirens(ping_corpus_t *pCorpus);
+extern bool ping_corpus_load(ping_corpus_t *pCorpus, const char *pManifest);
+extern void ping_corpus_free(ping_corpus_t *pCorpus);
+
+#endif //  PING_CORPUS_H
@@ -0,0 +1,280 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_host.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Per frame detection pipeline of the host tools
+//
+//	ping_host_frame() does for one frame what ProcessFrame() and ProcessDetection() in main.c
+//	do on target, with the LEDs and the log replaced by a result record and the RTC replaced
+//	by the position in the recording.  Keep the two in step.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "nrf.h"
+#include "nordic_common.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_fft.h"
+#include "ping_cfar.h"
+#include "ping_temporal.h"
+#include "ping_ring.h"
+#include "ping_profile.h"
+#include "ping_tables.h"
+#include "ping_nn.h"
+#include "ping_flux.h"
+#include "ping_siren.h"
+
+#include "ping_wav.h"
+#include "ping_i2s_host.h"
+#include "ping_host.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Command line names of the PING_DETECTOR_xxx modes
+const char * const PingHostModeName[PING_DETECTOR_NUM_MODES] =
+{
+	"fft",
+	"goertzel",
+	"sdft",
+	"q15",
+	"q31",
+	"welch",
+	"zoom",
+	"harmonic",
+};
+
+static ping_temporal_t T3Decoder;
+static ping_temporal_t T4Decoder;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_host_mode_parse() function looks up a detector mode by its PingHostModeName[].
+//
+// Parameter(s):
+//
+//	pName		mode name
+//	pMode		receives the PING_DETECTOR_xxx mode
+//
+// Returns false if the name is unknown
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_host_mode_parse(const char *pName, uint8_t *pMode)
+{
+	uint8_t nIdx;
+
+	for(nIdx=0; nIdx < PING_DETECTOR_NUM_MODES; nIdx++)
+	{
+		if(strcmp(pName, PingHostModeName[nIdx]) == 0)
+		{
+			*pMode = nIdx;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_host_tone() function makes the per frame tone decision of ProcessDetection().
+//
+// Parameter(s):
+//
+//	pPeak			peak left by ping_detect()
+//	fMinAmplitude		smallest peak amplitude taken as a tone, 0 as on target
+//
+// Returns true if the alarm tone is present
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_host_tone(const ping_peak_t *pPeak, float fMinAmplitude)
+{
+	// No peak leaves fFrequency at 0, well outside the band
+	return (pPeak->fFrequency >= PING_ALARM_FREQ_LO_HZ) && (pPeak->fFrequency <= PING_ALARM_FREQ_HI_HZ) &&
+		(pPeak->fAmplitude >= fMinAmplitude);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_host_open() function sets up the pipeline for a new recording: detector mode and
+// length, the temporal decoders and the pulse edge detector.
+//
+// Parameter(s):
+//
+//	nMode		one of the PING_DETECTOR_xxx modes
+//	nFftLength	analysis length, see ping_fft_length_set()
+//
+// Returns false if the mode or the length is not supported
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_host_open(uint8_t nMode, uint32_t nFftLength)
+{
+	// Setting the length also rebuilds the Goertzel and sliding DFT banks and restarts the
+	// Welch and zoom chains, so no state is carried over from the previous recording
+	if(!ping_fft_length_set(nFftLength) || !ping_detector_select(nMode))
+	{
+		return false;
+	}
+
+	ping_cfar_init();
+
+	ping_temporal_init(&T3Decoder, &PingT3Config);
+	ping_temporal_init(&T4Decoder, &PingT4Config);
+
+	// Edge and sweep times count from the start of the recording
+#if PING_FLUX_ENABLED
+	ping_flux_reset(0);
+#endif
+#if PING_SIREN_ENABLED
+	ping_siren_reset(0);
+#endif
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_host_frame() function runs the selected detector on one I2S frame.
+//
+// Parameter(s):
+//
+//	pFrame		frame from the ring, one 32-bit stereo word per sample
+//	nSamples		number of stereo words in the frame
+//	TimeMs		time of the end of the frame in the recording
+//	pResult		receives what the edge detector, the siren tracker, the detector, the
+//				temporal decoders and the classifier made of it
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_host_frame(const uint32_t *pFrame, uint32_t nSamples, uint32_t TimeMs, ping_host_result_t *pResult)
+{
+	float fBinSize = PING_BIN_SIZE_HZ;
+	uint32_t Begin;
+
+	memset(pResult, 0, sizeof(*pResult));
+
+#if PING_FLUX_ENABLED
+	Begin = ping_profile_now();
+	pResult->Edge = ping_flux_push(pFrame, nSamples);
+	pResult->FluxTicks = ping_profile_now() - Begin;
+	ping_profile_record(PING_PROFILE_FLUX, pResult->FluxTicks);
+
+	if(pResult->Edge != PING_FLUX_EDGE_NONE)
+	{
+		pResult->EdgeMs = PingFluxEdge.TimeMs;
+	}
+#endif
+
+#if PING_SIREN_ENABLED
+	Begin = ping_profile_now();
+	pResult->SirenEvent = ping_siren_push(pFrame, nSamples);
+	pResult->SirenTicks = ping_profile_now() - Begin;
+	ping_profile_record(PING_PROFILE_SIREN, pResult->SirenTicks);
+
+	if(pResult->SirenEvent == PING_SIREN_EVT_SWEEP)
+	{
+		pResult->Sweep = PingSirenSweep;
+	}
+#endif
+
+	Begin = ping_profile_now();
+
+	if(PingDetectorMode == PING_DETECTOR_SDFT)
+	{
+		// The sliding DFT has a result after every frame
+		ping_sdft_update((const int16_t *) pFrame, nSamples);
+		pResult->bReady = true;
+	}
+	else
+	{
+		pResult->bReady = ping_capture_push(pFrame, nSamples);
+	}
+
+	pResult->CaptureTicks = ping_profile_now() - Begin;
+	ping_profile_record(PING_PROFILE_CAPTURE, pResult->CaptureTicks);
+
+	if(!pResult->bReady)
+	{
+		return;
+	}
+
+	Begin = ping_profile_now();
+	pResult->Index = ping_detect(fBinSize);
+	pResult->DetectTicks = ping_profile_now() - Begin;
+	ping_profile_record(PING_PROFILE_DETECT, pResult->DetectTicks);
+
+	pResult->Peak = PingPeak;
+
+	pResult->bTone = ping_host_tone(&PingPeak, 0.0f);
+
+	pResult->T3Event = ping_temporal_update(&T3Decoder, pResult->bTone, TimeMs);
+	pResult->T4Event = ping_temporal_update(&T4Decoder, pResult->bTone, TimeMs);
+
+#if PING_NN_ENABLED
+	// The main loop on target, which gets to a pending inference well before the next hop
+	pResult->bClassified = ping_nn_poll();
+
+	if(pResult->bClassified)
+	{
+		memcpy(pResult->Scores, PingNnScores, sizeof(pResult->Scores));
+	}
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_host_stream() function plays a whole recording through the I2S stand-in and the
+// buffer pool and runs ping_host_frame() on every frame, draining the ring as the analysis
+// interrupt does.  Call ping_host_open() first.
+//
+// Parameter(s):
+//
+//	pWav			recording, at PING_SAMPLE_RATE_HZ
+//	Handler		called with the result of every frame
+//	pContext		passed to Handler
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_host_stream(const ping_wav_t *pWav, ping_host_handler_t Handler, void *pContext)
+{
+	ping_host_result_t Result;
+	const uint32_t *pFrame;
+	uint32_t nSamples;
+	uint32_t nPos, nFrame = 0;
+	uint32_t TimeMs;
+
+	ping_i2s_host_start();
+
+	for(nPos=0; nPos < pWav->nSamples; nPos += AUDIO_FRAME_NUM_SAMPLES)
+	{
+		ping_i2s_host_receive(&pWav->pLeft[nPos], &pWav->pRight[nPos], MIN(AUDIO_FRAME_NUM_SAMPLES, pWav->nSamples - nPos));
+
+		while(ping_ring_count() != 0)
+		{
+			pFrame = ping_ring_peek(&nSamples);
+			TimeMs = (uint32_t) ((uint64_t) (nFrame + 1) * AUDIO_FRAME_NUM_SAMPLES * 1000 / PING_SAMPLE_RATE_HZ);
+
+			ping_host_frame(pFrame, nSamples, TimeMs, &Result);
+			ping_ring_release();
+
+			Handler(nFrame, TimeMs, &Result, pContext);
+			nFrame++;
+		}
+	}
+}
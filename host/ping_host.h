@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_host.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_host.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_HOST_H
+#define PING_HOST_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// What the pipeline made of one I2S frame.  The detector fields are only valid when bReady
+// is set, i.e. when the frame completed a detector input; the pulse edge detector and the
+// siren tracker run on every frame.
+
+typedef struct
+{
+	bool bReady;
+	uint32_t Index;				// bin returned by ping_detect()
+	ping_peak_t Peak;
+	bool bTone;					// peak inside the alarm band
+	uint8_t T3Event;				// PING_TEMPORAL_EVT_xxx
+	uint8_t T4Event;
+	uint32_t FluxTicks;			// PING_PROFILE_TICKS_PER_US, 0 without PING_FLUX_ENABLED
+	uint32_t SirenTicks;			// 0 without PING_SIREN_ENABLED
+	uint32_t CaptureTicks;
+	uint32_t DetectTicks;
+	uint8_t Edge;				// PING_FLUX_EDGE_xxx found in the frame, whether bReady or not
+	uint32_t EdgeMs;				// its time in the recording
+	uint8_t SirenEvent;			// PING_SIREN_EVT_xxx of the frame, whether bReady or not
+	ping_siren_sweep_t Sweep;	// the sweep of a PING_SIREN_EVT_SWEEP
+	bool bClassified;			// the classifier ran after the frame, Scores is valid
+	int8_t Scores[PING_NN_CLASSES];
+} ping_host_result_t;
+
+// Called by ping_host_stream() for every frame, in order
+
+typedef void (*ping_host_handler_t)(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext);
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern const char * const PingHostModeName[PING_DETECTOR_NUM_MODES];
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern bool ping_host_mode_parse(const char *pName, uint8_t *pMode);
+extern bool ping_host_tone(const ping_peak_t *pPeak, float fMinAmplitude);
+extern bool ping_host_open(uint8_t nMode, uint32_t nFftLength);
+extern void ping_host_frame(const uint32_t *pFrame, uint32_t nSamples, uint32_t TimeMs, ping_host_result_t *pResult);
+extern void ping_host_stream(const ping_wav_t *pWav, ping_host_handler_t Handler, void *pContext);
+
+#endif //  PING_HOST_H
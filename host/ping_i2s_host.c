@@ -0,0 +1,89 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_i2s_host.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Stand-in for the I2S side of drv_sgtl5000.c on the host
+//
+//	Plays the part of the I2S DMA and of i2s_data_handler(): it holds the same two RX
+//	buffers the peripheral would, writes the samples into them in the 32-bit stereo word
+//	layout of the SGTL5000 stream (left channel in the low halfword) and rotates them through
+//	ping_ring_supply() exactly as the interrupt does, so the frames reach the detectors
+//	through the real buffer pool.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "nrf.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_ring.h"
+
+#include "ping_i2s_host.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t *pRxCurrent = NULL;		// being filled by the "DMA"
+static uint32_t *pRxQueued = NULL;		// handed over with nrf_drv_i2s_next_buffers_set()
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_i2s_host_start() function resets the buffer pool and takes the first two RX
+// buffers, as nrf_drv_i2s_start() and the first NEXT_BUFFERS_NEEDED event do on target.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_i2s_host_start(void)
+{
+	pRxCurrent = ping_ring_start();
+	pRxQueued = ping_ring_supply(NULL, true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_i2s_host_receive() function delivers one I2S frame.  The frame ends up at the tail
+// of the ring, ready for ping_ring_peek().
+//
+// Parameter(s):
+//
+//	pLeft		left channel samples
+//	pRight		right channel samples
+//	nSamples		samples per channel, at most AUDIO_FRAME_NUM_SAMPLES; a short frame is
+//				padded with silence
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_i2s_host_receive(const int16_t *pLeft, const int16_t *pRight, uint32_t nSamples)
+{
+	uint32_t *pReleased;
+	uint32_t nIdx;
+
+	for(nIdx=0; nIdx < AUDIO_FRAME_NUM_SAMPLES; nIdx++)
+	{
+		if(nIdx < nSamples)
+		{
+			pRxCurrent[nIdx] = (uint16_t) pLeft[nIdx] | ((uint32_t) (uint16_t) pRight[nIdx] << 16);
+		}
+		else
+		{
+			pRxCurrent[nIdx] = 0;
+		}
+	}
+
+	// The peripheral moves on to the queued buffer and asks for the next one
+	pReleased = pRxCurrent;
+	pRxCurrent = pRxQueued;
+	pRxQueued = ping_ring_supply(pReleased, true);
+}
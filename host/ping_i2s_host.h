@@ -0,0 +1,21 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_i2s_host.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_i2s_host.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_I2S_HOST_H
+#define PING_I2S_HOST_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ping_i2s_host_start(void);
+extern void ping_i2s_host_receive(const int16_t *pLeft, const int16_t *pRight, uint32_t nSamples);
+
+#endif //  PING_I2S_HOST_H
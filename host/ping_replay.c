@@ -0,0 +1,275 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_replay.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Streams WAV recordings through the detection pipeline on the host
+//
+//	Every recording is cut into AUDIO_FRAME_NUM_SAMPLES frames, passed through the I2S
+//	stand-in and the buffer pool, and analysed frame by frame as on target.  One CSV row per
+//	frame goes to stdout:
+//
+//	file, frame, time_ms, mode, fft_length, ready, index, frequency_hz, amplitude, tone,
+//	t3, t4, capture_us, detect_us, edge, edge_ms, sweep, sweep_shape, sweep_start_ms,
+//	sweep_ms, sweep_start_hz, sweep_end_hz
+//
+//	time_ms is the end of the frame in the recording.  The detector columns are empty while
+//	ready is 0; t3 and t4 are the temporal decoder events (none, confirmed, ended).  edge is
+//	the pulse edge found in the frame (none, onset, offset), whatever the mode, and edge_ms
+//	its time, empty without an edge.  sweep is the class of a siren sweep that ended in the
+//	frame (none, wail, yelp), also whatever the mode, and the sweep columns after it its
+//	shape (linear, exponential), start, duration and fitted start and end frequencies.
+//
+//	With -k one column per class of PingNnClassName[] follows, the q7 classifier scores of
+//	the frames after which an inference ran and empty otherwise.  They are the integers the
+//	target computes for the same input, the rows can be compared as they are.
+//
+//	Usage: ping_replay [-m mode] [-n fft_length] [-k] [-p] file.wav...
+//
+//	-m	detector, one of PingHostModeName[] (default as PING_DETECTOR_DEFAULT_MODE)
+//	-n	analysis length (default PING_FFT_DEFAULT_SIZE)
+//	-k	add the classifier scores; they need PING_NN_ENABLED, -m fft and -n PING_MEL_FFT_SIZE
+//	-p	print the profile statistics of the run to stderr at the end
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "nrf.h"
+#include "nordic_common.h"
+#include "nrf_log.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_fft.h"
+#include "ping_temporal.h"
+#include "ping_profile.h"
+#include "ping_tables.h"
+#include "ping_nn.h"
+#include "ping_flux.h"
+#include "ping_siren.h"
+
+#include "ping_wav.h"
+#include "ping_host.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static const char * const TemporalEventName[] =
+{
+	"none",
+	"confirmed",
+	"ended",
+};
+
+static const char * const FluxEdgeName[] =
+{
+	"none",
+	"onset",
+	"offset",
+};
+
+static const char * const SweepShapeName[] =
+{
+	"linear",
+	"exponential",
+};
+
+static bool bScores = false;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The WriteRow() function is the ping_host_stream() handler, one CSV row per frame.
+//
+// Parameter(s):
+//
+//	nFrame		frame number in the recording
+//	TimeMs		end of the frame in the recording
+//	pResult		what the pipeline made of the frame
+//	pContext		path of the recording
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void WriteRow(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+	uint8_t nClass;
+
+	printf("%s,%lu,%.3f,%s,%lu,%d,", (const char *) pContext, (unsigned long) nFrame,
+		(double) (nFrame + 1) * AUDIO_FRAME_NUM_SAMPLES * 1000.0 / PING_SAMPLE_RATE_HZ,
+		PingHostModeName[PingDetectorMode], (unsigned long) FftLength, pResult->bReady);
+
+	if(pResult->bReady)
+	{
+		printf("%lu,%.2f,%.2f,%d,%s,%s,", (unsigned long) pResult->Index, pResult->Peak.fFrequency,
+			pResult->Peak.fAmplitude, pResult->bTone, TemporalEventName[pResult->T3Event], TemporalEventName[pResult->T4Event]);
+	}
+	else
+	{
+		printf(",,,,,,");
+	}
+
+	printf("%.3f,%.3f,%s,", (double) pResult->CaptureTicks / PING_PROFILE_TICKS_PER_US,
+		(double) pResult->DetectTicks / PING_PROFILE_TICKS_PER_US, FluxEdgeName[pResult->Edge]);
+
+	if(pResult->Edge != PING_FLUX_EDGE_NONE)
+	{
+		printf("%lu", (unsigned long) pResult->EdgeMs);
+	}
+
+	if(pResult->SirenEvent == PING_SIREN_EVT_SWEEP)
+	{
+		printf(",%s,%s,%lu,%lu,%.1f,%.1f", PingSirenClassName[pResult->Sweep.Class], SweepShapeName[pResult->Sweep.Shape],
+			(unsigned long) pResult->Sweep.StartMs, (unsigned long) pResult->Sweep.DurationMs,
+			pResult->Sweep.fStartHz, pResult->Sweep.fEndHz);
+	}
+	else
+	{
+		printf(",none,,,,,");
+	}
+
+	if(bScores)
+	{
+		for(nClass=0; nClass < PING_NN_CLASSES; nClass++)
+		{
+			if(pResult->bClassified)
+			{
+				printf(",%d", pResult->Scores[nClass]);
+			}
+			else
+			{
+				printf(",");
+			}
+		}
+	}
+
+	printf("\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ReplayFile() function streams one recording through the pipeline and writes its rows.
+//
+// Parameter(s):
+//
+//	pPath		WAV file
+//	nMode		one of the PING_DETECTOR_xxx modes
+//	nFftLength	analysis length
+//
+// Returns false if the file could not be read
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool ReplayFile(const char *pPath, uint8_t nMode, uint32_t nFftLength)
+{
+	ping_wav_t Wav;
+
+	if(!ping_wav_load(pPath, &Wav))
+	{
+		return false;
+	}
+
+	ping_host_open(nMode, nFftLength);
+	ping_host_stream(&Wav, WriteRow, (void *) pPath);
+
+	ping_wav_free(&Wav);
+
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	uint8_t nMode = PING_DETECTOR_DEFAULT_MODE;
+	uint32_t nFftLength = PING_FFT_DEFAULT_SIZE;
+	bool bProfile = false;
+	int nOption, nIdx;
+	int nFailures = 0;
+
+	while((nOption = getopt(argc, argv, "m:n:kp")) != -1)
+	{
+		switch(nOption)
+		{
+			case 'm':
+				if(!ping_host_mode_parse(optarg, &nMode))
+				{
+					NRF_LOG_RAW_INFO("unknown mode %s\n", optarg);
+					return 2;
+				}
+				break;
+
+			case 'n':
+				nFftLength = (uint32_t) strtoul(optarg, NULL, 0);
+				break;
+
+			case 'k':
+#if PING_NN_ENABLED
+				bScores = true;
+				break;
+#else
+				NRF_LOG_RAW_INFO("-k: built without the classifier, see PING_NN_ENABLED\n");
+				return 2;
+#endif
+
+			case 'p':
+				bProfile = true;
+				break;
+
+			default:
+				NRF_LOG_RAW_INFO("usage: %s [-m mode] [-n fft_length] [-k] [-p] file.wav...\n", argv[0]);
+				return 2;
+		}
+	}
+
+	if(optind >= argc)
+	{
+		NRF_LOG_RAW_INFO("usage: %s [-m mode] [-n fft_length] [-k] [-p] file.wav...\n", argv[0]);
+		return 2;
+	}
+
+	if(!ping_host_open(nMode, nFftLength))
+	{
+		NRF_LOG_RAW_INFO("fft length %lu not supported, %d..%d and a power of two\n", (unsigned long) nFftLength, PING_FFT_MIN_SIZE, PING_FFT_MAX_SIZE);
+		return 2;
+	}
+
+	ping_profile_init();
+
+	printf("file,frame,time_ms,mode,fft_length,ready,index,frequency_hz,amplitude,tone,t3,t4,capture_us,detect_us,edge,edge_ms,sweep,sweep_shape,sweep_start_ms,sweep_ms,sweep_start_hz,sweep_end_hz");
+
+#if PING_NN_ENABLED
+	if(bScores)
+	{
+		for(nIdx=0; nIdx < PING_NN_CLASSES; nIdx++)
+		{
+			printf(",%s", PingNnClassName[nIdx]);
+		}
+	}
+#endif
+
+	printf("\n");
+
+	for(nIdx=optind; nIdx < argc; nIdx++)
+	{
+		if(!ReplayFile(argv[nIdx], nMode, nFftLength))
+		{
+			nFailures++;
+		}
+	}
+
+	if(bProfile)
+	{
+		ping_profile_dump();
+	}
+
+	return (nFailures == 0) ? 0 : 1;
+}
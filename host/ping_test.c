@@ -0,0 +1,1391 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_test.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Host checks of the detection pipeline, run by ctest
+//
+//	Each check is a subcommand that prints what it finds to stderr and exits with 0 when
+//	every assertion held, 1 otherwise; host/CMakeLists.txt registers one test per check.
+//
+//		replay		streams the clean alarm clips and the negative clips of
+//					ping_corpus_synthesize() through the pipeline in the default mode,
+//					as ping_replay does.  The decoder of the label must confirm after the
+//					onset and nothing may confirm anywhere else.
+//
+//		goertzel		sweeps a tone over the alarm band at several analysis lengths and
+//					runs the FFT and the Goertzel detectors on it.  Every input must give
+//					the same peak bin in both, and frequencies and amplitudes within
+//					TEST_GOERTZEL_FREQ_BINS and TEST_GOERTZEL_AMPLITUDE of each other.
+//
+//		fixed		runs tones over the alarm band at several levels through the Q15 and
+//					Q31 FFT detectors.  The reference is the Goertzel bank: the bins of
+//					the float spectrum, interpolated as the fixed-point paths do, so
+//					what is left is their arithmetic error.  Every input must give the
+//					same peak bin, with the amplitude and frequency within what the
+//					error bound of ping_fft.c allows, see TestFixedBound().
+//
+//		harmonic		runs a piezo-like tone, a fundamental in the alarm band with a second
+//					harmonic TEST_HARMONIC_SECOND times as strong, over low frequency
+//					rumble through the harmonic and the full FFT detectors at several
+//					analysis lengths.  Every input holding the tone must peak within a
+//					bin of the fundamental in the harmonic mode, and never there in the
+//					full FFT mode, whose argmax goes to the harmonic or the rumble.
+//
+//		edges		streams the alarm clips of TestEdgeClip[] through the pulse edge
+//					detector.  The onset must be PING_FLUX_ONSET_DB, every nominal pulse
+//					start and end must have an edge of its type within one hop,
+//					PING_FLUX_HOP_MS, and there must be no other edges.
+//
+//		sirens		streams the linear and exponential wail and yelp of ping_corpus_sirens()
+//					at TEST_SIREN_SNR through the siren tracker.  Every nominal rise and
+//					fall must be matched by a sweep of the siren's class and direction
+//					whose middle lies inside it, with the siren's shape and a mean rate
+//					within TEST_SIREN_RATE of nominal: in Hz per second for a linear
+//					sweep, in octaves per second for an exponential one.
+//
+//		nn			runs ping_nn_selftest() on the weights of ping_nn_weights.c, which must
+//					give the PingNnSelfTestExpected that tools/ping_nn_weights.py worked
+//					out for them.  Passes when PING_NN_ENABLED is 0, nothing to run.
+//
+//		cfar			feeds ping_cfar_update() magnitude spectra of broadband noise, Rayleigh
+//					distributed bins of equal mean, then the same with tone bins added.
+//					The threshold must be PING_CFAR_THRESHOLD_DB, noise must never give a
+//					dominant bin, a tone bin TEST_CFAR_MARGIN over the threshold must, one
+//					as far under it must not, and of two tones the stronger is the peak.
+//
+//		temporal		drives the T-3 and T-4 decoders of ping_temporal.c with tone
+//					decisions made up frame by frame, no audio.  The nominal cadence must
+//					confirm once, at the end of the last pulse of group GroupsToConfirm,
+//					and end once, ToleranceMs after the pause it stops in.  Pulses, gaps
+//					and pauses off by less than ToleranceMs must still confirm, by more
+//					must not, and a missed pulse must put confirmation back by the groups
+//					it broke.
+//
+//	Usage: ping_test check
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "nrf.h"
+#include "nordic_common.h"
+#include "nrf_log.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_fft.h"
+#include "ping_cfar.h"
+#include "ping_temporal.h"
+#include "ping_profile.h"
+#include "ping_tables.h"
+#include "ping_nn.h"
+#include "ping_flux.h"
+#include "ping_siren.h"
+
+#include "ping_wav.h"
+#include "ping_host.h"
+#include "ping_corpus.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Clips of the replay check, by name
+static const char * const TestReplayClip[] =
+{
+	"t3_snr+20",
+	"t3_snr+10",
+	"t4_snr+20",
+	"t4_snr+10",
+	"speech",
+	"music",
+	"hvac",
+	"kitchen",
+	"quiet",
+};
+
+#define TEST_NUM_REPLAY_CLIPS	(sizeof(TestReplayClip) / sizeof(TestReplayClip[0]))
+
+// Test tones, after TEST_TONE_ONSET_MS of noise alone so that the noise floor of the FFT
+// detector is learnt without them, then long enough for a few inputs at the longest length
+#define TEST_TONE_ONSET_MS		500
+#define TEST_TONE_MS				800			// whole recording
+#define TEST_TONE_AMPLITUDE		8000.0f
+#define TEST_TONE_NOISE			100.0f		// peak of the uniform noise under the tone, LSB
+#define TEST_TONE_STEPS			16			// tones across the alarm band, ends included
+#define TEST_MAX_INPUTS			((TEST_TONE_MS * PING_SAMPLE_RATE_HZ / 1000) / PING_FFT_MIN_SIZE + 1)
+
+// Analysis lengths of the goertzel check
+static const uint32_t TestGoertzelLength[] = { 256, 512, 1024 };
+
+#define TEST_NUM_GOERTZEL_LENGTHS	(sizeof(TestGoertzelLength) / sizeof(TestGoertzelLength[0]))
+
+// Largest differences allowed between the two detectors
+#define TEST_GOERTZEL_FREQ_BINS	0.05f		// peak frequency, bins
+#define TEST_GOERTZEL_AMPLITUDE	0.02f		// peak amplitude, relative
+
+// Analysis lengths, tone frequencies and levels of the fixed check
+static const uint32_t TestFixedLength[] = { 256, 1024 };
+static const float TestFixedLevelDb[] = { -3.0f, -20.0f, -40.0f };	// dB of full scale
+
+#define TEST_NUM_FIXED_LENGTHS	(sizeof(TestFixedLength) / sizeof(TestFixedLength[0]))
+#define TEST_NUM_FIXED_LEVELS		(sizeof(TestFixedLevelDb) / sizeof(TestFixedLevelDb[0]))
+#define TEST_FIXED_STEPS			8
+#define TEST_FIXED_TIE_BINS		0.05f
+
+// Harmonic check, a piezo sounder at the centre of the alarm band over HVAC-like rumble
+#define TEST_HARMONIC_FREQ_HZ		((PING_ALARM_FREQ_LO_HZ + PING_ALARM_FREQ_HI_HZ) / 2)
+#define TEST_HARMONIC_AMPLITUDE	2000.0f		// fundamental, LSB
+#define TEST_HARMONIC_SECOND		2.0f			// second harmonic over the fundamental, +6 dB
+#define TEST_HARMONIC_RUMBLE		4000.0f		// rms of the rumble, LSB
+#define TEST_HARMONIC_RUMBLE_HZ	200.0f		// corner of the one-pole low-pass shaping it
+
+// Edges check
+#if PING_FLUX_ENABLED
+static const char * const TestEdgeClip[] =
+{
+	"t3_snr+20", "t3_snr+10", "t4_snr+20", "t4_snr+10",
+};
+
+#define TEST_NUM_EDGE_CLIPS		(sizeof(TestEdgeClip) / sizeof(TestEdgeClip[0]))
+#endif
+#define TEST_MAX_EDGES			256
+
+// Sirens check
+#define TEST_SIREN_SNR			"+20"		// suffix of the clip names, dB
+#define TEST_SIREN_MARGIN_MS		250			// sweeps ending closer than this to the end of a clip are not due
+#define TEST_SIREN_RATE			0.10f		// mean rate, relative
+#define TEST_MAX_SWEEPS			128
+
+// CFAR check
+#define TEST_CFAR_BINS			(PING_FFT_DEFAULT_SIZE / 2)
+#define TEST_CFAR_SPECTRA		250			// 2 s of PING_FFT_DEFAULT_SIZE inputs
+#define TEST_CFAR_TONE_BIN		40
+#define TEST_CFAR_MARGIN			1.25f		// tone magnitude over or under the threshold, relative
+
+// Temporal check
+#define TEST_TEMPORAL_STEP_MS		8			// about one frame, AUDIO_FRAME_NUM_SAMPLES / PING_SAMPLE_RATE_HZ
+#define TEST_TEMPORAL_LEAD_MS		1000			// silence before the first pulse and after the pause of the last
+#define TEST_TEMPORAL_GROUPS		(PING_TEMPORAL_GROUPS_TO_CONFIRM + 2)
+#define TEST_TEMPORAL_NONE		UINT32_MAX
+
+// Confirmations of one clip
+typedef struct
+{
+	uint32_t OnsetMs;
+	uint32_t nT3Early;			// before the onset
+	uint32_t nT3;
+	uint32_t nT4Early;
+	uint32_t nT4;
+} test_replay_t;
+
+// Detector output of the inputs of one run
+typedef struct
+{
+	uint32_t nInputs;
+	uint32_t TimeMs[TEST_MAX_INPUTS];		// end of the frame that completed the input
+	uint32_t Index[TEST_MAX_INPUTS];
+	ping_peak_t Peak[TEST_MAX_INPUTS];
+} test_run_t;
+
+// Edges of one clip
+typedef struct
+{
+	uint32_t nEdges;
+	uint8_t Type[TEST_MAX_EDGES];
+	uint32_t TimeMs[TEST_MAX_EDGES];
+} test_edges_t;
+
+// Sweeps of one clip
+typedef struct
+{
+	uint32_t nSweeps;
+	ping_siren_sweep_t Sweep[TEST_MAX_SWEEPS];
+} test_sweeps_t;
+
+// Largest differences found by TestCompare()
+typedef struct
+{
+	float fMaxBins;
+	float fMaxAmplitude;		// relative to the tone amplitude
+} test_diff_t;
+
+// A made-up cadence: deviations from the nominal intervals and the pulse left out, if any
+typedef struct
+{
+	int32_t PulseMs;
+	int32_t GapMs;
+	int32_t PauseMs;
+	uint32_t nMissGroup;			// TEST_TEMPORAL_NONE for none
+	uint32_t nMissPulse;
+} test_cadence_t;
+
+// Decoder events of one cadence, times from the onset of the first pulse
+typedef struct
+{
+	uint32_t TimeMs;
+	uint32_t LastPulseEndMs;
+	uint32_t nConfirmed;
+	uint32_t ConfirmedMs;		// first, TEST_TEMPORAL_NONE if none
+	uint32_t nEnded;
+	uint32_t EndedMs;
+} test_temporal_t;
+
+typedef struct
+{
+	const char *pName;
+	int (*Run)(void);
+} test_check_t;
+
+static int nTestFailures = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestAssert() function counts and reports a failed assertion.
+//
+// Parameter(s):
+//
+//	bOk			the assertion
+//	pWhat		what was asserted, printf format
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#define TestAssert(bOk, ...) \
+	do \
+	{ \
+		if(!(bOk)) \
+		{ \
+			nTestFailures++; \
+			NRF_LOG_RAW_INFO("FAIL: "); \
+			NRF_LOG_RAW_INFO(__VA_ARGS__); \
+			NRF_LOG_RAW_INFO("\n"); \
+		} \
+	} while(0)
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestCorpusClip() function finds a clip by name.
+//
+// Returns the clip, NULL if there is none of that name
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static const ping_corpus_clip_t *TestCorpusClip(const ping_corpus_t *pCorpus, const char *pName)
+{
+	uint32_t nClip;
+
+	for(nClip=0; nClip < pCorpus->nClips; nClip++)
+	{
+		if(strcmp(pCorpus->pClip[nClip].Name, pName) == 0)
+		{
+			return &pCorpus->pClip[nClip];
+		}
+	}
+
+	return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestTone() function makes a recording of a tone from TEST_TONE_ONSET_MS in uniform
+// noise, the same in both channels.  The noise is the same in every recording.
+//
+// Parameter(s):
+//
+//	pWav			receives the samples, release with ping_wav_free()
+//	fFrequency		Hz
+//	fAmplitude		LSB
+//	DurationMs		length of the recording
+//
+// Returns false if out of memory
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool TestTone(ping_wav_t *pWav, float fFrequency, float fAmplitude, uint32_t DurationMs)
+{
+	uint32_t nIdx, nOnset;
+	uint32_t Random = 1;
+	float fSample;
+
+	memset(pWav, 0, sizeof(*pWav));
+	pWav->nSamples = DurationMs * PING_SAMPLE_RATE_HZ / 1000;
+	pWav->FileRateHz = PING_SAMPLE_RATE_HZ;
+	pWav->pLeft = malloc(pWav->nSamples * sizeof(int16_t));
+	pWav->pRight = malloc(pWav->nSamples * sizeof(int16_t));
+
+	if((pWav->pLeft == NULL) || (pWav->pRight == NULL))
+	{
+		ping_wav_free(pWav);
+		return false;
+	}
+
+	nOnset = TEST_TONE_ONSET_MS * PING_SAMPLE_RATE_HZ / 1000;
+
+	for(nIdx=0; nIdx < pWav->nSamples; nIdx++)
+	{
+		Random = Random * 1664525u + 1013904223u;
+		fSample = TEST_TONE_NOISE * ((float) (Random >> 8) / (1u << 23) - 1.0f);
+
+		if(nIdx >= nOnset)
+		{
+			fSample += fAmplitude * sinf(2.0f * (float) M_PI * fFrequency * (nIdx - nOnset) / PING_SAMPLE_RATE_HZ);
+		}
+
+		pWav->pLeft[nIdx] = (int16_t) lrintf(fSample);
+		pWav->pRight[nIdx] = pWav->pLeft[nIdx];
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestPiezo() function makes the recording of the harmonic check: white noise through
+// a one-pole low-pass, then from TEST_TONE_ONSET_MS a tone whose second harmonic is
+// stronger than the fundamental, the same in both channels.
+//
+// Parameter(s):
+//
+//	pWav			receives the samples, release with ping_wav_free()
+//	DurationMs		length of the recording
+//
+// Returns false if out of memory
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool TestPiezo(ping_wav_t *pWav, uint32_t DurationMs)
+{
+	const float fAlpha = 1.0f - expf(-2.0f * (float) M_PI * TEST_HARMONIC_RUMBLE_HZ / PING_SAMPLE_RATE_HZ);
+	uint32_t nIdx, nOnset;
+	uint32_t Random = 1;
+	float fGain, fPhase, fRumble = 0.0f, fSample;
+
+	memset(pWav, 0, sizeof(*pWav));
+	pWav->nSamples = DurationMs * PING_SAMPLE_RATE_HZ / 1000;
+	pWav->FileRateHz = PING_SAMPLE_RATE_HZ;
+	pWav->pLeft = malloc(pWav->nSamples * sizeof(int16_t));
+	pWav->pRight = malloc(pWav->nSamples * sizeof(int16_t));
+
+	if((pWav->pLeft == NULL) || (pWav->pRight == NULL))
+	{
+		ping_wav_free(pWav);
+		return false;
+	}
+
+	// Uniform noise of unit peak has an rms of 1 / sqrt(3), the low-pass keeps
+	// sqrt(alpha / (2 - alpha)) of it
+	fGain = TEST_HARMONIC_RUMBLE * sqrtf(3.0f * (2.0f - fAlpha) / fAlpha);
+	nOnset = TEST_TONE_ONSET_MS * PING_SAMPLE_RATE_HZ / 1000;
+
+	for(nIdx=0; nIdx < pWav->nSamples; nIdx++)
+	{
+		Random = Random * 1664525u + 1013904223u;
+		fRumble += fAlpha * ((float) (Random >> 8) / (1u << 23) - 1.0f - fRumble);
+		fSample = fGain * fRumble;
+
+		if(nIdx >= nOnset)
+		{
+			fPhase = 2.0f * (float) M_PI * TEST_HARMONIC_FREQ_HZ * (nIdx - nOnset) / PING_SAMPLE_RATE_HZ;
+			fSample += TEST_HARMONIC_AMPLITUDE * (sinf(fPhase) + TEST_HARMONIC_SECOND * sinf(2.0f * fPhase));
+		}
+
+		pWav->pLeft[nIdx] = (int16_t) lrintf(MAX(-32768.0f, MIN(32767.0f, fSample)));
+		pWav->pRight[nIdx] = pWav->pLeft[nIdx];
+	}
+
+	return true;
+}
+
+// ping_host_stream() handler of TestRun()
+static void TestRunFrame(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+	test_run_t *pRun = pContext;
+
+	if(pResult->bReady && (pRun->nInputs < TEST_MAX_INPUTS))
+	{
+		pRun->TimeMs[pRun->nInputs] = TimeMs;
+		pRun->Index[pRun->nInputs] = pResult->Index;
+		pRun->Peak[pRun->nInputs] = pResult->Peak;
+		pRun->nInputs++;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestRun() function streams a recording through one detector and keeps the output
+// of every input.
+//
+// Parameter(s):
+//
+//	nMode		one of the PING_DETECTOR_xxx modes
+//	nFftLength	analysis length
+//	pWav			recording
+//	pRun			receives the detector output
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void TestRun(uint8_t nMode, uint32_t nFftLength, const ping_wav_t *pWav, test_run_t *pRun)
+{
+	memset(pRun, 0, sizeof(*pRun));
+	ping_host_open(nMode, nFftLength);
+	ping_host_stream(pWav, TestRunFrame, pRun);
+}
+
+// ping_host_stream() handler of the replay check
+static void TestReplayFrame(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+	test_replay_t *pReplay = pContext;
+	bool bEarly = (TimeMs < pReplay->OnsetMs);
+
+	if(pResult->T3Event == PING_TEMPORAL_EVT_CONFIRMED)
+	{
+		if(bEarly)
+			pReplay->nT3Early++;
+		else
+			pReplay->nT3++;
+	}
+
+	if(pResult->T4Event == PING_TEMPORAL_EVT_CONFIRMED)
+	{
+		if(bEarly)
+			pReplay->nT4Early++;
+		else
+			pReplay->nT4++;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestReplay() function is the replay check, see the top of the file.
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestReplay(void)
+{
+	ping_corpus_t Corpus;
+	const ping_corpus_clip_t *pClip;
+	test_replay_t Replay;
+	uint32_t nIdx;
+
+	memset(&Corpus, 0, sizeof(Corpus));
+
+	if(!ping_corpus_synthesize(&Corpus))
+	{
+		NRF_LOG_RAW_INFO("out of memory\n");
+		return 1;
+	}
+
+	for(nIdx=0; nIdx < TEST_NUM_REPLAY_CLIPS; nIdx++)
+	{
+		pClip = TestCorpusClip(&Corpus, TestReplayClip[nIdx]);
+		TestAssert(pClip != NULL, "%s: no such clip", TestReplayClip[nIdx]);
+
+		if(pClip == NULL)
+		{
+			continue;
+		}
+
+		memset(&Replay, 0, sizeof(Replay));
+		Replay.OnsetMs = (pClip->Label == PING_CORPUS_LABEL_NONE) ? UINT32_MAX : pClip->OnsetMs;
+
+		ping_host_open(PING_DETECTOR_DEFAULT_MODE, PING_FFT_DEFAULT_SIZE);
+		ping_host_stream(&pClip->Wav, TestReplayFrame, &Replay);
+
+		NRF_LOG_RAW_INFO("%s: t3 %lu (%lu early), t4 %lu (%lu early)\n", pClip->Name,
+			(unsigned long) Replay.nT3, (unsigned long) Replay.nT3Early,
+			(unsigned long) Replay.nT4, (unsigned long) Replay.nT4Early);
+
+		TestAssert((Replay.nT3Early == 0) && (Replay.nT4Early == 0), "%s: confirmed before the onset", pClip->Name);
+		TestAssert((Replay.nT3 > 0) == (pClip->Label == PING_CORPUS_LABEL_T3), "%s: t3 decoder", pClip->Name);
+		TestAssert((Replay.nT4 > 0) == (pClip->Label == PING_CORPUS_LABEL_T4), "%s: t4 decoder", pClip->Name);
+	}
+
+	ping_corpus_free(&Corpus);
+
+	return nTestFailures;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestCompare() function runs a tone through a detector and through a reference
+// detector, and checks that every input holding the tone alone gives the same peak bin in
+// both, with frequencies and amplitudes that differ by no more than the limits.  A tone
+// within fTieBins of the middle between two bins may peak in either.
+//
+// Parameter(s):
+//
+//	nRefMode			PING_DETECTOR_xxx mode of the reference
+//	nMode			PING_DETECTOR_xxx mode under test
+//	nFftLength		analysis length
+//	fFrequency		of the tone, Hz
+//	fAmplitude		of the tone, LSB
+//	fTieBins			distance from the middle between two bins taken as a tie, bins
+//	fMaxBins			largest frequency difference, bins
+//	fMaxAmplitude	largest amplitude difference, LSB
+//	pDiff			largest differences seen, updated
+//
+// Returns false if out of memory
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool TestCompare(uint8_t nRefMode, uint8_t nMode, uint32_t nFftLength, float fFrequency, float fAmplitude,
+	float fTieBins, float fMaxBins, float fMaxAmplitude, test_diff_t *pDiff)
+{
+	static test_run_t Ref, Run;
+	ping_wav_t Wav;
+	float fBinSize, fFreqError, fAmplitudeError, fBin;
+	uint32_t nInput, nCompared, FirstMs;
+	bool bTie;
+
+	if(!TestTone(&Wav, fFrequency, fAmplitude, TEST_TONE_MS))
+	{
+		NRF_LOG_RAW_INFO("out of memory\n");
+		return false;
+	}
+
+	TestRun(nRefMode, nFftLength, &Wav, &Ref);
+	TestRun(nMode, nFftLength, &Wav, &Run);
+	ping_wav_free(&Wav);
+
+	fBinSize = (float) PING_SAMPLE_RATE_HZ / nFftLength;
+	fBin = fFrequency / fBinSize;
+	bTie = (fabsf(fBin - floorf(fBin) - 0.5f) <= fTieBins);
+
+	// Inputs that end this late hold the tone alone, one frame of margin for rounding; the
+	// last frame of the recording is padded with silence and does not count
+	FirstMs = TEST_TONE_ONSET_MS + (nFftLength + AUDIO_FRAME_NUM_SAMPLES) * 1000 / PING_SAMPLE_RATE_HZ + 1;
+
+	TestAssert((Ref.nInputs > 0) && (Ref.nInputs == Run.nInputs), "%s, %lu points, %.1f Hz: %s %lu inputs, %lu inputs",
+		PingHostModeName[nMode], (unsigned long) nFftLength, fFrequency, PingHostModeName[nRefMode], (unsigned long) Ref.nInputs, (unsigned long) Run.nInputs);
+
+	nCompared = 0;
+
+	for(nInput=0; (nInput < Ref.nInputs) && (nInput < Run.nInputs); nInput++)
+	{
+		if((Ref.TimeMs[nInput] < FirstMs) || (Ref.TimeMs[nInput] > TEST_TONE_MS))
+		{
+			continue;
+		}
+
+		nCompared++;
+		fFreqError = fabsf(Run.Peak[nInput].fFrequency - Ref.Peak[nInput].fFrequency) / fBinSize;
+		fAmplitudeError = fabsf(Run.Peak[nInput].fAmplitude - Ref.Peak[nInput].fAmplitude);
+		pDiff->fMaxBins = MAX(pDiff->fMaxBins, fFreqError);
+		pDiff->fMaxAmplitude = MAX(pDiff->fMaxAmplitude, fAmplitudeError / fAmplitude);
+
+		TestAssert((Run.Index[nInput] == Ref.Index[nInput]) ||
+			(bTie && ((Run.Index[nInput] + 1 == Ref.Index[nInput]) || (Run.Index[nInput] == Ref.Index[nInput] + 1))), "%s, %lu points, %.1f Hz, input %lu: bin %lu, %s bin %lu",
+			PingHostModeName[nMode], (unsigned long) nFftLength, fFrequency, (unsigned long) nInput,
+			(unsigned long) Run.Index[nInput], PingHostModeName[nRefMode], (unsigned long) Ref.Index[nInput]);
+		TestAssert(fFreqError <= fMaxBins, "%s, %lu points, %.1f Hz, input %lu: %.2f Hz, %s %.2f Hz",
+			PingHostModeName[nMode], (unsigned long) nFftLength, fFrequency, (unsigned long) nInput,
+			Run.Peak[nInput].fFrequency, PingHostModeName[nRefMode], Ref.Peak[nInput].fFrequency);
+		TestAssert(fAmplitudeError <= fMaxAmplitude, "%s, %lu points, %.1f Hz, input %lu: amplitude %.1f, %s %.1f",
+			PingHostModeName[nMode], (unsigned long) nFftLength, fFrequency, (unsigned long) nInput,
+			Run.Peak[nInput].fAmplitude, PingHostModeName[nRefMode], Ref.Peak[nInput].fAmplitude);
+	}
+
+	TestAssert(nCompared > 0, "%s, %lu points, %.1f Hz: no input after the onset",
+		PingHostModeName[nMode], (unsigned long) nFftLength, fFrequency);
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestGoertzel() function is the goertzel check, see the top of the file.
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestGoertzel(void)
+{
+	test_diff_t Diff;
+	float fFrequency;
+	uint32_t nLength, nStep;
+
+	for(nLength=0; nLength < TEST_NUM_GOERTZEL_LENGTHS; nLength++)
+	{
+		memset(&Diff, 0, sizeof(Diff));
+
+		for(nStep=0; nStep < TEST_TONE_STEPS; nStep++)
+		{
+			fFrequency = PING_ALARM_FREQ_LO_HZ + (PING_ALARM_FREQ_HI_HZ - PING_ALARM_FREQ_LO_HZ) * nStep / (TEST_TONE_STEPS - 1);
+
+			if(!TestCompare(PING_DETECTOR_FFT, PING_DETECTOR_GOERTZEL, TestGoertzelLength[nLength], fFrequency, TEST_TONE_AMPLITUDE,
+				0.0f, TEST_GOERTZEL_FREQ_BINS, TEST_GOERTZEL_AMPLITUDE * TEST_TONE_AMPLITUDE, &Diff))
+			{
+				return nTestFailures + 1;
+			}
+		}
+
+		NRF_LOG_RAW_INFO("%lu points: largest difference %.4f bins, amplitude %.4f\n",
+			(unsigned long) TestGoertzelLength[nLength], Diff.fMaxBins, Diff.fMaxAmplitude);
+	}
+
+	return nTestFailures;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestFixedBound() function gives the error bound of ping_fft.c for a fixed-point
+// detector: the error of a bin, in the units of the float |X[k]| divided by the length.
+// arm_rfft_q15 truncates about one output LSB, N input LSB, per radix stage and one more
+// in the magnitude; arm_rfft_q31 keeps 16 more bits, below the quantisation of the input.
+//
+// Parameter(s):
+//
+//	nMode		PING_DETECTOR_FFT_Q15 or PING_DETECTOR_FFT_Q31
+//	nFftLength	analysis length
+//
+// Returns the bound in input LSB
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static float TestFixedBound(uint8_t nMode, uint32_t nFftLength)
+{
+	return (nMode == PING_DETECTOR_FFT_Q15) ? log2f((float) nFftLength) + 1.0f : 1.0f;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestFixed() function is the fixed check, see the top of the file.  A bin error e
+// moves the amplitude of a peak by at most 2 * e / sinc(1/2) = pi * e, and its fractional
+// bin, a ratio of neighbouring bins, by about twice the relative amplitude error.  The
+// reference has its own error on the weak neighbours of a peak, the float recursion of the
+// Goertzel filters runs over the whole input, so TEST_GOERTZEL_FREQ_BINS is added to that.
+// Two bins closer than the bound may swap, which is a tie within TEST_FIXED_TIE_BINS.
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestFixed(void)
+{
+	static const uint8_t Mode[] = { PING_DETECTOR_FFT_Q15, PING_DETECTOR_FFT_Q31 };
+	test_diff_t Diff;
+	float fFrequency, fAmplitude, fMaxAmplitude;
+	uint32_t nMode, nLength, nLevel, nStep;
+
+	for(nMode=0; nMode < sizeof(Mode); nMode++)
+	{
+		for(nLength=0; nLength < TEST_NUM_FIXED_LENGTHS; nLength++)
+		{
+			for(nLevel=0; nLevel < TEST_NUM_FIXED_LEVELS; nLevel++)
+			{
+				memset(&Diff, 0, sizeof(Diff));
+				fAmplitude = 32767.0f * powf(10.0f, TestFixedLevelDb[nLevel] / 20.0f);
+				fMaxAmplitude = (float) M_PI * TestFixedBound(Mode[nMode], TestFixedLength[nLength]);
+
+				for(nStep=0; nStep < TEST_FIXED_STEPS; nStep++)
+				{
+					fFrequency = PING_ALARM_FREQ_LO_HZ + (PING_ALARM_FREQ_HI_HZ - PING_ALARM_FREQ_LO_HZ) * nStep / (TEST_FIXED_STEPS - 1);
+
+					if(!TestCompare(PING_DETECTOR_GOERTZEL, Mode[nMode], TestFixedLength[nLength], fFrequency, fAmplitude,
+						TEST_FIXED_TIE_BINS, TEST_GOERTZEL_FREQ_BINS + 2.0f * fMaxAmplitude / fAmplitude, fMaxAmplitude, &Diff))
+					{
+						return nTestFailures + 1;
+					}
+				}
+
+				NRF_LOG_RAW_INFO("%s, %lu points, %.0f dBFS: largest difference %.5f bins, amplitude %.2f LSB, bound %.2f LSB\n",
+					PingHostModeName[Mode[nMode]], (unsigned long) TestFixedLength[nLength], TestFixedLevelDb[nLevel],
+					Diff.fMaxBins, Diff.fMaxAmplitude * fAmplitude, fMaxAmplitude);
+			}
+		}
+	}
+
+	return nTestFailures;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestHarmonic() function is the harmonic check, see the top of the file.  The inputs
+// compared are those that hold the tone alone, as in TestCompare().
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestHarmonic(void)
+{
+	static test_run_t Harmonic, Fft;
+	ping_wav_t Wav;
+	float fBinSize, fError, fMaxError, fFftHz;
+	uint32_t nLength, nInput, nCompared, FirstMs;
+
+	if(!TestPiezo(&Wav, TEST_TONE_MS))
+	{
+		NRF_LOG_RAW_INFO("FAIL: out of memory\n");
+		return 1;
+	}
+
+	for(nLength=0; nLength < TEST_NUM_GOERTZEL_LENGTHS; nLength++)
+	{
+		TestRun(PING_DETECTOR_HARMONIC, TestGoertzelLength[nLength], &Wav, &Harmonic);
+		TestRun(PING_DETECTOR_FFT, TestGoertzelLength[nLength], &Wav, &Fft);
+
+		fBinSize = (float) PING_SAMPLE_RATE_HZ / TestGoertzelLength[nLength];
+		FirstMs = TEST_TONE_ONSET_MS + (TestGoertzelLength[nLength] + AUDIO_FRAME_NUM_SAMPLES) * 1000 / PING_SAMPLE_RATE_HZ + 1;
+		nCompared = 0;
+		fMaxError = 0.0f;
+		fFftHz = 0.0f;
+
+		TestAssert((Harmonic.nInputs > 0) && (Harmonic.nInputs == Fft.nInputs), "%lu points: %lu harmonic inputs, %lu FFT inputs",
+			(unsigned long) TestGoertzelLength[nLength], (unsigned long) Harmonic.nInputs, (unsigned long) Fft.nInputs);
+
+		for(nInput=0; (nInput < Harmonic.nInputs) && (nInput < Fft.nInputs); nInput++)
+		{
+			if((Harmonic.TimeMs[nInput] < FirstMs) || (Harmonic.TimeMs[nInput] > TEST_TONE_MS))
+			{
+				continue;
+			}
+
+			nCompared++;
+			fError = fabsf(Harmonic.Peak[nInput].fFrequency - TEST_HARMONIC_FREQ_HZ) / fBinSize;
+			fMaxError = MAX(fMaxError, fError);
+			fFftHz = Fft.Peak[nInput].fFrequency;
+
+			TestAssert(fError <= 1.0f, "%lu points, input %lu: harmonic %.1f Hz, fundamental %.1f Hz",
+				(unsigned long) TestGoertzelLength[nLength], (unsigned long) nInput, Harmonic.Peak[nInput].fFrequency, TEST_HARMONIC_FREQ_HZ);
+			TestAssert(fabsf(Fft.Peak[nInput].fFrequency - TEST_HARMONIC_FREQ_HZ) > fBinSize, "%lu points, input %lu: FFT %.1f Hz, on the fundamental",
+				(unsigned long) TestGoertzelLength[nLength], (unsigned long) nInput, Fft.Peak[nInput].fFrequency);
+		}
+
+		TestAssert(nCompared > 0, "%lu points: no input after the onset", (unsigned long) TestGoertzelLength[nLength]);
+
+		NRF_LOG_RAW_INFO("%lu points: harmonic within %.2f bins of the fundamental, FFT last at %.1f Hz\n",
+			(unsigned long) TestGoertzelLength[nLength], fMaxError, fFftHz);
+	}
+
+	ping_wav_free(&Wav);
+
+	return nTestFailures;
+}
+
+#if PING_FLUX_ENABLED
+
+// ping_host_stream() handler of the edges check
+static void TestEdgesFrame(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+	test_edges_t *pEdges = pContext;
+
+	if((pResult->Edge != PING_FLUX_EDGE_NONE) && (pEdges->nEdges < TEST_MAX_EDGES))
+	{
+		pEdges->Type[pEdges->nEdges] = pResult->Edge;
+		pEdges->TimeMs[pEdges->nEdges] = pResult->EdgeMs;
+		pEdges->nEdges++;
+	}
+}
+
+#endif // PING_FLUX_ENABLED
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestEdges() function is the edges check, see the top of the file.  The nominal pulses
+// run from the onset of the clip to the last one that ends a hop before the clip does.  An
+// edge is timed at the middle of the hop it was found in, so it is due within half a hop of
+// a sharp edge; the ramps of the corpus tones take up the other half.
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestEdges(void)
+{
+#if PING_FLUX_ENABLED
+	static test_edges_t Edges;
+	ping_corpus_t Corpus;
+	const ping_corpus_clip_t *pClip;
+	const ping_temporal_config_t *pConfig;
+	uint32_t nClip, nPulse, nIdx, nExpected, nMatched, PulseMs, NominalMs, EndMs, ErrorMs, MaxErrorMs;
+	float fOnset;
+	uint8_t Type;
+	bool bFound;
+
+	memset(&Corpus, 0, sizeof(Corpus));
+
+	if(!ping_corpus_synthesize(&Corpus))
+	{
+		NRF_LOG_RAW_INFO("FAIL: out of memory\n");
+		return 1;
+	}
+
+	for(nClip=0; nClip < TEST_NUM_EDGE_CLIPS; nClip++)
+	{
+		pClip = TestCorpusClip(&Corpus, TestEdgeClip[nClip]);
+		TestAssert(pClip != NULL, "no clip %s", TestEdgeClip[nClip]);
+
+		if(pClip == NULL)
+		{
+			continue;
+		}
+
+		memset(&Edges, 0, sizeof(Edges));
+		ping_host_open(PING_DETECTOR_GOERTZEL, PING_FFT_DEFAULT_SIZE);
+
+		fOnset = powf(10.0f, PING_FLUX_ONSET_DB / 20.0f) - 1.0f;
+		TestAssert(fabsf(PingFluxOnset - fOnset) <= 1e-5f * fOnset, "onset %.4f, PING_FLUX_ONSET_DB gives %.4f", PingFluxOnset, fOnset);
+
+		ping_host_stream(&pClip->Wav, TestEdgesFrame, &Edges);
+
+		pConfig = (pClip->Label == PING_CORPUS_LABEL_T3) ? &PingT3Config : &PingT4Config;
+		EndMs = (uint32_t) ((uint64_t) pClip->Wav.nSamples * 1000 / PING_SAMPLE_RATE_HZ);
+		PulseMs = pClip->OnsetMs;
+		nExpected = 0;
+		nMatched = 0;
+		MaxErrorMs = 0;
+		nPulse = 0;
+
+		while(PulseMs + pConfig->PulseMs + PING_FLUX_HOP_MS < EndMs)
+		{
+			for(Type = PING_FLUX_EDGE_ONSET; Type <= PING_FLUX_EDGE_OFFSET; Type++)
+			{
+				NominalMs = PulseMs + ((Type == PING_FLUX_EDGE_OFFSET) ? pConfig->PulseMs : 0);
+				bFound = false;
+				nExpected++;
+
+				for(nIdx=0; (nIdx < Edges.nEdges) && !bFound; nIdx++)
+				{
+					ErrorMs = (Edges.TimeMs[nIdx] > NominalMs) ? Edges.TimeMs[nIdx] - NominalMs : NominalMs - Edges.TimeMs[nIdx];
+
+					if((Edges.Type[nIdx] == Type) && (ErrorMs <= PING_FLUX_HOP_MS))
+					{
+						MaxErrorMs = MAX(MaxErrorMs, ErrorMs);
+						bFound = true;
+					}
+				}
+
+				nMatched += bFound ? 1 : 0;
+				TestAssert(bFound, "%s: no %s within a hop of %lu ms", pClip->Name, (Type == PING_FLUX_EDGE_ONSET) ? "onset" : "offset",
+					(unsigned long) NominalMs);
+			}
+
+			PulseMs += pConfig->PulseMs + ((++nPulse % pConfig->PulsesPerGroup) ? pConfig->GapMs : pConfig->PauseMs);
+		}
+
+		// Edges of a pulse cut off by the end of the clip are neither expected nor spurious
+		for(nIdx=0; nIdx < Edges.nEdges; nIdx++)
+		{
+			if(Edges.TimeMs[nIdx] + PING_FLUX_HOP_MS > PulseMs)
+				break;
+		}
+
+		TestAssert(nIdx == nMatched, "%s: %lu edges for %lu pulse starts and ends", pClip->Name, (unsigned long) nIdx, (unsigned long) nExpected);
+
+		NRF_LOG_RAW_INFO("%s: %lu of %lu edges within a hop, largest error %lu ms\n", pClip->Name,
+			(unsigned long) nMatched, (unsigned long) nExpected, (unsigned long) MaxErrorMs);
+	}
+
+	ping_corpus_free(&Corpus);
+#else
+	NRF_LOG_RAW_INFO("edge detector left out, PING_FLUX_ENABLED is 0\n");
+#endif
+
+	return nTestFailures;
+}
+
+#if PING_SIREN_ENABLED
+
+// ping_host_stream() handler of the sirens check
+static void TestSirensFrame(uint32_t nFrame, uint32_t TimeMs, const ping_host_result_t *pResult, void *pContext)
+{
+	test_sweeps_t *pSweeps = pContext;
+
+	if((pResult->SirenEvent == PING_SIREN_EVT_SWEEP) && (pSweeps->nSweeps < TEST_MAX_SWEEPS))
+	{
+		pSweeps->Sweep[pSweeps->nSweeps++] = pResult->Sweep;
+	}
+}
+
+#endif // PING_SIREN_ENABLED
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestSirens() function is the sirens check, see the top of the file.  The nominal
+// sweeps alternate from the onset of the clip, a rise first, as the corpus lays them out;
+// each is matched by the unused sweep whose middle is nearest its own, as ping_bench does.
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestSirens(void)
+{
+#if PING_SIREN_ENABLED
+	static test_sweeps_t Sweeps;
+	bool Used[TEST_MAX_SWEEPS];
+	char cName[PING_CORPUS_MAX_NAME];
+	ping_corpus_t Sirens;
+	const ping_corpus_clip_t *pClip;
+	const ping_corpus_siren_t *pSiren;
+	const ping_siren_sweep_t *pSweep;
+	uint32_t nSiren, nIdx, nBest, nExpected, nMatched;
+	uint32_t SweepMs, LengthMs, EndMs, MiddleMs, ErrorMs, BestMs;
+	float fRate, fNominal, fError, fMaxError;
+	bool bRise;
+
+	memset(&Sirens, 0, sizeof(Sirens));
+
+	if(!ping_corpus_sirens(&Sirens))
+	{
+		NRF_LOG_RAW_INFO("FAIL: out of memory\n");
+		return 1;
+	}
+
+	for(nSiren=0; nSiren < PING_CORPUS_NUM_SIRENS; nSiren++)
+	{
+		pSiren = &PingCorpusSiren[nSiren];
+		snprintf(cName, sizeof(cName), "%s_snr%s", pSiren->pName, TEST_SIREN_SNR);
+
+		pClip = TestCorpusClip(&Sirens, cName);
+		TestAssert(pClip != NULL, "no clip %s", cName);
+
+		if(pClip == NULL)
+		{
+			continue;
+		}
+
+		memset(&Sweeps, 0, sizeof(Sweeps));
+		memset(Used, 0, sizeof(Used));
+		ping_host_open(PING_DETECTOR_GOERTZEL, PING_FFT_DEFAULT_SIZE);
+		ping_host_stream(&pClip->Wav, TestSirensFrame, &Sweeps);
+
+		EndMs = (uint32_t) ((uint64_t) pClip->Wav.nSamples * 1000 / PING_SAMPLE_RATE_HZ);
+		SweepMs = pClip->OnsetMs;
+		bRise = true;
+		nExpected = 0;
+		nMatched = 0;
+		fMaxError = 0.0f;
+
+		while(SweepMs + (LengthMs = bRise ? pSiren->RiseMs : pSiren->FallMs) + TEST_SIREN_MARGIN_MS <= EndMs)
+		{
+			nBest = TEST_MAX_SWEEPS;
+			BestMs = UINT32_MAX;
+
+			for(nIdx=0; nIdx < Sweeps.nSweeps; nIdx++)
+			{
+				pSweep = &Sweeps.Sweep[nIdx];
+				MiddleMs = pSweep->StartMs + pSweep->DurationMs / 2;
+
+				if(Used[nIdx] || (pSweep->Class != pSiren->Class) || ((pSweep->fRateHzS > 0.0f) != bRise) ||
+					(MiddleMs < SweepMs) || (MiddleMs > SweepMs + LengthMs))
+				{
+					continue;
+				}
+
+				ErrorMs = (2 * MiddleMs > 2 * SweepMs + LengthMs) ? 2 * MiddleMs - (2 * SweepMs + LengthMs) : (2 * SweepMs + LengthMs) - 2 * MiddleMs;
+
+				if(ErrorMs < BestMs)
+				{
+					BestMs = ErrorMs;
+					nBest = nIdx;
+				}
+			}
+
+			nExpected++;
+			TestAssert(nBest < TEST_MAX_SWEEPS, "%s: no %s %s from %lu ms", pClip->Name, PingSirenClassName[pSiren->Class],
+				bRise ? "rise" : "fall", (unsigned long) SweepMs);
+
+			if(nBest < TEST_MAX_SWEEPS)
+			{
+				Used[nBest] = true;
+				pSweep = &Sweeps.Sweep[nBest];
+				nMatched++;
+
+				TestAssert(pSweep->Shape == pSiren->Shape, "%s: sweep from %lu ms is %s", pClip->Name, (unsigned long) SweepMs,
+					(pSweep->Shape == PING_SIREN_SHAPE_LINEAR) ? "linear" : "exponential");
+
+				if(pSiren->Shape == PING_SIREN_SHAPE_LINEAR)
+				{
+					fRate = fabsf(pSweep->fRateHzS);
+					fNominal = (pSiren->fHiHz - pSiren->fLoHz) * 1000.0f / LengthMs;
+				}
+				else
+				{
+					fRate = fabsf(pSweep->fRateOctS);
+					fNominal = log2f(pSiren->fHiHz / pSiren->fLoHz) * 1000.0f / LengthMs;
+				}
+
+				fError = fabsf(fRate - fNominal) / fNominal;
+				fMaxError = MAX(fMaxError, fError);
+				TestAssert(fError <= TEST_SIREN_RATE, "%s: sweep from %lu ms at %.3f, nominal %.3f", pClip->Name, (unsigned long) SweepMs,
+					fRate, fNominal);
+			}
+
+			SweepMs += LengthMs;
+			bRise = !bRise;
+		}
+
+		NRF_LOG_RAW_INFO("%s: %lu of %lu sweeps matched, %lu sweeps in all, largest rate error %.1f%%\n", pClip->Name,
+			(unsigned long) nMatched, (unsigned long) nExpected, (unsigned long) Sweeps.nSweeps, fMaxError * 100.0f);
+	}
+
+	ping_corpus_free(&Sirens);
+#else
+	NRF_LOG_RAW_INFO("siren tracker left out, PING_SIREN_ENABLED is 0\n");
+#endif
+
+	return nTestFailures;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestNn() function is the nn check, see the top of the file.
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestNn(void)
+{
+#if PING_NN_ENABLED
+	uint32_t Hash;
+
+	Hash = ping_nn_selftest();
+	TestAssert(Hash == PingNnSelfTestExpected, "self test 0x%08lx, ping_nn_weights.c expects 0x%08lx",
+		(unsigned long) Hash, (unsigned long) PingNnSelfTestExpected);
+
+	NRF_LOG_RAW_INFO("self test 0x%08lx, expected 0x%08lx\n", (unsigned long) Hash, (unsigned long) PingNnSelfTestExpected);
+#else
+	NRF_LOG_RAW_INFO("classifier left out, PING_NN_ENABLED is 0\n");
+#endif
+
+	return nTestFailures;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestCfarNoise() function makes the magnitude spectrum of broadband noise: Rayleigh
+// distributed bins with a mean of 1.
+//
+// Parameter(s):
+//
+//	pMagnitude	receives TEST_CFAR_BINS bins
+//	pRandom		state of the generator
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void TestCfarNoise(float *pMagnitude, uint32_t *pRandom)
+{
+	uint32_t nIdx;
+	float fUniform;
+
+	for(nIdx=0; nIdx < TEST_CFAR_BINS; nIdx++)
+	{
+		*pRandom = *pRandom * 1664525u + 1013904223u;
+		fUniform = (float) ((*pRandom >> 8) + 1) / (1u << 24);		// 0 excluded
+		pMagnitude[nIdx] = sqrtf(-4.0f / (float) M_PI * logf(fUniform));
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestCfar() function is the cfar check, see the top of the file.  A noise bin passes
+// the default 12 dB with a chance of about 4e-6, over all the spectra of the check less
+// than 1 in 5; the generator is seeded, so the outcome is the same on every run.
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestCfar(void)
+{
+	float Magnitude[TEST_CFAR_BINS];
+	float fThreshold;
+	uint32_t nSpectrum, nPeaks, Peak;
+	uint32_t Random = 1;
+	uint32_t SampleTime = 0;
+
+	ping_cfar_init();
+
+	fThreshold = powf(10.0f, PING_CFAR_THRESHOLD_DB / 20.0f);
+	TestAssert(fabsf(PingCfarThreshold - fThreshold) <= 1e-5f * fThreshold, "threshold %.4f, PING_CFAR_THRESHOLD_DB gives %.4f",
+		PingCfarThreshold, fThreshold);
+
+	// Noise alone, the first spectrum seeds the floor
+
+	nPeaks = 0;
+
+	for(nSpectrum=0; nSpectrum < TEST_CFAR_SPECTRA; nSpectrum++)
+	{
+		TestCfarNoise(Magnitude, &Random);
+		SampleTime += PING_FFT_DEFAULT_SIZE;
+
+		if(ping_cfar_update(Magnitude, TEST_CFAR_BINS, SampleTime) != PING_NO_DOMINANT_BIN)
+			nPeaks++;
+	}
+
+	TestAssert(nPeaks == 0, "noise gave a dominant bin in %lu of %d spectra", (unsigned long) nPeaks, TEST_CFAR_SPECTRA);
+
+	NRF_LOG_RAW_INFO("noise: %d spectra of %d bins, %lu with a dominant bin, floor %.3f at bin %d\n", TEST_CFAR_SPECTRA, TEST_CFAR_BINS,
+		(unsigned long) nPeaks, PingCfarFloor[TEST_CFAR_TONE_BIN], TEST_CFAR_TONE_BIN);
+
+	// A tone over the threshold
+
+	TestCfarNoise(Magnitude, &Random);
+	Magnitude[TEST_CFAR_TONE_BIN] = TEST_CFAR_MARGIN * PingCfarThreshold * PingCfarFloor[TEST_CFAR_TONE_BIN];
+	SampleTime += PING_FFT_DEFAULT_SIZE;
+	Peak = ping_cfar_update(Magnitude, TEST_CFAR_BINS, SampleTime);
+	TestAssert(Peak == TEST_CFAR_TONE_BIN, "tone over the threshold at bin %d gave %ld", TEST_CFAR_TONE_BIN, (long) Peak);
+
+	// Under it
+
+	TestCfarNoise(Magnitude, &Random);
+	Magnitude[TEST_CFAR_TONE_BIN] = PingCfarThreshold * PingCfarFloor[TEST_CFAR_TONE_BIN] / TEST_CFAR_MARGIN;
+	SampleTime += PING_FFT_DEFAULT_SIZE;
+	Peak = ping_cfar_update(Magnitude, TEST_CFAR_BINS, SampleTime);
+	TestAssert(Peak == PING_NO_DOMINANT_BIN, "tone under the threshold at bin %d gave %ld", TEST_CFAR_TONE_BIN, (long) Peak);
+
+	// Two tones over the threshold, the stronger is the peak
+
+	TestCfarNoise(Magnitude, &Random);
+	Magnitude[TEST_CFAR_TONE_BIN] = TEST_CFAR_MARGIN * PingCfarThreshold * PingCfarFloor[TEST_CFAR_TONE_BIN];
+	Magnitude[2 * TEST_CFAR_TONE_BIN] = 2.0f * TEST_CFAR_MARGIN * PingCfarThreshold * PingCfarFloor[2 * TEST_CFAR_TONE_BIN];
+	SampleTime += PING_FFT_DEFAULT_SIZE;
+	Peak = ping_cfar_update(Magnitude, TEST_CFAR_BINS, SampleTime);
+	TestAssert(Peak == 2 * TEST_CFAR_TONE_BIN, "tones at bins %d and %d gave %ld", TEST_CFAR_TONE_BIN, 2 * TEST_CFAR_TONE_BIN, (long) Peak);
+
+	return nTestFailures;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestTemporalInterval() function feeds the decoder one decision per step until an
+// interval is over.
+//
+// Parameter(s):
+//
+//	pDecoder		decoder state
+//	bTone		decision for the whole interval
+//	EndMs		end of the interval, from the onset of the first pulse
+//	pResult		the time so far, receives the events
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void TestTemporalInterval(ping_temporal_t *pDecoder, bool bTone, uint32_t EndMs, test_temporal_t *pResult)
+{
+	uint8_t Event;
+
+	for(; pResult->TimeMs < EndMs; pResult->TimeMs += TEST_TEMPORAL_STEP_MS)
+	{
+		// The decoder takes wrapping timestamps, start it well away from zero
+
+		Event = ping_temporal_update(pDecoder, bTone, pResult->TimeMs - TEST_TEMPORAL_LEAD_MS);
+
+		if(Event == PING_TEMPORAL_EVT_CONFIRMED)
+		{
+			if(pResult->nConfirmed++ == 0)
+				pResult->ConfirmedMs = pResult->TimeMs - TEST_TEMPORAL_LEAD_MS;
+		}
+		else if(Event == PING_TEMPORAL_EVT_ENDED)
+		{
+			if(pResult->nEnded++ == 0)
+				pResult->EndedMs = pResult->TimeMs - TEST_TEMPORAL_LEAD_MS;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestTemporalRun() function runs TEST_TEMPORAL_GROUPS groups of a cadence through a
+// new decoder, with TEST_TEMPORAL_LEAD_MS of silence before them and a pause, ToleranceMs
+// and TEST_TEMPORAL_LEAD_MS of silence after them.
+//
+// Parameter(s):
+//
+//	pConfig		pattern of the decoder
+//	pCadence		deviations from the pattern
+//	pResult		receives the events
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void TestTemporalRun(const ping_temporal_config_t *pConfig, const test_cadence_t *pCadence, test_temporal_t *pResult)
+{
+	ping_temporal_t Decoder;
+	uint32_t EndMs, nGroup, nPulse;
+
+	memset(pResult, 0, sizeof(*pResult));
+	pResult->ConfirmedMs = TEST_TEMPORAL_NONE;
+	pResult->EndedMs = TEST_TEMPORAL_NONE;
+	ping_temporal_init(&Decoder, pConfig);
+
+	EndMs = TEST_TEMPORAL_LEAD_MS;
+	TestTemporalInterval(&Decoder, false, EndMs, pResult);
+
+	for(nGroup=0; nGroup < TEST_TEMPORAL_GROUPS; nGroup++)
+	{
+		for(nPulse=0; nPulse < pConfig->PulsesPerGroup; nPulse++)
+		{
+			EndMs += pConfig->PulseMs + pCadence->PulseMs;
+			TestTemporalInterval(&Decoder, (nGroup != pCadence->nMissGroup) || (nPulse != pCadence->nMissPulse), EndMs, pResult);
+
+			if(nPulse < (pConfig->PulsesPerGroup - 1))
+				EndMs += pConfig->GapMs + pCadence->GapMs;
+			else
+				EndMs += pConfig->PauseMs + pCadence->PauseMs;
+
+			TestTemporalInterval(&Decoder, false, EndMs, pResult);
+		}
+	}
+
+	pResult->LastPulseEndMs = EndMs - (pConfig->PauseMs + pCadence->PauseMs) - TEST_TEMPORAL_LEAD_MS;
+	EndMs += pConfig->ToleranceMs + TEST_TEMPORAL_LEAD_MS;
+	TestTemporalInterval(&Decoder, false, EndMs, pResult);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The TestTemporal() function is the temporal check, see the top of the file.  Edges are
+// seen on the first step after them, so an event is due up to a step late and an interval
+// is measured up to a step off; the tolerance cases keep a step clear of ToleranceMs.
+//
+// Returns the number of failed assertions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static int TestTemporal(void)
+{
+	static const struct
+	{
+		const char *pName;
+		const ping_temporal_config_t *pConfig;
+	} Pattern[] =
+	{
+		{ "T-3", &PingT3Config },
+		{ "T-4", &PingT4Config },
+	};
+	const ping_temporal_config_t *pConfig;
+	test_cadence_t Cadence;
+	test_temporal_t Result;
+	uint32_t nPattern, nInterval, nSign, GroupMs, ConfirmMs, DueMs;
+	int32_t *pDeviation[3];
+	int32_t Within, Beyond;
+	static const char * const IntervalName[] = { "pulses", "gaps", "pauses" };
+
+	for(nPattern=0; nPattern < (sizeof(Pattern) / sizeof(Pattern[0])); nPattern++)
+	{
+		pConfig = Pattern[nPattern].pConfig;
+		GroupMs = pConfig->PulsesPerGroup * pConfig->PulseMs + (pConfig->PulsesPerGroup - 1) * pConfig->GapMs + pConfig->PauseMs;
+		ConfirmMs = pConfig->GroupsToConfirm * GroupMs - pConfig->PauseMs;
+
+		// Nominal cadence
+
+		memset(&Cadence, 0, sizeof(Cadence));
+		Cadence.nMissGroup = TEST_TEMPORAL_NONE;
+		TestTemporalRun(pConfig, &Cadence, &Result);
+
+		TestAssert(Result.nConfirmed == 1, "%s: nominal cadence confirmed %lu times", Pattern[nPattern].pName, (unsigned long) Result.nConfirmed);
+		TestAssert((Result.ConfirmedMs >= ConfirmMs) && (Result.ConfirmedMs < (ConfirmMs + TEST_TEMPORAL_STEP_MS)),
+			"%s: nominal cadence confirmed at %ld ms, due at %lu ms", Pattern[nPattern].pName, (long) Result.ConfirmedMs, (unsigned long) ConfirmMs);
+
+		DueMs = Result.LastPulseEndMs + pConfig->PauseMs + pConfig->ToleranceMs;
+		TestAssert(Result.nEnded == 1, "%s: nominal cadence ended %lu times", Pattern[nPattern].pName, (unsigned long) Result.nEnded);
+		TestAssert((Result.EndedMs >= DueMs) && (Result.EndedMs <= (DueMs + 2 * TEST_TEMPORAL_STEP_MS)),
+			"%s: nominal cadence ended at %ld ms, due at %lu ms", Pattern[nPattern].pName, (long) Result.EndedMs, (unsigned long) DueMs);
+
+		NRF_LOG_RAW_INFO("%s: confirmed at %lu ms, ended at %lu ms\n", Pattern[nPattern].pName,
+			(unsigned long) Result.ConfirmedMs, (unsigned long) Result.EndedMs);
+
+		// Every interval of one kind longer or shorter, within and beyond the tolerance
+
+		pDeviation[0] = &Cadence.PulseMs;
+		pDeviation[1] = &Cadence.GapMs;
+		pDeviation[2] = &Cadence.PauseMs;
+		Within = pConfig->ToleranceMs - TEST_TEMPORAL_STEP_MS;
+		Beyond = pConfig->ToleranceMs + 2 * TEST_TEMPORAL_STEP_MS;
+
+		for(nInterval=0; nInterval < 3; nInterval++)
+		{
+			for(nSign=0; nSign < 2; nSign++)
+			{
+				memset(&Cadence, 0, sizeof(Cadence));
+				Cadence.nMissGroup = TEST_TEMPORAL_NONE;
+
+				*pDeviation[nInterval] = nSign ? -Within : Within;
+				TestTemporalRun(pConfig, &Cadence, &Result);
+				TestAssert(Result.nConfirmed == 1, "%s: %s off by %ld ms confirmed %lu times",
+					Pattern[nPattern].pName, IntervalName[nInterval], (long) *pDeviation[nInterval], (unsigned long) Result.nConfirmed);
+
+				*pDeviation[nInterval] = nSign ? -Beyond : Beyond;
+				TestTemporalRun(pConfig, &Cadence, &Result);
+				TestAssert(Result.nConfirmed == 0, "%s: %s off by %ld ms confirmed %lu times",
+					Pattern[nPattern].pName, IntervalName[nInterval], (long) *pDeviation[nInterval], (unsigned long) Result.nConfirmed);
+			}
+		}
+
+		// A pulse missed in the last group before confirmation: the groups counted so far and
+		// the rest of the one it is in are lost, so confirmation comes GroupsToConfirm groups later
+
+		memset(&Cadence, 0, sizeof(Cadence));
+		Cadence.nMissGroup = pConfig->GroupsToConfirm - 1;
+		Cadence.nMissPulse = 1;
+		TestTemporalRun(pConfig, &Cadence, &Result);
+
+		DueMs = ConfirmMs + pConfig->GroupsToConfirm * GroupMs;
+		TestAssert((Result.ConfirmedMs >= DueMs) && (Result.ConfirmedMs < (DueMs + TEST_TEMPORAL_STEP_MS)),
+			"%s: missed pulse confirmed at %ld ms, due at %lu ms", Pattern[nPattern].pName, (long) Result.ConfirmedMs, (unsigned long) DueMs);
+	}
+
+	return nTestFailures;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Checks, by subcommand name                                                                                                                //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static const test_check_t TestCheck[] =
+{
+	{ "replay", TestReplay },
+	{ "goertzel", TestGoertzel },
+	{ "fixed", TestFixed },
+	{ "harmonic", TestHarmonic },
+	{ "edges", TestEdges },
+	{ "sirens", TestSirens },
+	{ "nn", TestNn },
+	{ "cfar", TestCfar },
+	{ "temporal", TestTemporal },
+};
+
+#define TEST_NUM_CHECKS		(sizeof(TestCheck) / sizeof(TestCheck[0]))
+
+int main(int argc, char *argv[])
+{
+	uint32_t nIdx;
+
+	for(nIdx=0; (argc == 2) && (nIdx < TEST_NUM_CHECKS); nIdx++)
+	{
+		if(strcmp(argv[1], TestCheck[nIdx].pName) == 0)
+		{
+			ping_profile_init();
+
+			return (TestCheck[nIdx].Run() == 0) ? 0 : 1;
+		}
+	}
+
+	NRF_LOG_RAW_INFO("usage: %s check, one of:", argv[0]);
+
+	for(nIdx=0; nIdx < TEST_NUM_CHECKS; nIdx++)
+	{
+		NRF_LOG_RAW_INFO(" %s", TestCheck[nIdx].pName);
+	}
+
+	NRF_LOG_RAW_INFO("\n");
+
+	return 2;
+}
@@ -0,0 +1,235 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_wav.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	WAV file reader for the host tools
+//
+//	Reads 16-bit PCM files, mono or stereo, at any sample rate.  Extra channels are ignored.
+//	Files not recorded at PING_SAMPLE_RATE_HZ are brought to it by linear interpolation,
+//	which is plenty for a tone detector but adds some aliasing above a few kHz when the file
+//	rate is close to ours.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nrf_log.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+
+#include "ping_wav.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#define WAV_FORMAT_PCM				0x0001
+#define WAV_FORMAT_EXTENSIBLE		0xFFFE
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint16_t ReadLe16(const uint8_t *pData)
+{
+	return (uint16_t) (pData[0] | (pData[1] << 8));
+}
+
+static uint32_t ReadLe32(const uint8_t *pData)
+{
+	return (uint32_t) pData[0] | ((uint32_t) pData[1] << 8) | ((uint32_t) pData[2] << 16) | ((uint32_t) pData[3] << 24);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The Resample() function converts one channel to PING_SAMPLE_RATE_HZ.
+//
+// Parameter(s):
+//
+//	pSrc			interleaved little endian file samples, first sample of the channel
+//	nStride		bytes between two frames of pSrc
+//	nSrcSamples	frames in pSrc
+//	SrcRateHz		rate of pSrc
+//	pDst			output, nDstSamples long
+//	nDstSamples	frames to produce
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void Resample(const uint8_t *pSrc, uint32_t nStride, uint32_t nSrcSamples, uint32_t SrcRateHz, int16_t *pDst, uint32_t nDstSamples)
+{
+	uint32_t nIdx, nPos;
+	double fPos, fFrac, fValue;
+
+	for(nIdx=0; nIdx < nDstSamples; nIdx++)
+	{
+		fPos = (double) nIdx * SrcRateHz / PING_SAMPLE_RATE_HZ;
+		nPos = (uint32_t) fPos;
+		fFrac = fPos - nPos;
+
+		if(nPos + 1 >= nSrcSamples)
+		{
+			pDst[nIdx] = (int16_t) ReadLe16(&pSrc[(nSrcSamples - 1) * nStride]);
+			continue;
+		}
+
+		fValue = (1.0 - fFrac) * (int16_t) ReadLe16(&pSrc[nPos * nStride]) + fFrac * (int16_t) ReadLe16(&pSrc[(nPos + 1) * nStride]);
+		pDst[nIdx] = (int16_t) (fValue < 0 ? fValue - 0.5 : fValue + 0.5);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_wav_load() function reads a WAV file into memory.  Free the result with
+// ping_wav_free().
+//
+// Parameter(s):
+//
+//	pPath		file to read
+//	pWav			receives the samples
+//
+// Returns false, with a message on the log, if the file cannot be used
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_wav_load(const char *pPath, ping_wav_t *pWav)
+{
+	FILE *pFile;
+	uint8_t *pData = NULL;
+	const uint8_t *pFmt = NULL, *pSamples = NULL;
+	long nFileSize;
+	uint32_t nPos, nChunkSize, nSampleBytes = 0;
+	uint16_t Format, nChannels, nBits;
+	uint32_t nFrames;
+
+	memset(pWav, 0, sizeof(*pWav));
+
+	pFile = fopen(pPath, "rb");
+
+	if(pFile == NULL)
+	{
+		NRF_LOG_RAW_INFO("%s: cannot open\n", pPath);
+		return false;
+	}
+
+	fseek(pFile, 0, SEEK_END);
+	nFileSize = ftell(pFile);
+	fseek(pFile, 0, SEEK_SET);
+
+	if(nFileSize >= 12)
+	{
+		pData = malloc(nFileSize);
+	}
+
+	if((pData == NULL) || (fread(pData, 1, nFileSize, pFile) != (size_t) nFileSize))
+	{
+		NRF_LOG_RAW_INFO("%s: cannot read\n", pPath);
+		fclose(pFile);
+		free(pData);
+		return false;
+	}
+
+	fclose(pFile);
+
+	if((memcmp(pData, "RIFF", 4) != 0) || (memcmp(&pData[8], "WAVE", 4) != 0))
+	{
+		NRF_LOG_RAW_INFO("%s: not a WAV file\n", pPath);
+		free(pData);
+		return false;
+	}
+
+	// Walk the chunks, they are padded to an even size
+	for(nPos = 12; nPos + 8 <= (uint32_t) nFileSize; nPos += 8 + nChunkSize + (nChunkSize & 1))
+	{
+		nChunkSize = ReadLe32(&pData[nPos + 4]);
+
+		if(nChunkSize > (uint32_t) nFileSize - nPos - 8)
+		{
+			// Truncated recording, keep what is there
+			nChunkSize = (uint32_t) nFileSize - nPos - 8;
+		}
+
+		if((memcmp(&pData[nPos], "fmt ", 4) == 0) && (nChunkSize >= 16))
+		{
+			pFmt = &pData[nPos + 8];
+		}
+		else if(memcmp(&pData[nPos], "data", 4) == 0)
+		{
+			pSamples = &pData[nPos + 8];
+			nSampleBytes = nChunkSize;
+		}
+	}
+
+	if((pFmt == NULL) || (pSamples == NULL))
+	{
+		NRF_LOG_RAW_INFO("%s: no fmt or data chunk\n", pPath);
+		free(pData);
+		return false;
+	}
+
+	Format = ReadLe16(&pFmt[0]);
+	nChannels = ReadLe16(&pFmt[2]);
+	pWav->FileRateHz = ReadLe32(&pFmt[4]);
+	nBits = ReadLe16(&pFmt[14]);
+
+	if(Format == WAV_FORMAT_EXTENSIBLE)
+	{
+		// The sub-format GUID starts with the plain format tag
+		Format = ReadLe16(&pFmt[24]);
+	}
+
+	if((Format != WAV_FORMAT_PCM) || (nBits != 16) || (nChannels == 0) || (pWav->FileRateHz == 0))
+	{
+		NRF_LOG_RAW_INFO("%s: only 16-bit PCM is supported\n", pPath);
+		free(pData);
+		return false;
+	}
+
+	nFrames = nSampleBytes / (2 * nChannels);
+
+	if(nFrames == 0)
+	{
+		NRF_LOG_RAW_INFO("%s: no samples\n", pPath);
+		free(pData);
+		return false;
+	}
+
+	pWav->nSamples = (uint32_t) ((uint64_t) nFrames * PING_SAMPLE_RATE_HZ / pWav->FileRateHz);
+	pWav->pLeft = malloc(pWav->nSamples * sizeof(int16_t));
+	pWav->pRight = malloc(pWav->nSamples * sizeof(int16_t));
+
+	if((pWav->pLeft == NULL) || (pWav->pRight == NULL))
+	{
+		NRF_LOG_RAW_INFO("%s: out of memory\n", pPath);
+		free(pData);
+		ping_wav_free(pWav);
+		return false;
+	}
+
+	Resample(pSamples, 2 * nChannels, nFrames, pWav->FileRateHz, pWav->pLeft, pWav->nSamples);
+	Resample(pSamples + (nChannels > 1 ? 2 : 0), 2 * nChannels, nFrames, pWav->FileRateHz, pWav->pRight, pWav->nSamples);
+
+	free(pData);
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_wav_free() function releases what ping_wav_load() allocated.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_wav_free(ping_wav_t *pWav)
+{
+	free(pWav->pLeft);
+	free(pWav->pRight);
+	memset(pWav, 0, sizeof(*pWav));
+}
@@ -0,0 +1,36 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_wav.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_wav.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_WAV_H
+#define PING_WAV_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Audio loaded from a WAV file, both channels at PING_SAMPLE_RATE_HZ.  A mono file has the
+// same samples in both.
+
+typedef struct
+{
+	int16_t *pLeft;
+	int16_t *pRight;
+	uint32_t nSamples;
+	uint32_t FileRateHz;		// rate of the file before resampling
+} ping_wav_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern bool ping_wav_load(const char *pPath, ping_wav_t *pWav);
+extern void ping_wav_free(ping_wav_t *pWav);
+
+#endif //  PING_WAV_H
@@ -14,6 +14,7 @@
 
 #include <ble.h>
 #include <ble_gap.h>
+#include <nrf_soc.h>
 
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
@@ -23,6 +24,15 @@
 #include "arm_math.h"
 
 #include "ping_config.h"
+#include "ping_fft.h"
+#include "ping_cfar.h"
+#include "ping_temporal.h"
+#include "ping_ring.h"
+#include "ping_profile.h"
+#include "ping_tables.h"
+#include "ping_nn.h"
+#include "ping_flux.h"
+#include "ping_siren.h"
 #include "timer.h"
 
 /************************************************************
@@ -33,15 +43,14 @@
 
 
 // Each I2S access/interrupt provides AUDIO_FRAME_NUM_SAMPLES of 32-bit stereo pairs
-// And, m_i2s_rx_buffer holds two input buffers for double buffering, so twice the size or I2S_BUFFER_SIZE_WORDS long, where "words" are 32-bit pairs
-// So, each vector is I2S_BUFFER_SIZE_WORDS * sizeof(uint32_t) bytes long
+// And, m_i2s_tx_buffer holds two output buffers for double buffering, so twice the size or I2S_BUFFER_SIZE_WORDS long, where "words" are 32-bit pairs
+// So, it is I2S_BUFFER_SIZE_WORDS * sizeof(uint32_t) bytes long
 // And each buffer contains AUDIO_FRAME_NUM_SAMPLES 32-bit pairs
+// The received frames land in the buffer pool of ping_ring.c, which the driver rotates through the DMA
 
 
 uint32_t  m_i2s_tx_buffer[I2S_BUFFER_SIZE_WORDS];
-uint32_t  m_i2s_rx_buffer[I2S_BUFFER_SIZE_WORDS];
 
-int16_t Rx_Buffer[FFT_SAMPLE_SIZE * 2];	// twice the number of stereo pairs
 
 static uint32_t sample_idx          = 0;
 
@@ -60,8 +69,9 @@ static bool i2s_sgtl5000_driver_evt_handler(drv_sgtl5000_evt_t * p_evt)
         case DRV_SGTL5000_EVT_I2S_RX_BUF_RECEIVED:
             {
                 //NRF_LOG_INFO("i2s_sgtl5000_driver_evt_handler RX BUF RECEIVED");
-                // TODO: Handle RX as desired - for this example, we dont use RX for anything
-                //uint16_t * p_buffer  = (uint16_t *) p_evt->param.rx_buf_received.p_data_received;
+
+                // The driver has already queued the block in the frame ring, wake up the analysis
+                PING_DSP_EGU_INSTANCE->TASKS_TRIGGER[PING_DSP_EGU_TASK_FRAME_READY] = 1;
             }
             break;
         case DRV_SGTL5000_EVT_I2S_TX_BUF_REQ:
@@ -129,6 +139,242 @@ void gpio_init(void)
     nrf_gpio_cfg_output(LED_3);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ProcessDetection() function acts on one detector decision.  The tone is present when
+// the interpolated peak lies in PING_ALARM_FREQ_LO_HZ..PING_ALARM_FREQ_HI_HZ.  LED_3 follows
+// the per-frame tone decision, LED_4 is lit while the T-3 decoder has a confirmed alarm.
+//
+// Parameter(s):
+//
+//	pPeak		peak left by ping_detect()
+//	TimeMs		end of the frame that completed the input, see StreamTimeMs()
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static ping_temporal_t T3Decoder;
+
+// Formatting buffer of the analysis interrupt.  cOutbuf is shared by any code that includes
+// ping_config.h, and the interrupt could preempt it half way through; NRF_LOG_PUSH() copies
+// the text, so this one is free again once the log call returns.
+static char cDspOutbuf[96];
+
+static void ProcessDetection(const ping_peak_t *pPeak, uint32_t TimeMs)
+{
+	bool bTone;
+
+	// No peak leaves fFrequency at 0, well outside the band
+	bTone = (pPeak->fFrequency >= PING_ALARM_FREQ_LO_HZ) && (pPeak->fFrequency <= PING_ALARM_FREQ_HI_HZ);
+
+	if(bTone)
+	{
+		nrf_gpio_pin_clear(LED_3);
+	}
+	else
+	{
+		nrf_gpio_pin_set(LED_3);
+	}
+
+	switch(ping_temporal_update(&T3Decoder, bTone, TimeMs))
+	{
+		case PING_TEMPORAL_EVT_CONFIRMED:
+			NRF_LOG_RAW_INFO("[%d] T-3 alarm confirmed\r\n", TimeMs);
+			nrf_gpio_pin_clear(LED_4);
+			break;
+
+		case PING_TEMPORAL_EVT_ENDED:
+			NRF_LOG_RAW_INFO("[%d] T-3 alarm ended\r\n", TimeMs);
+			nrf_gpio_pin_set(LED_4);
+			break;
+
+		default:
+			break;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The StreamTimeMs() function gives the end of the latest frame, counted in samples from
+// the end of the first frame kept, as the pulse edges and siren sweeps are.  Unlike the
+// time the frame is processed at, it does not move with the ring backlog or with the
+// interrupts that preempt the analysis.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static uint32_t StreamOriginMs = 0;		// end of the first frame kept
+static uint32_t StreamFrames = 0;			// frames since, dropped ones included
+
+static uint32_t StreamTimeMs(void)
+{
+	return StreamOriginMs + (uint32_t) ((uint64_t) StreamFrames * AUDIO_FRAME_NUM_SAMPLES * 1000 / PING_SAMPLE_RATE_HZ);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ProcessFrame() function runs the selected detector on one I2S frame.  Frames arrive
+// in order; those the ring dropped before this one are only counted.
+//
+// Parameter(s):
+//
+//	pFrame		frame from the ring, one 32-bit stereo word per sample
+//	nSamples		number of stereo words in the frame
+//	nDropped		frames the ring dropped right before this one, ping_ring_dropped()
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ProcessFrame(const uint32_t *pFrame, uint32_t nSamples, uint32_t nDropped)
+{
+	static bool bStreamStarted = false;
+	bool bInputReady;
+	uint32_t nIdx;
+	float fBinSize;
+	uint32_t Dominant_Index;
+#if PING_FLUX_ENABLED
+	uint8_t Edge;
+#endif
+#if PING_SIREN_ENABLED
+	uint8_t Sweep;
+#endif
+
+	if(ElapsedTimeInMilliseconds() <= 1000)
+	{
+		// Let the codec settle, the frames are simply discarded
+		return;
+	}
+
+	// Pulse edges and siren sweeps come from every frame, whatever the detector, unless left
+	// out in ping_config.h.  Their times, like those of the T-3 decoder, count samples from
+	// the first frame kept, which ended about now.
+	if(!bStreamStarted)
+	{
+		StreamOriginMs = ElapsedTimeInMilliseconds();
+		StreamFrames = 0;
+#if PING_FLUX_ENABLED
+		ping_flux_reset(StreamOriginMs - (uint32_t) PING_FLUX_HOP_MS);
+#endif
+#if PING_SIREN_ENABLED
+		ping_siren_reset(StreamOriginMs - (uint32_t) PING_SIREN_HOP_MS);
+#endif
+		bStreamStarted = true;
+	}
+	else
+	{
+		// This frame and those an overrun lost before it; pushed empty, the lost ones keep
+		// the hop counts on the audio
+		StreamFrames += nDropped + 1;
+
+		for(nIdx=0; nIdx < nDropped; nIdx++)
+		{
+#if PING_FLUX_ENABLED
+			ping_flux_push(NULL, 0);
+#endif
+#if PING_SIREN_ENABLED
+			ping_siren_push(NULL, 0);
+#endif
+		}
+	}
+
+#if PING_FLUX_ENABLED
+	PING_PROFILE_BEGIN(PING_PROFILE_FLUX);
+	Edge = ping_flux_push(pFrame, nSamples);
+	PING_PROFILE_END(PING_PROFILE_FLUX);
+
+	if(Edge != PING_FLUX_EDGE_NONE)
+	{
+		NRF_LOG_RAW_INFO("[%d] Pulse %s\r\n", PingFluxEdge.TimeMs, (uint32_t) ((Edge == PING_FLUX_EDGE_ONSET) ? "onset" : "offset"));
+	}
+#endif
+
+#if PING_SIREN_ENABLED
+	PING_PROFILE_BEGIN(PING_PROFILE_SIREN);
+	Sweep = ping_siren_push(pFrame, nSamples);
+	PING_PROFILE_END(PING_PROFILE_SIREN);
+
+	if(Sweep == PING_SIREN_EVT_SWEEP)
+	{
+		snprintf(cDspOutbuf, sizeof(cDspOutbuf), "[%d] Siren %s %s, %.0f to %.0f Hz in %d ms\r\n", PingSirenSweep.StartMs,
+			PingSirenClassName[PingSirenSweep.Class], (PingSirenSweep.Shape == PING_SIREN_SHAPE_LINEAR) ? "linear" : "exponential",
+			PingSirenSweep.fStartHz, PingSirenSweep.fEndHz, PingSirenSweep.DurationMs);
+		NRF_LOG_RAW_INFO("%s", NRF_LOG_PUSH(cDspOutbuf));
+	}
+#endif
+
+	fBinSize = PING_BIN_SIZE_HZ;
+
+	if(PingDetectorMode == PING_DETECTOR_SDFT)
+	{
+		// The sliding DFT follows the stream frame by frame and has a result after each one
+		PING_PROFILE_BEGIN(PING_PROFILE_CAPTURE);
+		ping_sdft_update((const int16_t *) pFrame, nSamples);
+		PING_PROFILE_END(PING_PROFILE_CAPTURE);
+
+		PING_PROFILE_BEGIN(PING_PROFILE_DETECT);
+		Dominant_Index = ping_detect(fBinSize);
+		PING_PROFILE_END(PING_PROFILE_DETECT);
+
+		ProcessDetection(&PingPeak, StreamTimeMs());
+		return;
+	}
+
+	// Deinterleave into the detector input, frame after frame until it is complete
+	PING_PROFILE_BEGIN(PING_PROFILE_CAPTURE);
+	bInputReady = ping_capture_push(pFrame, nSamples);
+	PING_PROFILE_END(PING_PROFILE_CAPTURE);
+
+	if(bInputReady)
+	{
+		PING_PROFILE_BEGIN(PING_PROFILE_DETECT);
+		Dominant_Index = ping_detect(fBinSize);
+		PING_PROFILE_END(PING_PROFILE_DETECT);
+
+		if((PingPeak.fFrequency >= PING_ALARM_FREQ_LO_HZ) && (PingPeak.fFrequency <= PING_ALARM_FREQ_HI_HZ))
+		{
+			snprintf(cDspOutbuf, sizeof(cDspOutbuf), "Dominant_Index = %d, %.1f Hz\r\n", Dominant_Index, PingPeak.fFrequency);
+			NRF_LOG_RAW_INFO("%s", NRF_LOG_PUSH(cDspOutbuf));
+		}
+
+		ProcessDetection(&PingPeak, StreamTimeMs());
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The PING_DSP_EGU_IRQHandler() software interrupt drains the frame ring.  It is triggered
+// for every frame the I2S driver hands over and runs at the lowest priority, so the I2S,
+// BLE and timer interrupts preempt the analysis.  Triggers that arrive while it runs are
+// merged into one more pass, which finds the new frames.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void PING_DSP_EGU_IRQHandler(void)
+{
+	const uint32_t *pFrame;
+	uint32_t nSamples;
+
+	PING_DSP_EGU_INSTANCE->EVENTS_TRIGGERED[PING_DSP_EGU_TASK_FRAME_READY] = 0;
+
+	// A merged trigger finds the ring already drained, ping_ring_peek() counts it
+	pFrame = ping_ring_peek(&nSamples);
+
+	while(pFrame != NULL)
+	{
+		// Detector changes asked for over BLE, never half way through a frame
+		ping_detector_apply();
+
+		PING_PROFILE_BEGIN(PING_PROFILE_FRAME);
+		ProcessFrame(pFrame, nSamples, ping_ring_dropped());
+		PING_PROFILE_END(PING_PROFILE_FRAME);
+		ping_ring_release();
+
+		if(ping_ring_count() == 0)
+		{
+			break;
+		}
+
+		pFrame = ping_ring_peek(&nSamples);
+	}
+}
+
 bool bEraseBonds = true;
 bool connectedToBondedDevice = false;
 
@@ -169,7 +415,7 @@ int main(void)
 
 	NRF_LOG_RAW_INFO("Random seed is %d-\r\n", nSeed);
 
-	Timer1_Init(TIMER1_REPEAT_RATE);
+	Rtc2_Init();
 
 	err_code = NRF_LOG_INIT(NULL);
 	APP_ERROR_CHECK(err_code);
@@ -198,7 +444,6 @@ int main(void)
 	// Enable audio
 	drv_sgtl5000_init_t sgtl_drv_params;
 	sgtl_drv_params.i2s_tx_buffer           = (void*)m_i2s_tx_buffer;
-	sgtl_drv_params.i2s_rx_buffer           = (void*)m_i2s_rx_buffer;
 	sgtl_drv_params.i2s_buffer_size_words   =  I2S_BUFFER_SIZE_WORDS; ; //I2S_BUFFER_SIZE_WORDS/2;
 	sgtl_drv_params.i2s_evt_handler         = i2s_sgtl5000_driver_evt_handler;
 	sgtl_drv_params.fs                      = DRV_SGTL5000_FS_31250HZ;
@@ -209,88 +454,58 @@ int main(void)
 #endif
 
 	NRF_LOG_RAW_INFO("AUDIO_FRAME_NUM_SAMPLES = %d\r\n", AUDIO_FRAME_NUM_SAMPLES);
-	NRF_LOG_RAW_INFO("size of  m_i2s_rx_buffer %d =  %d 32-bit samples\r\n", sizeof(m_i2s_rx_buffer) / sizeof(uint32_t), I2S_BUFFER_SIZE_WORDS);
-	NRF_LOG_RAW_INFO("i2s_initial_Rx_buffer addr1: %d, addr2: %d\r\n", m_i2s_rx_buffer, m_i2s_rx_buffer + I2S_BUFFER_SIZE_WORDS/2);
+	NRF_LOG_RAW_INFO("RX buffer pool %d x %d 32-bit samples\r\n", PING_RING_BUFFERS, AUDIO_FRAME_NUM_SAMPLES);
 
 	drv_sgtl5000_init(&sgtl_drv_params);
 	drv_sgtl5000_stop();
 	NRF_LOG_RAW_INFO("Audio initialization done.\r\n");
 
-	/* Demonstrate Mic loopback */
-	NRF_LOG_RAW_INFO("Loop in main and loopback MIC data.\r\n");
-	drv_sgtl5000_start_mic_listen();
+	ping_profile_init();
+	ping_cfar_init();
 
-	
+	// Goertzel, sliding DFT, harmonic, Welch and zoom set up for the default length, before the
+	// first frame
+	ping_fft_length_set(PING_FFT_DEFAULT_SIZE);
 
-	for (;;)
+#if PING_NN_ENABLED
 	{
-		uint32_t nIdx, nJdx, nKdx;
-		static bool bBeenHere = false;
-		float fBinSize;
-		uint32_t Dominant_Index;
-
-		if(ElapsedTimeInMilliseconds() > 1000)
-		{
-			// Signal that we want to capture
-			bCaptureRx = true;
-
-			//NRF_LOG_RAW_INFO("StartTime = %d\r\n", ElapsedTimeInMilliseconds());
-
-			// Wait for capture
-			while(bCaptureRx)   nrf_delay_ms(1);
-
-			//NRF_LOG_RAW_INFO("Copied RX in %d msec\r\n", RxTimeDelta);
-
-				
-			//NRF_LOG_RAW_INFO("[%d] Num_Mic_Samples = %d, Mono FFT Sample Size = %d\n\r",ElapsedTimeInMilliseconds(), Num_Mic_Samples, FFT_SAMPLE_SIZE);
-			fBinSize = ( 31250.0 /2 ) / (FFT_SAMPLE_SIZE /2 );
-
-			//sprintf(cOutbuf, "fBinSize = %f\n\r", fBinSize); 	NRF_LOG_RAW_INFO("%s", (uint32_t) cOutbuf);
-
-			// Convert stereo 16-bit samples to mono float samples, half as many
-			nJdx = 0;
-			nKdx = 0;
-
-			for(nIdx=0; nIdx < FFT_SAMPLE_SIZE * 2; nIdx += 2)
-			{
-				fFFTin[nKdx] = (float)  Rx_Buffer[nIdx];
-				nKdx++;
-
-				//NRF_LOG_RAW_INFO("%8d\r\n",Rx_Buffer[nIdx]);
-			}
+		uint32_t Begin = ping_profile_now();
 
-			//NRF_LOG_RAW_INFO("Doing FFT\r\n");
-
-			uint32_t BegTime, EndTime, DeltaTime;
-			uint32_t nIterations = 10;
+		// Reference run of the classifier before the analysis interrupt can preempt it: the
+		// hash must match what the weights generator worked out, the time is one inference
+		ping_nn_selftest();
+		NRF_LOG_RAW_INFO("NN self test 0x%08x%s, %d cycles\r\n", PingNnSelfTest,
+			(uint32_t) ((PingNnSelfTest == PingNnSelfTestExpected) ? "" : " MISMATCH"), ping_profile_now() - Begin);
+	}
+#endif
 
-			BegTime = ElapsedTimeInMilliseconds();
+	/* Demonstrate Mic loopback */
+	NRF_LOG_RAW_INFO("Loop in main and loopback MIC data.\r\n");
+	drv_sgtl5000_start_mic_listen();
 
-			Dominant_Index = ping_fft(fBinSize);
-			
-			EndTime = ElapsedTimeInMilliseconds();
-			
-			DeltaTime = EndTime - BegTime;
+	ping_temporal_init(&T3Decoder, &PingT3Config);
+	
 
-			if((Dominant_Index >= 51) && (Dominant_Index <= 53))
-			{
-                            NRF_LOG_RAW_INFO("Dominant_Index = %d\r\n", Dominant_Index);
-				nrf_gpio_pin_clear(LED_3);
-			}
-			else
-			{
-				nrf_gpio_pin_set(LED_3);
-			}
+	// Analysis runs in the frame-ready software interrupt, below the I2S interrupt
+	PING_DSP_EGU_INSTANCE->EVENTS_TRIGGERED[PING_DSP_EGU_TASK_FRAME_READY] = 0;
+	PING_DSP_EGU_INSTANCE->INTENSET = 1 << PING_DSP_EGU_TASK_FRAME_READY;
 
-                     //   NRF_LOG_RAW_INFO("BegTime = %d EndTime = %d\r\n", BegTime, EndTime);
-			//NRF_LOG_RAW_INFO("For %d Iterations, took %d msec\r\n", nIterations, DeltaTime);
+	NVIC_ClearPendingIRQ(PING_DSP_EGU_IRQn);
+	NVIC_SetPriority(PING_DSP_EGU_IRQn, PING_DSP_EGU_IRQPriority);
+	NVIC_EnableIRQ(PING_DSP_EGU_IRQn);
 
+	for (;;)
+	{
+#if PING_NN_ENABLED
+		// The classifier runs here, below every interrupt, on the input the analysis left
+		ping_nn_poll();
+#endif
 
-			bBeenHere = true;
+		// Nothing left to do here but the deferred log, sleep until the next event
+		if(NRF_LOG_PROCESS() == false)
+		{
+			(void) sd_app_evt_wait();
 		}
-
-		nrf_delay_ms(100);
-		NRF_LOG_FLUSH();
 	}
 	}
 
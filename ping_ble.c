@@ -13,6 +13,7 @@
 #include "app_config.h"
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "ble_ping.h"
@@ -55,6 +56,15 @@
 #include <nrf_delay.h>
 
 #include "ping_config.h"
+#include "ping_fft.h"
+#include "ping_ring.h"
+#include "ping_profile.h"
+#include "ping_cfar.h"
+#include "ping_tables.h"
+#include "ping_nn.h"
+#include "ping_flux.h"
+#include "ping_siren.h"
+#include "drv_sgtl5000.h"
 
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -252,7 +262,7 @@ int Ble_ping_send_data(uint8_t PingPacketType, uint8_t *BLEpacket, uint8_t BLEpa
 	{
 
 #if ENABLE_BLE_SEND_DATA_DEBUG
-		NRF_LOG_RAW_INFO("[%8d]Ble_ping_send_data:  PT=%02x, Len=%d, \r\n", global_msec_counter, PingPacketType, BLEpacketLen);
+		NRF_LOG_RAW_INFO("[%8d]Ble_ping_send_data:  PT=%02x, Len=%d, \r\n", ElapsedTimeInMilliseconds(), PingPacketType, BLEpacketLen);
 #endif
 
 		ping_ble_msg_len = (BLEpacketLen + 1);
@@ -262,7 +272,7 @@ int Ble_ping_send_data(uint8_t PingPacketType, uint8_t *BLEpacket, uint8_t BLEpa
 		{
 			if (nIdx > 3)
 				NRF_LOG_RAW_INFO("[%8d, %d]Ble_ping_send_data:  Insufficient resources, hvx_sent_count=%d, nIdx=%d\r\n", 
-					global_msec_counter, nIdx, hvx_sent_count, nIdx);
+					ElapsedTimeInMilliseconds(), nIdx, hvx_sent_count, nIdx);
 
 
 
@@ -647,6 +657,33 @@ void NewModeAnnouncement(uint16_t mode)
 }
 #endif // NOT_NEC
 
+//////////////////////////////////////////////////////////////////////////////
+//
+// The SendProfileLine() function sends one line of the profiling dump to the app, split
+// over as many packets as BLE_buffer needs, the last one ending in a newline.
+//
+// Parameter(s):
+//
+//	pLine		text of the line
+//	nLength		length of the text
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void SendProfileLine(char *pLine, uint32_t nLength)
+{
+	uint32_t nChunk;
+
+	pLine[nLength++] = '\n';
+
+	while (nLength > 0)
+	{
+		nChunk = MIN(nLength, sizeof(BLE_buffer) - 1);
+		Ble_ping_send_data(PING_PACKET_TYPE_PROFILE, (uint8_t *) pLine, (uint8_t) nChunk);
+		pLine += nChunk;
+		nLength -= nChunk;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //
 // The ble_ping_data_handler() function handles the data arriving over BLE on the Ping UART
@@ -942,6 +979,275 @@ static void ble_ping_data_handler(ble_ping_t *p_ping, uint8_t *p_data, uint16_t
 
 		bSendParameters = true;
 	}
+	else if ((length > 9) && (strncmp((char *)p_data, "Detector ", 9) == 0))
+	{
+		char cMode[4];
+		char *pEnd;
+		long nMode;
+
+		// "Detector <n>" selects one of the PING_DETECTOR_xxx modes in ping_fft.h.  Anything
+		// but a number, line ending aside, is rejected rather than taken as mode 0.
+		memset(cMode, 0, sizeof(cMode));
+		memcpy(cMode, &p_data[9], MIN(length - 9, sizeof(cMode) - 1));
+		nMode = strtol(cMode, &pEnd, 10);
+
+		while ((*pEnd == '\r') || (*pEnd == '\n'))
+		{
+			pEnd++;
+		}
+
+		if ((pEnd == cMode) || (*pEnd != '\0'))
+		{
+			NRF_LOG_RAW_INFO("** Invalid detector mode, not a number ***\r\n");
+		}
+		else if ((nMode >= 0) && (nMode < PING_DETECTOR_NUM_MODES) && ping_detector_request((uint8_t) nMode))
+		{
+			NRF_LOG_RAW_INFO("** Detector mode %d ***\r\n", nMode);
+		}
+		else
+		{
+			NRF_LOG_RAW_INFO("** Invalid detector mode %d ***\r\n", nMode);
+		}
+	}
+	else if ((length > 6) && (strncmp((char *)p_data, "Welch ", 6) == 0))
+	{
+		char cParams[12];
+		char *pNext;
+		long nFrames, nOverlap;
+
+		// "Welch <frames> <overlap percent>" tunes the averaged spectrum detector
+		memset(cParams, 0, sizeof(cParams));
+		memcpy(cParams, &p_data[6], MIN(length - 6, sizeof(cParams) - 1));
+		nFrames = strtol(cParams, &pNext, 10);
+		nOverlap = strtol(pNext, NULL, 10);
+
+		if ((nFrames > 0) && (nFrames <= UINT8_MAX) && (nOverlap >= 0) && (nOverlap <= PING_WELCH_MAX_OVERLAP_PERCENT) &&
+			ping_welch_request((uint8_t) nFrames, (uint8_t) nOverlap))
+		{
+			NRF_LOG_RAW_INFO("** Welch %d frames, %d%% overlap ***\r\n", nFrames, nOverlap);
+		}
+		else
+		{
+			NRF_LOG_RAW_INFO("** Invalid Welch parameters ***\r\n");
+		}
+	}
+	else if ((length > 10) && (strncmp((char *)p_data, "FftLength ", 10) == 0))
+	{
+		char cLength[6];
+		long nLength;
+
+		// "FftLength <n>" changes the analysis length, a power of two
+		memset(cLength, 0, sizeof(cLength));
+		memcpy(cLength, &p_data[10], MIN(length - 10, sizeof(cLength) - 1));
+		nLength = strtol(cLength, NULL, 10);
+
+		if ((nLength > 0) && ping_fft_length_request((uint32_t) nLength))
+		{
+			NRF_LOG_RAW_INFO("** FFT length %d ***\r\n", nLength);
+		}
+		else
+		{
+			NRF_LOG_RAW_INFO("** Invalid FFT length %d ***\r\n", nLength);
+		}
+	}
+	else if ((length > 5) && (strncmp((char *)p_data, "Zoom ", 5) == 0))
+	{
+		char cParams[12];
+		char *pNext;
+		long nCenter, nSpan;
+		uint32_t Decimation;
+
+		// "Zoom <center Hz> <span Hz>" moves the band analysed by the zoom FFT
+		memset(cParams, 0, sizeof(cParams));
+		memcpy(cParams, &p_data[5], MIN(length - 5, sizeof(cParams) - 1));
+		nCenter = strtol(cParams, &pNext, 10);
+		nSpan = strtol(pNext, NULL, 10);
+
+		Decimation = ping_zoom_request((float) nCenter, (float) nSpan);
+
+		if (Decimation > 0)
+		{
+			NRF_LOG_RAW_INFO("** Zoom %d Hz, span %d Hz, decimation %d ***\r\n", nCenter, nSpan, Decimation);
+		}
+		else
+		{
+			NRF_LOG_RAW_INFO("** Invalid zoom parameters ***\r\n");
+		}
+	}
+	else if ((length > 5) && (strncmp((char *)p_data, "Gate ", 5) == 0))
+	{
+		char cPeak[7];
+		long nPeak;
+
+		// "Gate <peak>" sets the energy gate of the block detectors, 0 turns it off
+		memset(cPeak, 0, sizeof(cPeak));
+		memcpy(cPeak, &p_data[5], MIN(length - 5, sizeof(cPeak) - 1));
+		nPeak = strtol(cPeak, NULL, 10);
+
+		if ((nPeak >= 0) && (nPeak <= INT16_MAX))
+		{
+			PingGatePeak = (uint16_t) nPeak;
+			NRF_LOG_RAW_INFO("** Gate peak %d ***\r\n", nPeak);
+		}
+		else
+		{
+			NRF_LOG_RAW_INFO("** Invalid gate peak %d ***\r\n", nPeak);
+		}
+	}
+	else if ((length >= 4) && (strncmp((char *)p_data, "Gate", 4) == 0))
+	{
+		// "Gate" reports how many inputs the energy gate spared the detector
+		NRF_LOG_RAW_INFO("** Gate peak %d, %d gated, %d analysed ***\r\n",
+			PingGatePeak, PingGateGated, PingGateAnalysed);
+	}
+	else if ((length > 5) && (strncmp((char *)p_data, "Cfar ", 5) == 0))
+	{
+		char cThreshold[6];
+		long nThreshold;
+
+		// "Cfar <dB>" sets how far over its noise floor an FFT bin must be to count as a peak
+		memset(cThreshold, 0, sizeof(cThreshold));
+		memcpy(cThreshold, &p_data[5], MIN(length - 5, sizeof(cThreshold) - 1));
+		nThreshold = strtol(cThreshold, NULL, 10);
+
+		if (ping_cfar_threshold_set((float) nThreshold))
+		{
+			NRF_LOG_RAW_INFO("** CFAR threshold %d dB ***\r\n", nThreshold);
+		}
+		else
+		{
+			NRF_LOG_RAW_INFO("** Invalid CFAR threshold %d dB ***\r\n", nThreshold);
+		}
+	}
+	else if ((length > 5) && (strncmp((char *)p_data, "Flux ", 5) == 0))
+	{
+		char cOnset[6];
+		long nOnset;
+
+		// "Flux <dB>" sets how far the alarm band must rise within a frame to start a pulse
+		memset(cOnset, 0, sizeof(cOnset));
+		memcpy(cOnset, &p_data[5], MIN(length - 5, sizeof(cOnset) - 1));
+		nOnset = strtol(cOnset, NULL, 10);
+
+		if (ping_flux_onset_set((float) nOnset))
+		{
+			NRF_LOG_RAW_INFO("** Pulse onset %d dB ***\r\n", nOnset);
+		}
+		else
+		{
+			NRF_LOG_RAW_INFO("** Invalid pulse onset %d dB ***\r\n", nOnset);
+		}
+	}
+	else if ((length >= 4) && (strncmp((char *)p_data, "Flux", 4) == 0))
+	{
+		// "Flux" reports the pulse edges found so far and the last one
+		NRF_LOG_RAW_INFO("** Pulse %d onsets, %d offsets, last %s at %d ms ***\r\n",
+			PingFluxOnsets, PingFluxOffsets,
+			(uint32_t) ((PingFluxEdge.Type == PING_FLUX_EDGE_ONSET) ? "onset" : (PingFluxEdge.Type == PING_FLUX_EDGE_OFFSET) ? "offset" : "none"),
+			PingFluxEdge.TimeMs);
+	}
+	else if ((length > 6) && (strncmp((char *)p_data, "Siren ", 6) == 0))
+	{
+		char cParams[20];
+		char *pNext;
+		long nMin, nMax;
+		uint8_t nClass;
+
+		// "Siren <wail|yelp> <min Hz/s> <max Hz/s>" sets the mean rate range of a sweep class
+		memset(cParams, 0, sizeof(cParams));
+		memcpy(cParams, &p_data[6], MIN(length - 6, sizeof(cParams) - 1));
+
+		for (nClass = 0; nClass < PING_SIREN_NUM_CLASSES; nClass++)
+		{
+			if (strncmp(cParams, PingSirenClassName[nClass], strlen(PingSirenClassName[nClass])) == 0)
+			{
+				break;
+			}
+		}
+
+		nMin = 0;
+		nMax = 0;
+
+		if (nClass < PING_SIREN_NUM_CLASSES)
+		{
+			nMin = strtol(&cParams[strlen(PingSirenClassName[nClass])], &pNext, 10);
+			nMax = strtol(pNext, NULL, 10);
+		}
+
+		if (ping_siren_range_set(nClass, (float) nMin, (float) nMax))
+		{
+			NRF_LOG_RAW_INFO("** Siren %s %d to %d Hz/s ***\r\n", (uint32_t) PingSirenClassName[nClass], nMin, nMax);
+		}
+		else
+		{
+			NRF_LOG_RAW_INFO("** Invalid siren range ***\r\n");
+		}
+	}
+	else if ((length >= 5) && (strncmp((char *)p_data, "Siren", 5) == 0))
+	{
+		// "Siren" reports the sweeps found so far, the last one and the current track
+		NRF_LOG_RAW_INFO("** Siren %d wail, %d yelp sweeps, last %s at %d ms for %d ms ***\r\n",
+			PingSirenSweeps[PING_SIREN_CLASS_WAIL], PingSirenSweeps[PING_SIREN_CLASS_YELP],
+			(uint32_t) PingSirenClassName[PingSirenSweep.Class], PingSirenSweep.StartMs, PingSirenSweep.DurationMs);
+		NRF_LOG_RAW_INFO("** Siren track %s, %d Hz, %d Hz/s ***\r\n", (uint32_t) (bPingSirenTrack ? "on" : "off"),
+			(int32_t) PingSirenFrequency, (int32_t) PingSirenRate);
+	}
+#if PING_NN_ENABLED
+	else if ((length >= 8) && (strncmp((char *)p_data, "Classify", 8) == 0))
+	{
+		uint8_t nClass;
+
+		// "Classify" reports the last scores of the sound event classifier
+		NRF_LOG_RAW_INFO("** Classifier %d inferences, %d skipped, self test 0x%08x ***\r\n",
+			PingNnInferences, PingNnSkipped, PingNnSelfTest);
+
+		for (nClass = 0; nClass < PING_NN_CLASSES; nClass++)
+		{
+			NRF_LOG_RAW_INFO("** %s %d ***\r\n", (uint32_t) PingNnClassName[nClass], PingNnScores[nClass]);
+		}
+	}
+#endif
+	else if ((length >= 12) && (strncmp((char *)p_data, "ProfileReset", 12) == 0))
+	{
+		// "ProfileReset" starts a new profiling run
+		ping_profile_reset();
+		NRF_LOG_RAW_INFO("** Profile reset ***\r\n");
+	}
+	else if ((length >= 7) && (strncmp((char *)p_data, "Profile", 7) == 0))
+	{
+		char cLine[128];
+		uint32_t nLength;
+		uint8_t nScope;
+
+		// "Profile" dumps the per scope timings to the log and to the app
+		ping_profile_dump();
+
+		for (nScope = 0; nScope < PING_PROFILE_NUM_SCOPES; nScope++)
+		{
+			if (PingProfile[nScope].Count == 0)
+			{
+				continue;
+			}
+
+			nLength = ping_profile_format(nScope, false, cLine, sizeof(cLine));
+			SendProfileLine(cLine, nLength);
+
+			nLength = ping_profile_format(nScope, true, cLine, sizeof(cLine));
+			SendProfileLine(cLine, nLength);
+		}
+	}
+	else if ((length >= 4) && (strncmp((char *)p_data, "Ring", 4) == 0))
+	{
+		drv_sgtl5000_stats_t I2sStats;
+
+		// "Ring" reports how the processing loop keeps up with the I2S frames
+		drv_sgtl5000_stats_get(&I2sStats);
+
+		NRF_LOG_RAW_INFO("** Ring %d queued, %d overruns, %d empty peeks ***\r\n",
+			ping_ring_count(), PingRingOverruns, PingRingEmptyPeeks);
+		NRF_LOG_RAW_INFO("** I2S %d frames, %d late supplies, %d dropped ***\r\n",
+			I2sStats.frames_received, I2sStats.late_supplies, I2sStats.dropped_frames);
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -1038,7 +1344,7 @@ static void on_adv_evt(ble_adv_evt_t ble_adv_evt)
 		break;
 
 	case BLE_ADV_EVT_IDLE:
-		NRF_LOG_RAW_INFO("%s(%d)\r\n", (uint32_t *)__func__, global_msec_counter);
+		NRF_LOG_RAW_INFO("%s(%d)\r\n", (uint32_t *)__func__, ElapsedTimeInMilliseconds());
 		break;
 
 	default:
@@ -63,6 +63,9 @@
 #define PASSKEY_TXT_LENGTH              8                                           /**< Length of message to be displayed together with the pass-key. */
 #define PASSKEY_LENGTH                  6                                           /**< Length of pass-key received by the stack for display. */
 
+// Packet type of the profiling dump sent by the "Profile" command, ASCII text
+#define PING_PACKET_TYPE_PROFILE		0x50
+
 #define VCFW_INIT			0
 #define VCFW_INITIATED		1
 #define VCFW_RECEIVING		3
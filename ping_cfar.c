@@ -0,0 +1,182 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_cfar.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Per bin noise floor and constant false alarm rate peak test
+//
+//	The largest bin of a spectrum always exists, in silence and in broadband noise alike.
+//	Here every bin instead keeps its own noise floor, an exponential average of its magnitude
+//	over the frames, and only a bin that stands PingCfarThreshold above its floor counts as
+//	a peak.  For noise the magnitude of a bin is Rayleigh distributed, so the chance of a
+//	noise bin passing a threshold of b times its mean is exp(-pi * b^2 / 4) whatever the
+//	noise level: about 4e-6 per bin and frame at the default 12 dB.  Of the bins that pass,
+//	the strongest is the peak; once a lasting tone has raised the floors under it, its
+//	leakage bins stand about as far above theirs as the tone bin itself.
+//
+//	Bins below the threshold update their floor with a time constant of PING_CFAR_TRACK_MS.
+//	Bins above it are mostly signal, they update with the much longer PING_CFAR_CENSORED_MS
+//	so that a tone does not raise its own floor within a pulse, while a lasting rise of the
+//	noise is still learnt.  The update is a multiply-add per bin and frame.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "nordic_common.h"
+#include "app_util_platform.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_fft.h"
+
+#include "ping_cfar.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float PingCfarFloor[PING_FFT_MAX_SIZE / 2];
+
+// Magnitude ratio over the floor, PING_CFAR_THRESHOLD_DB from ping_cfar_init() on, see
+// ping_cfar_threshold_set()
+float PingCfarThreshold = 0.0f;
+
+// Number of bins PingCfarFloor holds, 0 until the first spectrum has seeded it
+static uint32_t nCfarBins = 0;
+
+// Sample time of the last spectrum folded into the floor
+static uint32_t CfarSampleTime = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_cfar_init() function sets the threshold of ping_config.h and forgets the noise
+// floor.  Called once before the first spectrum; ping_cfar_reset() keeps the threshold.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_cfar_init(void)
+{
+	ping_cfar_threshold_set(PING_CFAR_THRESHOLD_DB);
+	ping_cfar_reset();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_cfar_reset() function forgets the noise floor, the next spectrum seeds it again.
+// Called whenever the analysis length or the detector changes.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_cfar_reset(void)
+{
+	nCfarBins = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_cfar_threshold_set() function sets how far above its floor a bin must be.
+//
+// Parameter(s):
+//
+//	fThresholdDb		threshold in dB of magnitude, PING_CFAR_MIN_THRESHOLD_DB to
+//					PING_CFAR_MAX_THRESHOLD_DB
+//
+// Returns false if the threshold is out of range
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_cfar_threshold_set(float fThresholdDb)
+{
+	if((fThresholdDb < PING_CFAR_MIN_THRESHOLD_DB) || (fThresholdDb > PING_CFAR_MAX_THRESHOLD_DB))
+	{
+		return false;
+	}
+
+	PingCfarThreshold = powf(10.0f, fThresholdDb / 20.0f);
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_cfar_update() function tests a spectrum against the noise floor, then folds it
+// into the floor.  Bin 0 (DC, and Nyquist in the packed real FFT output) is never a peak.
+//
+// Parameter(s):
+//
+//	pMagnitude		magnitude spectrum
+//	nBins			number of bins, at most PING_FFT_MAX_SIZE / 2
+//	SampleTime		end of the input of the spectrum, in samples from any origin; the
+//					floor moves by the time since the previous spectrum, however many
+//					inputs were gated or dropped in between
+//
+// Returns the strongest bin that passes the threshold, or PING_NO_DOMINANT_BIN if none
+// does or the floor has just been seeded
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_cfar_update(const float *pMagnitude, uint32_t nBins, uint32_t SampleTime)
+{
+	float fIntervalMs, fTrack, fCensored, fLimit, fBest;
+	uint32_t nIdx, BestIdx;
+
+	nBins = MIN(nBins, PING_FFT_MAX_SIZE / 2);
+
+	if(nBins != nCfarBins)
+	{
+		for(nIdx=0; nIdx < nBins; nIdx++)
+		{
+			PingCfarFloor[nIdx] = MAX(pMagnitude[nIdx], PING_CFAR_MIN_FLOOR);
+		}
+
+		nCfarBins = nBins;
+		CfarSampleTime = SampleTime;
+
+		return PING_NO_DOMINANT_BIN;
+	}
+
+	// Unsigned difference, the sample count may wrap
+	fIntervalMs = (float) (SampleTime - CfarSampleTime) * 1000.0f / PING_SAMPLE_RATE_HZ;
+	CfarSampleTime = SampleTime;
+
+	fTrack = MIN(1.0f, fIntervalMs / PING_CFAR_TRACK_MS);
+	fCensored = MIN(1.0f, fIntervalMs / PING_CFAR_CENSORED_MS);
+	fBest = 0.0f;
+	BestIdx = PING_NO_DOMINANT_BIN;
+
+	PingCfarFloor[0] += fTrack * (pMagnitude[0] - PingCfarFloor[0]);
+
+	for(nIdx=1; nIdx < nBins; nIdx++)
+	{
+		fLimit = PingCfarThreshold * PingCfarFloor[nIdx];
+
+		if(pMagnitude[nIdx] <= fLimit)
+		{
+			PingCfarFloor[nIdx] += fTrack * (pMagnitude[nIdx] - PingCfarFloor[nIdx]);
+		}
+		else
+		{
+			if(pMagnitude[nIdx] > fBest)
+			{
+				fBest = pMagnitude[nIdx];
+				BestIdx = nIdx;
+			}
+
+			PingCfarFloor[nIdx] += fCensored * (pMagnitude[nIdx] - PingCfarFloor[nIdx]);
+		}
+
+		PingCfarFloor[nIdx] = MAX(PingCfarFloor[nIdx], PING_CFAR_MIN_FLOOR);
+	}
+
+	return BestIdx;
+}
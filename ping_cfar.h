@@ -0,0 +1,36 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_cfar.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_cfar.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_CFAR_H
+#define PING_CFAR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// PING_FFT_MAX_SIZE
+#include "ping_config.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern float PingCfarFloor[PING_FFT_MAX_SIZE / 2];
+extern float PingCfarThreshold;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ping_cfar_init(void);
+extern void ping_cfar_reset(void);
+extern bool ping_cfar_threshold_set(float fThresholdDb);
+extern uint32_t ping_cfar_update(const float *pMagnitude, uint32_t nBins, uint32_t SampleTime);
+
+#endif //  PING_CFAR_H
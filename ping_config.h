@@ -5,8 +5,6 @@
 #include <ble_gap.h>
 
 
-#define TIMER1_REPEAT_RATE 		(1000) 	// 5 millisecond repeating timer in microseconds
-
 #define 	NRF_SDH_BLE_GATT_MAX_MTU_SIZE	247
 
 #define	SEC_PARAM_MITM_1		1
@@ -15,13 +13,192 @@
 // Number of stereo pairs per I2S access
 #define AUDIO_FRAME_NUM_SAMPLES                   			256
 
-// Size of the Rx buffer in terms of samples, or 32-bit stereo pairs
+// Size of the Tx buffer in terms of samples, or 32-bit stereo pairs.  Received frames go to
+// the buffer pool in ping_ring.c instead.
 #define I2S_BUFFER_SIZE_WORDS               					AUDIO_FRAME_NUM_SAMPLES * 2   // Double buffered, with AUDIO_FRAME_NUM_SAMPLES
 
-#define FFT_SAMPLE_SIZE 						(AUDIO_FRAME_NUM_SAMPLES)
-#define COMPLEX_FFT_SAMPLE_SIZE				(FFT_SAMPLE_SIZE * 2)
-
-extern void Timer1_Init(uint32_t repeat_rate);
+// I2S receive buffers in the pool shared by the DMA and the processing loop, a power of two.
+// Each is one AUDIO_FRAME_NUM_SAMPLES frame, 8.2 ms of audio and 1 KB of RAM; two are
+// always with the I2S peripheral, so the analysis may fall PING_RING_BUFFERS - 2 frames behind.
+#define PING_RING_BUFFERS					8
+
+// Frame-ready software interrupt.  The I2S event handler triggers it for every frame handed
+// to the ring and it runs the analysis, below the I2S interrupt so buffer rotation is never
+// held up by the DSP.  SWI1, SWI2 and SWI5 belong to the SoftDevice, SWI3 to drv_sgtl5000.
+#define PING_DSP_EGU_INSTANCE				NRF_EGU4
+#define PING_DSP_EGU_IRQn					SWI4_EGU4_IRQn
+#define PING_DSP_EGU_IRQHandler				SWI4_EGU4_IRQHandler
+#define PING_DSP_EGU_IRQPriority			APP_IRQ_PRIORITY_LOWEST
+#define PING_DSP_EGU_TASK_FRAME_READY		0
+
+// Profiling.  PING_PROFILE_BEGIN/END markers compile to nothing when disabled; the
+// histogram has log2 usec bins from under 2 usec up to 32 ms and longer.
+#define PING_PROFILE_ENABLED				1
+#define PING_PROFILE_HIST_BINS				16
+
+// Analysis length.  The length in use is FftLength, any power of two from PING_FFT_MIN_SIZE
+// to PING_FFT_MAX_SIZE, collected over as many I2S frames as it takes.  PING_FFT_MAX_SIZE
+// sizes the analysis buffers; 2048 works too but needs about 32 KB more RAM than 1024.
+#define PING_FFT_MIN_SIZE					64
+#define PING_FFT_MAX_SIZE					1024
+#define PING_FFT_DEFAULT_SIZE				256
+
+// Energy gate.  The block detectors (FFT, Goertzel, Q15, Q31, harmonic) skip an analysis
+// input whose largest sample stays under PingGatePeak and report no tone for it; 0 analyses
+// everything.  The default, 64 LSB or about -54 dBFS, is well below any alarm the detector
+// could act on.
+#define PING_GATE_PEAK						64
+
+// Sample rate of the SGTL5000 I2S stream, see DRV_SGTL5000_FS_31250HZ
+#define PING_SAMPLE_RATE_HZ					31250
+
+// FFT bin size in Hz at the current analysis length
+#define PING_BIN_SIZE_HZ						((float) PING_SAMPLE_RATE_HZ / FftLength)
+
+// Frequency band that main() treats as the alarm tone, compared against the interpolated
+// peak.  The default is the band the former bin 51..53 window covered.
+#define PING_ALARM_FREQ_LO_HZ				6165.0f
+#define PING_ALARM_FREQ_HI_HZ				6530.0f
+
+// FFT bins covering the alarm band, for the detectors that work on bins
+#define PING_ALARM_BIN_LO						((uint32_t) (PING_ALARM_FREQ_LO_HZ / PING_BIN_SIZE_HZ + 0.5f))
+#define PING_ALARM_BIN_HI						((uint32_t) (PING_ALARM_FREQ_HI_HZ / PING_BIN_SIZE_HZ + 0.5f))
+
+// Detector used after boot, see ping_fft.h for the list of modes
+#define PING_DETECTOR_DEFAULT_MODE			PING_DETECTOR_GOERTZEL
+
+// Goertzel filter bank.  The default bank covers the alarm bins plus two guard bins on each
+// side, so a tone just outside the alarm window is still reported as outside it.  At 2048
+// points that takes 29 filters.
+#define PING_GOERTZEL_MAX_FILTERS			32
+#define PING_GOERTZEL_GUARD_BINS			2
+
+// Fraction of the frame energy (DC removed) that a Goertzel bin must hold before it is
+// reported as dominant.  A pure tone centred on a bin scores 1.0, one half way between
+// two bins scores about 0.4 in each of them.
+#define PING_GOERTZEL_DOMINANCE			0.25f
+
+// Sliding DFT.  Damping applied per sample to keep the recursion stable.
+#define PING_SDFT_DAMPING					0.99995f
+
+// Welch averaged spectrum.  Segments per average and overlap between segments; both can be
+// changed at run time with ping_welch_config().
+#define PING_WELCH_FRAMES					8
+#define PING_WELCH_OVERLAP_PERCENT			50
+#define PING_WELCH_MAX_OVERLAP_PERCENT		75
+
+// Zoom FFT.  Default band (the alarm band with some margin), the complex FFT length run on
+// the decimated band, and the decimation filter: taps per unit of decimation, capped at
+// PING_ZOOM_MAX_FIR_TAPS.  The span can be set at run time down to
+// PING_SAMPLE_RATE_HZ / (2 * PING_ZOOM_MAX_DECIMATION).
+#define PING_ZOOM_CENTER_HZ					((PING_ALARM_FREQ_LO_HZ + PING_ALARM_FREQ_HI_HZ) / 2)
+#define PING_ZOOM_SPAN_HZ					1000.0f
+#define PING_ZOOM_FFT_SIZE					64
+#define PING_ZOOM_CFFT_INSTANCE				arm_cfft_sR_f32_len64
+#define PING_ZOOM_MAX_DECIMATION			32
+#define PING_ZOOM_FIR_TAPS_PER_DECIMATION	6
+#define PING_ZOOM_MAX_FIR_TAPS				128
+
+// Fraction of the zoom spectrum energy the strongest in-band bin must hold, as for
+// PING_GOERTZEL_DOMINANCE
+#define PING_ZOOM_DOMINANCE					0.25f
+
+// Harmonic sum detector, see ping_fft.c.  The candidate fundamentals are the FFT bins from
+// PING_HARMONIC_FREQ_LO_HZ to PING_HARMONIC_FREQ_HI_HZ, at most PING_HARMONIC_MAX_CANDIDATES
+// of them (1 to 8 kHz takes 230 at 1024 points), each scored over its first
+// PING_HARMONIC_ORDERS harmonics below Nyquist, the fundamental included.  The tables take
+// about 9 bytes of RAM per candidate.
+#define PING_HARMONIC_FREQ_LO_HZ			1000.0f
+#define PING_HARMONIC_FREQ_HI_HZ			8000.0f
+#define PING_HARMONIC_MAX_CANDIDATES		240
+#define PING_HARMONIC_ORDERS				5
+
+// Noise floor of the float FFT detector, see ping_cfar.c.  A bin is only a peak when it
+// stands PING_CFAR_THRESHOLD_DB over its own floor; the threshold can be set at run time
+// within the MIN/MAX range.  The floor follows quiet bins with PING_CFAR_TRACK_MS and bins
+// over the threshold with PING_CFAR_CENSORED_MS, and never drops below PING_CFAR_MIN_FLOOR.
+#define PING_CFAR_THRESHOLD_DB				12.0f
+#define PING_CFAR_MIN_THRESHOLD_DB			3.0f
+#define PING_CFAR_MAX_THRESHOLD_DB			30.0f
+#define PING_CFAR_TRACK_MS					1000.0f
+#define PING_CFAR_CENSORED_MS				10000.0f
+#define PING_CFAR_MIN_FLOOR					1.0f
+
+// Mel and MFCC features, see ping_mel.c.  They feed the classifier and are computed only
+// with PING_NN_ENABLED, when the FFT detector runs at PING_MEL_FFT_SIZE (ping_tables.h),
+// one row per 16.4 ms input, and the last
+// PING_MFCC_HISTORY rows are kept, about 0.8 s.  PING_MEL_POWER_FLOOR is added to the band
+// power before the logarithm and is what a gated input counts as.
+#define PING_MFCC_HISTORY					49
+#define PING_MEL_POWER_FLOOR				1.0f
+
+// Sound event classifier on the MFCC history, see ping_nn.c.  Its arena takes about 9 KB of
+// RAM.  It runs every PING_NN_HOP_ROWS feature rows, 131 ms at the default, on the MFCCs
+// scaled by 2^PING_NN_INPUT_FRAC_BITS, as the weights were quantised for.  Left out until
+// trained weights are checked in: ping_nn_weights.c only holds seeded placeholders.  To turn
+// it on, set 1 here and build the CMSIS_NN folder of the SES project, which takes the q7
+// kernels from a CMSIS_5 checkout, 5.7 to 5.9, in a directory named CMSIS_5 next to
+// nRF5_SDK_15.0.0_a53641a.
+#define PING_NN_ENABLED						0
+#define PING_NN_HOP_ROWS					8
+#define PING_NN_INPUT_FRAC_BITS				1
+
+// Pulse edge detector, see ping_flux.c.  Spectral flux over the alarm band, widened by
+// PING_FLUX_GUARD_BINS on either side, once per I2S frame.  An onset needs the band to rise
+// by PING_FLUX_ONSET_DB over its floor within a hop, settable at run time within the
+// MIN/MAX range, and to reach PING_FLUX_MIN_LEVEL (amplitude LSB).  An offset needs it to
+// fall by PING_FLUX_OFFSET_FRACTION of the rise of the pulse.  The floor follows the band
+// outside pulses with PING_FLUX_TRACK_MS.  It runs on every frame, ahead of the energy gate
+// of ping_detect() which would hide the rise of a pulse from quiet, so PING_FLUX_ENABLED 0
+// saves its time (PING_PROFILE_FLUX) where only the tone decisions are wanted.
+#define PING_FLUX_ENABLED					1
+#define PING_FLUX_GUARD_BINS				1
+#define PING_FLUX_MAX_BINS					8
+#define PING_FLUX_ONSET_DB					9.0f
+#define PING_FLUX_MIN_ONSET_DB				3.0f
+#define PING_FLUX_MAX_ONSET_DB				30.0f
+#define PING_FLUX_OFFSET_FRACTION			0.5f
+#define PING_FLUX_MIN_LEVEL					16.0f
+#define PING_FLUX_TRACK_MS					250.0f
+
+// Siren sweep tracker, see ping_siren.c.  The strongest peak from PING_SIREN_FREQ_LO_HZ to
+// PING_SIREN_FREQ_HI_HZ in each I2S frame is a measurement if it reaches PING_SIREN_MIN_LEVEL
+// (amplitude LSB) and PING_SIREN_PEAK_RATIO times the rest of the band.  The alpha-beta
+// tracker has gains PING_SIREN_ALPHA and PING_SIREN_BETA, takes measurements within
+// PING_SIREN_GATE_HZ of its prediction and drops the track after PING_SIREN_MAX_MISSES
+// misses in a row.  A sweep ends when the track turns back by PING_SIREN_TURN_HZ and is
+// reported if it lasts PING_SIREN_MIN_SWEEP_MS, spans PING_SIREN_MIN_SPAN_HZ, fits its shape
+// with a coefficient of determination of PING_SIREN_MIN_FIT and its mean rate (Hz per
+// second) is in the range of a class; the ranges can be set at run time.  Like the edge
+// detector it runs on every frame, sirens start from quiet as well; PING_SIREN_ENABLED 0
+// saves its time (PING_PROFILE_SIREN).
+#define PING_SIREN_ENABLED					1
+#define PING_SIREN_FREQ_LO_HZ				500.0f
+#define PING_SIREN_FREQ_HI_HZ				2000.0f
+#define PING_SIREN_MAX_BINS					24
+#define PING_SIREN_MIN_LEVEL				16.0f
+#define PING_SIREN_PEAK_RATIO				4.0f
+#define PING_SIREN_ALPHA					0.5f
+#define PING_SIREN_BETA						0.2f
+#define PING_SIREN_GATE_HZ					200.0f
+#define PING_SIREN_MAX_MISSES				3
+#define PING_SIREN_TURN_HZ					50.0f
+#define PING_SIREN_MIN_SWEEP_MS				60.0f
+#define PING_SIREN_MIN_SPAN_HZ				200.0f
+#define PING_SIREN_MIN_FIT					0.9f
+#define PING_SIREN_WAIL_MIN_HZ_S			100.0f
+#define PING_SIREN_WAIL_MAX_HZ_S			1500.0f
+#define PING_SIREN_YELP_MIN_HZ_S			1500.0f
+#define PING_SIREN_YELP_MAX_HZ_S			20000.0f
+
+// Temporal pattern decoder.  Allowed error on each pulse, gap and pause, and the number of
+// complete pulse groups needed before an alarm is confirmed.
+#define PING_T3_TOLERANCE_MS				200
+#define PING_T4_TOLERANCE_MS				50
+#define PING_TEMPORAL_GROUPS_TO_CONFIRM		2
+
+extern void Rtc2_Init(void);
+extern uint64_t ElapsedTimeInMicroseconds(void);
 extern uint32_t ElapsedTimeInMilliseconds(void);
 extern uint32_t ping_fft(float fBinSize);
 extern void GetMacAddress(void);
@@ -31,20 +208,10 @@ extern void DoBLE(void);
 
 extern uint32_t Num_Mic_Samples;
 
-extern float fFFTin[FFT_SAMPLE_SIZE];
-
-extern float fFFTout[COMPLEX_FFT_SAMPLE_SIZE+2];
+extern float fFFTin[PING_FFT_MAX_SIZE];
 extern char cOutbuf[128];
 
-extern int16_t *Current_RX_Buffer;
-extern bool bCaptureRx;
-extern int16_t Rx_Buffer[FFT_SAMPLE_SIZE * 2];
-
-extern uint32_t RxTimeBeg;
-extern uint32_t RxTimeDelta;
-
 extern uint32_t  m_i2s_tx_buffer[I2S_BUFFER_SIZE_WORDS];
-extern uint32_t  m_i2s_rx_buffer[I2S_BUFFER_SIZE_WORDS];
 
 extern volatile bool bBleConnected;
 extern uint16_t hvx_sent_count;
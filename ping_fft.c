@@ -7,6 +7,7 @@
 #include "nrf_gpio.h"
 #include "nrf_delay.h"
 #include "nordic_common.h"
+#include "app_util_platform.h"
 
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
@@ -18,6 +19,11 @@
 #include "arm_const_structs.h"
 
 #include "ping_config.h"
+#include "ping_fft.h"
+#include "ping_tables.h"
+#include "ping_profile.h"
+#include "ping_cfar.h"
+#include "ping_mel.h"
 
 /* ----------------------------------------------------------------------
 * Copyright (C) 2010-2012 ARM Limited. All rights reserved.
@@ -66,13 +72,9 @@
 // buckets to save FFT inputs
 
 
-static float32_t FFT_magnitudes[COMPLEX_FFT_SAMPLE_SIZE];
-
 char cOutbuf[128];
 
-float fFFTin[FFT_SAMPLE_SIZE];
-
-float fFFTout[COMPLEX_FFT_SAMPLE_SIZE+2];
+float fFFTin[PING_FFT_MAX_SIZE];
 
 float32_t maxvalue;
 
@@ -89,53 +91,324 @@ arm_rfft_fast_instance_f32 S;
 /* ------------------------------------------------------------------
 * Global variables for FFT Bin Example
 * ------------------------------------------------------------------- */
-uint32_t fftSize = COMPLEX_FFT_SAMPLE_SIZE;
 uint32_t ifftFlag = 0;
 uint32_t doBitReverse = 1;
 /* Reference index at which max energy of bin ocuurs */
 uint32_t refIndex = 213, testIndex = 0;
 
 
-float32_t fft_out[FFT_SAMPLE_SIZE];
-float32_t fft_magnitude[512];
-arm_rfft_fast_instance_f32 fftInstance;
+float32_t fft_out[PING_FFT_MAX_SIZE];
+float32_t fft_magnitude[PING_FFT_MAX_SIZE / 2];
+
+// Analysis length in use, see ping_fft_length_set()
+uint32_t FftLength = PING_FFT_DEFAULT_SIZE;
+
+// Sample clock of the capture, see ping_capture_push().  Frames longer than the analysis
+// input and inputs skipped by the energy gate still count.
+static uint32_t CaptureSamples = 0;			// samples received since boot
+static uint32_t InputSamples = 0;			// CaptureSamples at the end of the last complete input
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// FFT instances
+//
+// One instance per supported length and per FFT flavour, filled in at build time with what
+// arm_rfft_fast_init_f32(), arm_rfft_init_q15() and arm_rfft_init_q31() would have set, so
+// they live in flash and the first frame after boot costs the same as any other.  The
+// fields follow the CMSIS-DSP structures shipped with nRF5 SDK 15.0.0; every real FFT of
+// N points, float or fixed-point, runs a complex FFT of N / 2 points.
+// Entries are in order of length, starting at PING_FFT_MIN_SIZE.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+#if (PING_FFT_MIN_SIZE != 64) || (PING_FFT_MAX_SIZE > 2048)
+#error "The FFT instance tables cover 64 to 2048 points"
+#endif
+
+#define FFT_LENGTH_INDEX(n)		(((n) == 64) ? 0 : ((n) == 128) ? 1 : ((n) == 256) ? 2 : ((n) == 512) ? 3 : ((n) == 1024) ? 4 : 5)
+
+static const arm_rfft_fast_instance_f32 FftInstanceF32[] =
+{
+	{ { 32, twiddleCoef_32, armBitRevIndexTable32, ARMBITREVINDEXTABLE_32_TABLE_LENGTH }, 64, (float32_t *) twiddleCoef_rfft_64 },
+	{ { 64, twiddleCoef_64, armBitRevIndexTable64, ARMBITREVINDEXTABLE_64_TABLE_LENGTH }, 128, (float32_t *) twiddleCoef_rfft_128 },
+	{ { 128, twiddleCoef_128, armBitRevIndexTable128, ARMBITREVINDEXTABLE_128_TABLE_LENGTH }, 256, (float32_t *) twiddleCoef_rfft_256 },
+	{ { 256, twiddleCoef_256, armBitRevIndexTable256, ARMBITREVINDEXTABLE_256_TABLE_LENGTH }, 512, (float32_t *) twiddleCoef_rfft_512 },
+	{ { 512, twiddleCoef_512, armBitRevIndexTable512, ARMBITREVINDEXTABLE_512_TABLE_LENGTH }, 1024, (float32_t *) twiddleCoef_rfft_1024 },
+#if PING_FFT_MAX_SIZE >= 2048
+	{ { 1024, twiddleCoef_1024, armBitRevIndexTable1024, ARMBITREVINDEXTABLE_1024_TABLE_LENGTH }, 2048, (float32_t *) twiddleCoef_rfft_2048 },
+#endif
+};
+
+static const arm_rfft_instance_q15 FftInstanceQ15[] =
+{
+	{ 64, 0, 1, 8192U / 64, (q15_t *) realCoefAQ15, (q15_t *) realCoefBQ15, &arm_cfft_sR_q15_len32 },
+	{ 128, 0, 1, 8192U / 128, (q15_t *) realCoefAQ15, (q15_t *) realCoefBQ15, &arm_cfft_sR_q15_len64 },
+	{ 256, 0, 1, 8192U / 256, (q15_t *) realCoefAQ15, (q15_t *) realCoefBQ15, &arm_cfft_sR_q15_len128 },
+	{ 512, 0, 1, 8192U / 512, (q15_t *) realCoefAQ15, (q15_t *) realCoefBQ15, &arm_cfft_sR_q15_len256 },
+	{ 1024, 0, 1, 8192U / 1024, (q15_t *) realCoefAQ15, (q15_t *) realCoefBQ15, &arm_cfft_sR_q15_len512 },
+#if PING_FFT_MAX_SIZE >= 2048
+	{ 2048, 0, 1, 8192U / 2048, (q15_t *) realCoefAQ15, (q15_t *) realCoefBQ15, &arm_cfft_sR_q15_len1024 },
+#endif
+};
+
+static const arm_rfft_instance_q31 FftInstanceQ31[] =
+{
+	{ 64, 0, 1, 8192U / 64, (q31_t *) realCoefAQ31, (q31_t *) realCoefBQ31, &arm_cfft_sR_q31_len32 },
+	{ 128, 0, 1, 8192U / 128, (q31_t *) realCoefAQ31, (q31_t *) realCoefBQ31, &arm_cfft_sR_q31_len64 },
+	{ 256, 0, 1, 8192U / 256, (q31_t *) realCoefAQ31, (q31_t *) realCoefBQ31, &arm_cfft_sR_q31_len128 },
+	{ 512, 0, 1, 8192U / 512, (q31_t *) realCoefAQ31, (q31_t *) realCoefBQ31, &arm_cfft_sR_q31_len256 },
+	{ 1024, 0, 1, 8192U / 1024, (q31_t *) realCoefAQ31, (q31_t *) realCoefBQ31, &arm_cfft_sR_q31_len512 },
+#if PING_FFT_MAX_SIZE >= 2048
+	{ 2048, 0, 1, 8192U / 2048, (q31_t *) realCoefAQ31, (q31_t *) realCoefBQ31, &arm_cfft_sR_q31_len1024 },
+#endif
+};
+
+// Instances for FftLength, switched by ping_fft_length_set()
+static const arm_rfft_fast_instance_f32 *pFftInstance = &FftInstanceF32[FFT_LENGTH_INDEX(PING_FFT_DEFAULT_SIZE)];
+static const arm_rfft_instance_q15 *pFftInstanceQ15 = &FftInstanceQ15[FFT_LENGTH_INDEX(PING_FFT_DEFAULT_SIZE)];
+static const arm_rfft_instance_q31 *pFftInstanceQ31 = &FftInstanceQ31[FFT_LENGTH_INDEX(PING_FFT_DEFAULT_SIZE)];
+
+// The detector modes never run at the same time, so the length dependent buffers that
+// only one of them uses share one scratch area.  ping_detector_select() restarts the
+// mode being switched to.
+static union
+{
+	struct
+	{
+		q15_t In[PING_FFT_MAX_SIZE];
+		q15_t Out[PING_FFT_MAX_SIZE * 2];
+		q15_t Magnitude[PING_FFT_MAX_SIZE / 2];
+	} q15;
+
+	struct
+	{
+		q31_t In[PING_FFT_MAX_SIZE];
+		q31_t Out[PING_FFT_MAX_SIZE * 2];
+		q31_t Magnitude[PING_FFT_MAX_SIZE / 2];
+	} q31;
+
+	struct
+	{
+		float Segment[PING_FFT_MAX_SIZE];
+		float Scratch[PING_FFT_MAX_SIZE];
+		float Accumulator[PING_FFT_MAX_SIZE / 2];
+	} welch;
+} DetectorScratch;
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Peak interpolation
+//
+// At the default length a bin is about 122 Hz wide, too coarse to tell a 3.1 kHz sounder from an appliance tone
+// next to it.  Every detector therefore refines its peak bin with the two bins around it and
+// leaves the result in PingPeak: the frequency in Hz and the amplitude of the sinusoid in
+// input LSB.  Where the complex spectrum is at hand (ping_fft) the Jacobsen estimator is used.
+// The other rectangular window detectors only have magnitudes; a log-parabola is biased by up
+// to 0.17 bin on the sinc shaped peak, so they use the ratio of the two largest bins instead,
+// which is exact for a noise free tone.  The Hann windowed Welch spectrum is close enough to
+// a Gaussian for the log-parabola.  Either way it is a handful of flops per frame.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+ping_peak_t PingPeak;
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_peak_parabolic() function fits a parabola through the log magnitudes of a peak bin
+// and its neighbours.
+//
+// Parameter(s):
+//
+//	fLeft, fCentre, fRight	magnitudes of bins Index - 1, Index and Index + 1; a missing
+//						neighbour is passed as 0 and disables the interpolation
+//	Index				peak bin
+//	fBinSize				FFT bin size in Hz
+//	fScale				converts the magnitude into a sinusoid amplitude
+//	pPeak				result
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ping_peak_parabolic(float fLeft, float fCentre, float fRight, uint32_t Index, float fBinSize, float fScale, ping_peak_t *pPeak)
+{
+	float fA, fB, fC, fDenom;
+	float fDelta = 0.0f;
+	float fPeak = fCentre;
+
+	if((fLeft > 0.0f) && (fCentre > 0.0f) && (fRight > 0.0f))
+	{
+		fA = logf(fLeft);
+		fB = logf(fCentre);
+		fC = logf(fRight);
+		fDenom = fA - 2.0f * fB + fC;
+
+		// Only a true maximum has a parabola that opens downwards
+		if(fDenom < 0.0f)
+		{
+			fDelta = 0.5f * (fA - fC) / fDenom;
+			fDelta = MAX(-0.5f, MIN(0.5f, fDelta));
+			fPeak = expf(fB - 0.25f * (fA - fC) * fDelta);
+		}
+	}
+
+	pPeak->Index = Index;
+	pPeak->fFrequency = ((float) Index + fDelta) * fBinSize;
+	pPeak->fAmplitude = fPeak * fScale;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_peak_ratio() function interpolates a rectangular window peak from its magnitude
+// and that of its larger neighbour: delta = R / (1 + R), R = |X[k+1]| / |X[k]|.
+//
+// Parameter(s):
+//
+//	fLeft, fCentre, fRight	magnitudes of bins Index - 1, Index and Index + 1; a missing
+//						neighbour is passed as 0
+//	Index				peak bin
+//	fBinSize				FFT bin size in Hz
+//	fScale				converts the magnitude into a sinusoid amplitude at the bin centre
+//	pPeak				result
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_peak_ratio(float fLeft, float fCentre, float fRight, uint32_t Index, float fBinSize, float fScale, ping_peak_t *pPeak)
+{
+	float fDelta = 0.0f;
+	float fSinc = 1.0f;
+
+	if(fCentre > 0.0f)
+	{
+		if(fRight >= fLeft)
+		{
+			fDelta = fRight / (fCentre + fRight);
+		}
+		else
+		{
+			fDelta = -fLeft / (fCentre + fLeft);
+		}
+
+		fDelta = MAX(-0.5f, MIN(0.5f, fDelta));
+
+		// Undo the scalloping loss of the rectangular window
+		if(fDelta != 0.0f)
+		{
+			fSinc = arm_sin_f32(PI * fDelta) / (PI * fDelta);
+		}
+	}
+
+	pPeak->Index = Index;
+	pPeak->fFrequency = ((float) Index + fDelta) * fBinSize;
+	pPeak->fAmplitude = fCentre * fScale / fSinc;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_peak_jacobsen() function interpolates a peak of the float FFT in fft_out.
+//
+// Parameter(s):
+//
+//	Index			peak bin
+//	fBinSize			FFT bin size in Hz
+//	pPeak			result
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ping_peak_jacobsen(uint32_t Index, float fBinSize, ping_peak_t *pPeak)
+{
+	float fNumRe, fNumIm, fDenRe, fDenIm, fDenom;
+	float fDelta = 0.0f;
+	float fSinc = 1.0f;
+	const float *pLeft, *pCentre, *pRight;
+
+	// Bin 0 packs DC and Nyquist, so only bins with two ordinary neighbours are refined
+	if((Index >= 2) && (Index < (FftLength / 2 - 1)))
+	{
+		pLeft = &fft_out[(Index - 1) * 2];
+		pCentre = &fft_out[Index * 2];
+		pRight = &fft_out[(Index + 1) * 2];
+
+		// delta = Re{ (X[k-1] - X[k+1]) / (2X[k] - X[k-1] - X[k+1]) }
+		fNumRe = pLeft[0] - pRight[0];
+		fNumIm = pLeft[1] - pRight[1];
+		fDenRe = 2.0f * pCentre[0] - pLeft[0] - pRight[0];
+		fDenIm = 2.0f * pCentre[1] - pLeft[1] - pRight[1];
+		fDenom = fDenRe * fDenRe + fDenIm * fDenIm;
+
+		if(fDenom > 0.0f)
+		{
+			fDelta = (fNumRe * fDenRe + fNumIm * fDenIm) / fDenom;
+			fDelta = MAX(-0.5f, MIN(0.5f, fDelta));
+		}
+
+		// Undo the scalloping loss of the rectangular window
+		if(fDelta != 0.0f)
+		{
+			fSinc = arm_sin_f32(PI * fDelta) / (PI * fDelta);
+		}
+	}
+
+	pPeak->Index = Index;
+	pPeak->fFrequency = ((float) Index + fDelta) * fBinSize;
+	pPeak->fAmplitude = 2.0f * fft_magnitude[Index] / (fSinc * FftLength);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_fft_spectrum() function runs the float FFT over fFFTin and leaves the complex
+// bins in fft_out and their magnitudes in fft_magnitude, with the noise floor updated.
+//
+// Returns the strongest bin over its noise floor, see ping_cfar_update()
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static uint32_t ping_fft_spectrum(void)
+{
+	uint32_t MaxIdx;
+
+	// arm_rfft_fast_f32() does not write to the instance, it just is not declared const
+	PING_PROFILE_BEGIN(PING_PROFILE_FFT);
+	arm_rfft_fast_f32((arm_rfft_fast_instance_f32 *) pFftInstance, fFFTin, fft_out, 0);
+	PING_PROFILE_END(PING_PROFILE_FFT);
+
+	PING_PROFILE_BEGIN(PING_PROFILE_MAGNITUDE);
+	arm_cmplx_mag_f32(fft_out, fft_magnitude, FftLength / 2);	// fft_out holds FftLength / 2 complex bins
+	//arm_max_f32(fft_out, FftLength, &maxValue, &testIndex);
+
+	// Strongest bin among those over their own noise floor, see ping_cfar.c
+	MaxIdx = ping_cfar_update(fft_magnitude, FftLength / 2, InputSamples);
+	PING_PROFILE_END(PING_PROFILE_MAGNITUDE);
+
+	return MaxIdx;
+}
 
 /* ----------------------------------------------------------------------
 * Max magnitude FFT Bin test
 * ------------------------------------------------------------------- */
 uint32_t  ping_fft(float fBinSize)
 {
-	arm_status status;
-	float32_t maxValue;
-	uint32_t nIdx, nJdx;
-	static bool bBeenHere = false;
-	
+	uint32_t MaxIdx;
 
-        float fMax;
-        uint16_t MaxIdx;
+	MaxIdx = ping_fft_spectrum();
 
-	// First way
+#if PING_NN_ENABLED
+	// The event features come from the same spectrum
+	if(FftLength == PING_MEL_FFT_SIZE)
+	{
+		PING_PROFILE_BEGIN(PING_PROFILE_FEATURES);
+		ping_mel_update(fft_magnitude, FftLength / 2);
+		PING_PROFILE_END(PING_PROFILE_FEATURES);
+	}
+#endif
 
-	if(!bBeenHere)
+	if(MaxIdx == PING_NO_DOMINANT_BIN)
 	{
-		arm_rfft_fast_init_f32(&fftInstance, FFT_SAMPLE_SIZE);
-		bBeenHere = true;
+		memset(&PingPeak, 0, sizeof(PingPeak));
+		return PING_NO_DOMINANT_BIN;
 	}
-	
-	arm_rfft_fast_f32(&fftInstance, fFFTin, fft_out, 0);
-	arm_cmplx_mag_f32(fft_out, fft_magnitude, FFT_SAMPLE_SIZE);
-	//arm_max_f32(fft_out, FFT_SAMPLE_SIZE, &maxValue, &testIndex);
 
-        fMax = 0.0;
-        MaxIdx = 0;
-        for(nIdx=0; nIdx<FFT_SAMPLE_SIZE / 2; nIdx++)
-        {
-          if(fft_magnitude[nIdx] > fMax)  
-          {
-            fMax = fft_magnitude[nIdx];
-            MaxIdx = nIdx;
-          }
-        }
+	PING_PROFILE_BEGIN(PING_PROFILE_PEAK);
+        ping_peak_jacobsen(MaxIdx, fBinSize, &PingPeak);
+	PING_PROFILE_END(PING_PROFILE_PEAK);
 
        // sprintf(cOutbuf, "MaxMag = %f, MaxIdx = %d\r\n", fMax, MaxIdx);
        // NRF_LOG_RAW_INFO("%s", (uint32_t) cOutbuf);
@@ -143,9 +416,10 @@ uint32_t  ping_fft(float fBinSize)
 #ifdef PRINT_RESULTS      
 
 	float RealPart, ImaginaryPart, Magnitude, OtherMagnitude;
+	uint32_t nIdx, nJdx;
 
 	nJdx = 0;
-	for(nIdx=0; nIdx<FFT_SAMPLE_SIZE; nIdx += 2)
+	for(nIdx=0; nIdx<FftLength; nIdx += 2)
 	{
 		sprintf(cOutbuf, "[%6d]", ( uint32_t)(fBinSize * nJdx));
 		NRF_LOG_RAW_INFO("%s", (uint32_t) cOutbuf);
@@ -182,5 +456,1525 @@ uint32_t  ping_fft(float fBinSize)
 
 }
 
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Harmonic sum
+//
+// A piezo sounder is driven with a square wave into a resonant disc, so its overtones can
+// be as strong as the fundamental or stronger, and the argmax of ping_fft() then lands on
+// the second harmonic, outside the alarm band.  This mode scores every candidate
+// fundamental instead by the energy of its harmonic series: the excess over the noise floor
+// of the fundamental plus that of its next PING_HARMONIC_ORDERS - 1 harmonics below Nyquist.
+//
+// Only bins that pass the CFAR test (ping_cfar.c) add to a score, and a candidate must pass
+// it itself and be a local maximum.  Noise under the threshold therefore adds nothing, low
+// frequency rumble only raises the floor of its own bins, and a subharmonic of the tone,
+// which would collect the same harmonics, is no candidate as long as nothing stands on it.
+// The CFAR peak alone is the score to beat, so a lone tone outside the candidate range is
+// reported as ping_fft() would.
+//
+// A fundamental anywhere within its bin puts harmonic k up to k / 2 bins away from k times
+// that bin, so each harmonic is searched over a window of k + 1 bins.  The windows only
+// depend on the analysis length and are tabulated when it changes, so the search is linear
+// in the number of candidates: up to three compares for one that fails the test, 18 more
+// for one that passes at the default 5 orders.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+static uint16_t HarmonicStart[PING_HARMONIC_MAX_CANDIDATES][PING_HARMONIC_ORDERS - 1];	// first bin of the window of harmonics 2 and up
+static uint8_t HarmonicOrders[PING_HARMONIC_MAX_CANDIDATES];		// windows that fit below Nyquist
+static uint32_t HarmonicBinLo = 0;							// bin of the first candidate
+static uint32_t nHarmonicCandidates = 0;
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_harmonic_config() function tabulates the harmonic windows of every candidate
+// fundamental for the current FftLength.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ping_harmonic_config(void)
+{
+	uint32_t nBins = FftLength / 2;
+	uint32_t nLo, nHi, nIdx, nOrder, nBin, nStart;
+
+	// Candidates keep two ordinary neighbours for the local maximum and the interpolation
+	nLo = (uint32_t) (PING_HARMONIC_FREQ_LO_HZ / PING_BIN_SIZE_HZ + 0.5f);
+	nHi = (uint32_t) (PING_HARMONIC_FREQ_HI_HZ / PING_BIN_SIZE_HZ + 0.5f);
+	nLo = MAX(nLo, 2);
+	nHi = MIN(nHi, nBins - 2);
+
+	HarmonicBinLo = nLo;
+	nHarmonicCandidates = MIN(nHi - nLo + 1, PING_HARMONIC_MAX_CANDIDATES);
+
+	for(nIdx=0; nIdx < nHarmonicCandidates; nIdx++)
+	{
+		nBin = nLo + nIdx;
+
+		for(nOrder=2; nOrder <= PING_HARMONIC_ORDERS; nOrder++)
+		{
+			// round(k * (bin - 1/2)) up to k bins higher, all of it below the last bin
+			nStart = (2 * nOrder * nBin - nOrder + 1) / 2;
+
+			if(nStart + nOrder >= nBins)
+			{
+				break;
+			}
+
+			HarmonicStart[nIdx][nOrder - 2] = (uint16_t) nStart;
+		}
+
+		HarmonicOrders[nIdx] = (uint8_t) (nOrder - 2);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_harmonic() function runs the float FFT over fFFTin and picks the fundamental
+// whose harmonic series stands furthest over the noise floor.
+//
+// Parameter(s):
+//
+//	fBinSize		FFT bin size in Hz
+//
+// Returns the fundamental bin, or PING_NO_DOMINANT_BIN if no bin passes the noise floor
+// test.  The interpolated fundamental is left in PingPeak.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_harmonic(float fBinSize)
+{
+	float fScore, fBest, fHarmonic;
+	uint32_t MaxIdx, BestIdx, nIdx, nOrder, nBin, nEnd, nCandidate;
+
+	MaxIdx = ping_fft_spectrum();
+
+	if(MaxIdx == PING_NO_DOMINANT_BIN)
+	{
+		memset(&PingPeak, 0, sizeof(PingPeak));
+		return PING_NO_DOMINANT_BIN;
+	}
+
+	PING_PROFILE_BEGIN(PING_PROFILE_HARMONIC);
+
+	BestIdx = MaxIdx;
+	fBest = fft_magnitude[MaxIdx] - PingCfarFloor[MaxIdx];
+
+	for(nIdx=0; nIdx < nHarmonicCandidates; nIdx++)
+	{
+		nCandidate = HarmonicBinLo + nIdx;
+
+		if((fft_magnitude[nCandidate] <= PingCfarThreshold * PingCfarFloor[nCandidate]) ||
+			(fft_magnitude[nCandidate] < fft_magnitude[nCandidate - 1]) ||
+			(fft_magnitude[nCandidate] < fft_magnitude[nCandidate + 1]))
+		{
+			continue;
+		}
+
+		fScore = fft_magnitude[nCandidate] - PingCfarFloor[nCandidate];
+
+		for(nOrder=0; nOrder < HarmonicOrders[nIdx]; nOrder++)
+		{
+			// Largest excess within the window of harmonic nOrder + 2, k + 1 bins wide
+			fHarmonic = 0.0f;
+			nEnd = HarmonicStart[nIdx][nOrder] + nOrder + 2;
+
+			for(nBin = HarmonicStart[nIdx][nOrder]; nBin <= nEnd; nBin++)
+			{
+				if(fft_magnitude[nBin] > PingCfarThreshold * PingCfarFloor[nBin])
+				{
+					fHarmonic = MAX(fHarmonic, fft_magnitude[nBin] - PingCfarFloor[nBin]);
+				}
+			}
+
+			fScore += fHarmonic;
+		}
+
+		if(fScore > fBest)
+		{
+			fBest = fScore;
+			BestIdx = nCandidate;
+		}
+	}
+
+	PING_PROFILE_END(PING_PROFILE_HARMONIC);
+
+	PING_PROFILE_BEGIN(PING_PROFILE_PEAK);
+	ping_peak_jacobsen(BestIdx, fBinSize, &PingPeak);
+	PING_PROFILE_END(PING_PROFILE_PEAK);
+
+	return BestIdx;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Goertzel filter bank
+//
+// main() only cares whether the dominant bin is in PING_ALARM_BIN_LO..PING_ALARM_BIN_HI, so
+// running a handful of Goertzel filters at those bins costs a fraction of the full FFT plus
+// magnitude pass.  Each filter gives exactly the FFT magnitude of its bin.  Since the bank
+// cannot see the rest of the spectrum, a bin only counts as dominant when it holds at least
+// PING_GOERTZEL_DOMINANCE of the frame energy (Parseval), otherwise PING_NO_DOMINANT_BIN
+// is returned.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+uint8_t PingDetectorMode = PING_DETECTOR_DEFAULT_MODE;
+
+float GoertzelMagnitude[PING_GOERTZEL_MAX_FILTERS];
+
+static float GoertzelCoeff[PING_GOERTZEL_MAX_FILTERS];
+static uint16_t GoertzelBin[PING_GOERTZEL_MAX_FILTERS];
+static uint8_t nGoertzelFilters = 0;
+
+static void ping_sdft_config(void);
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_peak_from_bank() function interpolates the strongest filter of the bank with its
+// neighbours, as long as they sit on the adjacent bins.
+//
+// Parameter(s):
+//
+//	pMagnitude		magnitude of each filter
+//	MaxIdx			strongest filter
+//	fBinSize			FFT bin size in Hz
+//	pPeak			result
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ping_peak_from_bank(const float *pMagnitude, uint32_t MaxIdx, float fBinSize, ping_peak_t *pPeak)
+{
+	float fLeft = 0.0f;
+	float fRight = 0.0f;
+
+	if((MaxIdx > 0) && (GoertzelBin[MaxIdx - 1] + 1 == GoertzelBin[MaxIdx]))
+		fLeft = pMagnitude[MaxIdx - 1];
+
+	if((MaxIdx + 1 < nGoertzelFilters) && (GoertzelBin[MaxIdx + 1] == GoertzelBin[MaxIdx] + 1))
+		fRight = pMagnitude[MaxIdx + 1];
+
+	// Same rectangular window as the FFT, a centred tone of amplitude A gives N * A / 2
+	ping_peak_ratio(fLeft, pMagnitude[MaxIdx], fRight, GoertzelBin[MaxIdx], fBinSize, 2.0f / FftLength, pPeak);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_goertzel_config() function sets up the filter bank.
+//
+// Parameter(s):
+//
+//	pFrequencies	target frequencies in Hz, or NULL for the default alarm bank
+//	nFilters		number of entries in pFrequencies
+//	fBinSize		FFT bin size in Hz
+//
+// Returns false if the bank does not fit or a frequency is above Nyquist
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_goertzel_config(const float *pFrequencies, uint8_t nFilters, float fBinSize)
+{
+	uint8_t nIdx;
+	float fBin;
+
+	if(pFrequencies == NULL)
+	{
+		// Default bank, the alarm window plus guard bins on both sides
+		nFilters = (PING_ALARM_BIN_HI - PING_ALARM_BIN_LO + 1) + 2 * PING_GOERTZEL_GUARD_BINS;
+	}
+
+	if((nFilters == 0) || (nFilters > PING_GOERTZEL_MAX_FILTERS))
+	{
+		return false;
+	}
+
+	for(nIdx=0; nIdx < nFilters; nIdx++)
+	{
+		if(pFrequencies == NULL)
+			fBin = (float) (PING_ALARM_BIN_LO - PING_GOERTZEL_GUARD_BINS + nIdx);
+		else
+			fBin = pFrequencies[nIdx] / fBinSize;
+
+		if((fBin < 1.0f) || (fBin >= (FftLength / 2)))
+		{
+			return false;
+		}
+
+		GoertzelCoeff[nIdx] = 2.0f * arm_cos_f32(2.0f * PI * fBin / FftLength);
+		GoertzelBin[nIdx] = (uint16_t) (fBin + 0.5f);
+	}
+
+	nGoertzelFilters = nFilters;
+
+	// The sliding DFT monitors the same bins
+	ping_sdft_config();
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_goertzel() function runs the filter bank over fFFTin.
+//
+// Parameter(s):
+//
+//	fBinSize		FFT bin size in Hz, used for the default bank
+//
+// Returns the FFT bin of the strongest filter, or PING_NO_DOMINANT_BIN
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_goertzel(float fBinSize)
+{
+	uint32_t nIdx, nJdx;
+	float fCoeff, fS0, fS1, fS2;
+	float fPower, fMaxPower, fMean, fEnergy;
+	uint32_t MaxIdx;
+
+	// Frame energy with DC removed, the reference for the dominance test
+	arm_mean_f32(fFFTin, FftLength, &fMean);
+	arm_power_f32(fFFTin, FftLength, &fEnergy);
+	fEnergy -= FftLength * fMean * fMean;
+
+	fMaxPower = 0.0f;
+	MaxIdx = 0;
+
+	for(nJdx=0; nJdx < nGoertzelFilters; nJdx++)
+	{
+		fCoeff = GoertzelCoeff[nJdx];
+		fS1 = 0.0f;
+		fS2 = 0.0f;
+
+		for(nIdx=0; nIdx < FftLength; nIdx++)
+		{
+			fS0 = fFFTin[nIdx] + fCoeff * fS1 - fS2;
+			fS2 = fS1;
+			fS1 = fS0;
+		}
+
+		// |X[k]|^2, identical to the FFT bin power for an integer k
+		fPower = fS1 * fS1 + fS2 * fS2 - fCoeff * fS1 * fS2;
+		arm_sqrt_f32(fPower, &GoertzelMagnitude[nJdx]);
+
+		if(fPower > fMaxPower)
+		{
+			fMaxPower = fPower;
+			MaxIdx = nJdx;
+		}
+	}
+
+	// A bin holding all of the energy has 2 * |X[k]|^2 == N * energy
+	if((fEnergy <= 0.0f) || (2.0f * fMaxPower < PING_GOERTZEL_DOMINANCE * FftLength * fEnergy))
+	{
+		memset(&PingPeak, 0, sizeof(PingPeak));
+		return PING_NO_DOMINANT_BIN;
+	}
+
+	ping_peak_from_bank(GoertzelMagnitude, MaxIdx, fBinSize, &PingPeak);
+
+	return GoertzelBin[MaxIdx];
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Sliding DFT
+//
+// Instead of waiting for a captured frame, the bins of the Goertzel bank are updated on every
+// sample of every I2S block with the damped sliding DFT
+//
+//	S[k](n) = r * e^(j*2*pi*k/N) * (S[k](n-1) + x(n) - r^N * x(n-N))
+//
+// over the last FftLength samples.  The damping r keeps float round-off from piling
+// up in the recursion, and the window energy is recomputed from the history once per
+// window for the same reason.  The per-sample cost is constant, and the result is
+// published at the end of each block in SdftDominantIndex.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+volatile uint32_t SdftDominantIndex = PING_NO_DOMINANT_BIN;
+
+static ping_peak_t SdftPeak;
+
+static int16_t SdftHistory[PING_FFT_MAX_SIZE];
+static uint32_t SdftPos = 0;
+static float SdftRe[PING_GOERTZEL_MAX_FILTERS];
+static float SdftIm[PING_GOERTZEL_MAX_FILTERS];
+static float SdftCos[PING_GOERTZEL_MAX_FILTERS];
+static float SdftSin[PING_GOERTZEL_MAX_FILTERS];
+static float fSdftDampingN;
+static float fSdftSum = 0.0f;
+static float fSdftEnergy = 0.0f;
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_sdft_config() function sets the twiddles for the bins in the bank and clears
+// the sliding state.  Called from ping_goertzel_config().
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ping_sdft_config(void)
+{
+	uint32_t nIdx;
+	float fTheta;
+
+	for(nIdx=0; nIdx < nGoertzelFilters; nIdx++)
+	{
+		fTheta = 2.0f * PI * GoertzelBin[nIdx] / FftLength;
+		SdftCos[nIdx] = PING_SDFT_DAMPING * arm_cos_f32(fTheta);
+		SdftSin[nIdx] = PING_SDFT_DAMPING * arm_sin_f32(fTheta);
+		SdftRe[nIdx] = 0.0f;
+		SdftIm[nIdx] = 0.0f;
+	}
+
+	fSdftDampingN = powf(PING_SDFT_DAMPING, FftLength);
+
+	memset(SdftHistory, 0, sizeof(SdftHistory));
+	SdftPos = 0;
+	fSdftSum = 0.0f;
+	fSdftEnergy = 0.0f;
+	SdftDominantIndex = PING_NO_DOMINANT_BIN;
+	memset(&SdftPeak, 0, sizeof(SdftPeak));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_sdft_update() function slides the monitored bins over one I2S block.  The
+// processing loop calls it for every frame it takes from the frame ring.
+//
+// Parameter(s):
+//
+//	pStereo		received I2S block, one 32-bit stereo pair per sample, left channel first
+//	nSamples		number of stereo pairs in the block
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_sdft_update(const int16_t *pStereo, uint32_t nSamples)
+{
+	uint32_t nIdx, nJdx;
+	float fNew, fOld, fDelta, fRe;
+	float fPower, fMaxPower, fEnergy;
+	float SdftMagnitude[PING_GOERTZEL_MAX_FILTERS];
+	uint32_t MaxIdx;
+
+	for(nIdx=0; nIdx < nSamples; nIdx++)
+	{
+		fNew = (float) pStereo[nIdx * 2];
+		fOld = (float) SdftHistory[SdftPos];
+		SdftHistory[SdftPos] = pStereo[nIdx * 2];
+
+		fDelta = fNew - fSdftDampingN * fOld;
+
+		for(nJdx=0; nJdx < nGoertzelFilters; nJdx++)
+		{
+			fRe = SdftRe[nJdx] + fDelta;
+			SdftRe[nJdx] = fRe * SdftCos[nJdx] - SdftIm[nJdx] * SdftSin[nJdx];
+			SdftIm[nJdx] = fRe * SdftSin[nJdx] + SdftIm[nJdx] * SdftCos[nJdx];
+		}
+
+		fSdftSum += fNew - fOld;
+		fSdftEnergy += fNew * fNew - fOld * fOld;
+
+		if(++SdftPos >= FftLength)
+		{
+			SdftPos = 0;
+			fSdftSum = 0.0f;
+			fSdftEnergy = 0.0f;
+
+			for(nJdx=0; nJdx < FftLength; nJdx++)
+			{
+				fNew = (float) SdftHistory[nJdx];
+				fSdftSum += fNew;
+				fSdftEnergy += fNew * fNew;
+			}
+		}
+	}
+
+	// Same dominance test as ping_goertzel(), on the energy of the sliding window
+	fMaxPower = 0.0f;
+	MaxIdx = 0;
+
+	for(nJdx=0; nJdx < nGoertzelFilters; nJdx++)
+	{
+		fPower = SdftRe[nJdx] * SdftRe[nJdx] + SdftIm[nJdx] * SdftIm[nJdx];
+		arm_sqrt_f32(fPower, &SdftMagnitude[nJdx]);
+
+		if(fPower > fMaxPower)
+		{
+			fMaxPower = fPower;
+			MaxIdx = nJdx;
+		}
+	}
+
+	fEnergy = fSdftEnergy - fSdftSum * fSdftSum / FftLength;
+
+	if((fEnergy <= 0.0f) || (2.0f * fMaxPower < PING_GOERTZEL_DOMINANCE * FftLength * fEnergy))
+	{
+		SdftDominantIndex = PING_NO_DOMINANT_BIN;
+		memset(&SdftPeak, 0, sizeof(SdftPeak));
+	}
+	else
+	{
+		SdftDominantIndex = GoertzelBin[MaxIdx];
+		ping_peak_from_bank(SdftMagnitude, MaxIdx, PING_BIN_SIZE_HZ, &SdftPeak);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Fixed-point FFT
+//
+// The capture is already int16, i.e. Q15, so ping_capture_push() copies the left channel
+// straight into the input of these paths, without the float conversion and without
+// touching the FPU.  Both return the same bin index as ping_fft(); only the peak
+// interpolation at the end uses floats, on three bins.
+//
+// Accuracy against the float path, for the 256-point FFT (every doubling of the length adds
+// one radix stage and about 1 LSB of error):
+//
+//	arm_rfft_q15 scales its output down by N (9.7 format for N = 256) and truncates in each
+//	radix stage, so a bin carries up to about log2(N) + 1 = 9 LSB of error in its 9.7 output,
+//	i.e. about 9 * 256 = 2300 in the units of the float |X[k]|.  A full scale tone peaks at
+//	128 * 32767, so the error floor sits roughly 65 dB below full scale.  The Q15 argmax
+//	matches the float argmax whenever the two strongest bins differ by more than that, which
+//	in practice fails only for tones near the 16-bit noise floor.
+//
+//	arm_rfft_q31 has the same structure with 16 more bits, so its error is below the
+//	quantisation of the 16-bit input and the argmax matches the float path except on ties.
+//
+// These figures follow from the CMSIS scaling tables.  The fixed check of host/ping_test.c
+// holds both paths to them on tones from -3 to -40 dB of full scale.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_fft_q15() function runs the Q15 FFT, magnitude and peak search on the captured
+// DetectorScratch.q15.In.
+//
+// Parameter(s):
+//
+//	fBinSize		FFT bin size in Hz
+//
+// Returns the bin with the largest magnitude
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_fft_q15(float fBinSize)
+{
+	uint32_t MaxIdx;
+	q15_t MaxValue;
+
+	PING_PROFILE_BEGIN(PING_PROFILE_FFT);
+	arm_rfft_q15(pFftInstanceQ15, DetectorScratch.q15.In, DetectorScratch.q15.Out);
+	PING_PROFILE_END(PING_PROFILE_FFT);
+
+	PING_PROFILE_BEGIN(PING_PROFILE_MAGNITUDE);
+	arm_cmplx_mag_q15(DetectorScratch.q15.Out, DetectorScratch.q15.Magnitude, FftLength / 2);
+	arm_max_q15(DetectorScratch.q15.Magnitude, FftLength / 2, &MaxValue, &MaxIdx);
+	PING_PROFILE_END(PING_PROFILE_MAGNITUDE);
+
+	// The 2.14 magnitude of the 1/N scaled FFT is |X[k]| / (2 * N) in input LSB
+	ping_peak_ratio((MaxIdx > 0) ? DetectorScratch.q15.Magnitude[MaxIdx - 1] : 0.0f,
+		MaxValue,
+		(MaxIdx + 1 < FftLength / 2) ? DetectorScratch.q15.Magnitude[MaxIdx + 1] : 0.0f,
+		MaxIdx, fBinSize, 4.0f, &PingPeak);
+
+	return MaxIdx;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_fft_q31() function runs the Q31 FFT, magnitude and peak search on the captured
+// DetectorScratch.q31.In.
+//
+// Parameter(s):
+//
+//	fBinSize		FFT bin size in Hz
+//
+// Returns the bin with the largest magnitude
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_fft_q31(float fBinSize)
+{
+	uint32_t MaxIdx;
+	q31_t MaxValue;
+
+	PING_PROFILE_BEGIN(PING_PROFILE_FFT);
+	arm_rfft_q31(pFftInstanceQ31, DetectorScratch.q31.In, DetectorScratch.q31.Out);
+	PING_PROFILE_END(PING_PROFILE_FFT);
+
+	PING_PROFILE_BEGIN(PING_PROFILE_MAGNITUDE);
+	arm_cmplx_mag_q31(DetectorScratch.q31.Out, DetectorScratch.q31.Magnitude, FftLength / 2);
+	arm_max_q31(DetectorScratch.q31.Magnitude, FftLength / 2, &MaxValue, &MaxIdx);
+	PING_PROFILE_END(PING_PROFILE_MAGNITUDE);
+
+	// As for Q15, with the input shifted up by 16 bits
+	ping_peak_ratio((MaxIdx > 0) ? (float) DetectorScratch.q31.Magnitude[MaxIdx - 1] : 0.0f,
+		(float) MaxValue,
+		(MaxIdx + 1 < FftLength / 2) ? (float) DetectorScratch.q31.Magnitude[MaxIdx + 1] : 0.0f,
+		MaxIdx, fBinSize, 4.0f / 65536.0f, &PingPeak);
+
+	return MaxIdx;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Welch averaged power spectrum
+//
+// A single unwindowed frame gives a noisy, leaky peak.  In PING_DETECTOR_WELCH mode the
+// captured samples are cut into Hann windowed segments of FftLength that overlap by
+// WelchOverlapPercent, the power spectrum of each segment is accumulated, and after
+// WelchFrames segments the average is latched into WelchPsd and searched for its peak.
+// Everything is static, the segments go through the same FFT instance as ping_fft() and the
+// window is the constant Hann table.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+float WelchPsd[PING_FFT_MAX_SIZE / 2];
+uint8_t WelchFrames = PING_WELCH_FRAMES;
+uint8_t WelchOverlapPercent = PING_WELCH_OVERLAP_PERCENT;
+
+static uint32_t WelchFill = 0;
+static uint32_t WelchHop = PING_FFT_DEFAULT_SIZE;
+static uint8_t WelchCount = 0;
+static uint32_t WelchDominantIndex = 0;
+static ping_peak_t WelchPeak;
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_welch_config() function sets the number of averaged segments and their overlap,
+// and restarts the average.
+//
+// Parameter(s):
+//
+//	nFrames			segments per average, 1 or more
+//	nOverlapPercent	overlap between consecutive segments, 0 to PING_WELCH_MAX_OVERLAP_PERCENT
+//
+// Returns false if a parameter is out of range
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_welch_config(uint8_t nFrames, uint8_t nOverlapPercent)
+{
+	if((nFrames == 0) || (nOverlapPercent > PING_WELCH_MAX_OVERLAP_PERCENT))
+	{
+		return false;
+	}
+
+	WelchFrames = nFrames;
+	WelchOverlapPercent = nOverlapPercent;
+	WelchHop = FftLength - (FftLength * nOverlapPercent) / 100;
+
+	memset(DetectorScratch.welch.Accumulator, 0, sizeof(DetectorScratch.welch.Accumulator));
+	WelchFill = 0;
+	WelchCount = 0;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_welch_push() function adds captured samples to the running average.
+//
+// Parameter(s):
+//
+//	pSamples		mono float samples, consecutive with the previous call
+//	nSamples		number of samples
+//
+// Returns true when a new average has been latched into WelchPsd
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_welch_push(const float *pSamples, uint32_t nSamples)
+{
+	uint32_t nIdx, nCopy, nStride;
+	float fMax;
+	bool bLatched = false;
+
+	nStride = PING_HANN_TABLE_LENGTH / FftLength;
+
+	while(nSamples > 0)
+	{
+		nCopy = MIN(nSamples, FftLength - WelchFill);
+		memcpy(&DetectorScratch.welch.Segment[WelchFill], pSamples, nCopy * sizeof(float));
+		WelchFill += nCopy;
+		pSamples += nCopy;
+		nSamples -= nCopy;
 
+		if(WelchFill < FftLength)
+		{
+			break;
+		}
 
+		// Window into the scratch buffer, arm_rfft_fast_f32 overwrites its input.  The Hann
+		// table only holds the first half, the second half runs back through it.
+		for(nIdx=0; nIdx <= FftLength / 2; nIdx++)
+		{
+			DetectorScratch.welch.Scratch[nIdx] = DetectorScratch.welch.Segment[nIdx] * PingHannHalf[nIdx * nStride];
+		}
+
+		for(; nIdx < FftLength; nIdx++)
+		{
+			DetectorScratch.welch.Scratch[nIdx] = DetectorScratch.welch.Segment[nIdx] * PingHannHalf[(FftLength - nIdx) * nStride];
+		}
+
+		PING_PROFILE_BEGIN(PING_PROFILE_FFT);
+		arm_rfft_fast_f32((arm_rfft_fast_instance_f32 *) pFftInstance, DetectorScratch.welch.Scratch, fft_out, 0);
+		PING_PROFILE_END(PING_PROFILE_FFT);
+
+		PING_PROFILE_BEGIN(PING_PROFILE_MAGNITUDE);
+		arm_cmplx_mag_squared_f32(fft_out, fft_magnitude, FftLength / 2);
+		PING_PROFILE_END(PING_PROFILE_MAGNITUDE);
+		arm_add_f32(DetectorScratch.welch.Accumulator, fft_magnitude, DetectorScratch.welch.Accumulator, FftLength / 2);
+
+		// Keep the overlapping tail for the next segment
+		memmove(DetectorScratch.welch.Segment, &DetectorScratch.welch.Segment[WelchHop], (FftLength - WelchHop) * sizeof(float));
+		WelchFill = FftLength - WelchHop;
+
+		if(++WelchCount >= WelchFrames)
+		{
+			arm_scale_f32(DetectorScratch.welch.Accumulator, 1.0f / WelchCount, WelchPsd, FftLength / 2);
+			arm_max_f32(WelchPsd, FftLength / 2, &fMax, &WelchDominantIndex);
+
+			// Interpolate on magnitudes; the Hann window has a coherent gain of 0.5
+			ping_peak_parabolic((WelchDominantIndex > 0) ? sqrtf(WelchPsd[WelchDominantIndex - 1]) : 0.0f,
+				sqrtf(fMax),
+				(WelchDominantIndex + 1 < FftLength / 2) ? sqrtf(WelchPsd[WelchDominantIndex + 1]) : 0.0f,
+				WelchDominantIndex, PING_BIN_SIZE_HZ, 4.0f / FftLength, &WelchPeak);
+
+			memset(DetectorScratch.welch.Accumulator, 0, sizeof(DetectorScratch.welch.Accumulator));
+			WelchCount = 0;
+			bLatched = true;
+		}
+	}
+
+	return bLatched;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Zoom FFT
+//
+// The alarm band is a few hundred Hz wide, but the full FFT spends its cycles on all
+// 15.6 kHz of it.  In PING_DETECTOR_ZOOM mode the captured samples are mixed down so that
+// ZoomCenterHz sits at 0 Hz, low pass filtered by a windowed-sinc FIR and decimated by
+// ZoomDecimation, leaving a complex baseband sampled at about twice ZoomSpanHz.  Every
+// PING_ZOOM_FFT_SIZE decimated samples go through a short complex FFT, whose bins are
+// ZoomDecimation times narrower than those of the full FFT.  The FIR only runs at the
+// decimated rate, so the whole chain costs less per sample than arm_rfft_fast_f32.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+float ZoomCenterHz = PING_ZOOM_CENTER_HZ;
+float ZoomSpanHz = PING_ZOOM_SPAN_HZ;
+uint32_t ZoomDecimation = 0;
+
+static float ZoomCoeff[PING_ZOOM_MAX_FIR_TAPS];
+static float ZoomHistory[2 * 2 * PING_ZOOM_MAX_FIR_TAPS];		// Complex, written twice so the taps are contiguous
+static float ZoomBuffer[2 * PING_ZOOM_FFT_SIZE];
+static float ZoomMagnitude[PING_ZOOM_FFT_SIZE];
+static float ZoomStepRe, ZoomStepIm;
+static float ZoomPhasorRe, ZoomPhasorIm;
+static uint32_t nZoomTaps = 0;
+static uint32_t ZoomHistoryIdx = 0;
+static uint32_t ZoomPhase = 0;
+static uint32_t ZoomFill = 0;
+static uint32_t ZoomDominantIndex = PING_NO_DOMINANT_BIN;
+static ping_peak_t ZoomPeak;
+
+// Decimation for a band, 0 if there is none
+static uint32_t ping_zoom_decimation(float fCenterHz, float fSpanHz)
+{
+	uint32_t Decimation;
+
+	if((fSpanHz <= 0.0f) || (fCenterHz - fSpanHz / 2 < 0.0f) || (fCenterHz + fSpanHz / 2 > PING_SAMPLE_RATE_HZ / 2))
+	{
+		return 0;
+	}
+
+	// Decimated rate of at least twice the span, so the FIR has a transition band as wide
+	// as the span itself before anything aliases into the band
+	Decimation = (uint32_t) (PING_SAMPLE_RATE_HZ / (2.0f * fSpanHz));
+
+	if((Decimation < 2) || (Decimation > PING_ZOOM_MAX_DECIMATION))
+	{
+		return 0;
+	}
+
+	return Decimation;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_zoom_config() function selects the band analysed by the zoom FFT, designs the
+// decimation filter for it and restarts the analysis.
+//
+// Parameter(s):
+//
+//	fCenterHz		centre of the band in Hz
+//	fSpanHz		width of the band in Hz
+//
+// Returns false if the band does not fit between 0 Hz and Nyquist, or needs a decimation
+// outside 2..PING_ZOOM_MAX_DECIMATION
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_zoom_config(float fCenterHz, float fSpanHz)
+{
+	uint32_t nIdx, Decimation;
+	float fCutoff, fOffset, fSinc, fWindow, fSum;
+
+	Decimation = ping_zoom_decimation(fCenterHz, fSpanHz);
+
+	if(Decimation == 0)
+	{
+		return false;
+	}
+
+	// Hamming windowed sinc, cutoff half way between the band edge and the first alias
+	nZoomTaps = MIN(PING_ZOOM_FIR_TAPS_PER_DECIMATION * Decimation, PING_ZOOM_MAX_FIR_TAPS);
+	fCutoff = 0.5f / Decimation;
+	fSum = 0.0f;
+
+	for(nIdx=0; nIdx < nZoomTaps; nIdx++)
+	{
+		fOffset = (float) nIdx - (nZoomTaps - 1) / 2.0f;
+
+		if(fOffset == 0.0f)
+		{
+			fSinc = 2.0f * fCutoff;
+		}
+		else
+		{
+			fSinc = arm_sin_f32(2.0f * PI * fCutoff * fOffset) / (PI * fOffset);
+		}
+
+		fWindow = 0.54f - 0.46f * arm_cos_f32(2.0f * PI * nIdx / (nZoomTaps - 1));
+		ZoomCoeff[nIdx] = fSinc * fWindow;
+		fSum += ZoomCoeff[nIdx];
+	}
+
+	// Unity gain at 0 Hz
+	arm_scale_f32(ZoomCoeff, 1.0f / fSum, ZoomCoeff, nZoomTaps);
+
+	// Oscillator at -fCenterHz
+	ZoomStepRe = arm_cos_f32(2.0f * PI * fCenterHz / PING_SAMPLE_RATE_HZ);
+	ZoomStepIm = -arm_sin_f32(2.0f * PI * fCenterHz / PING_SAMPLE_RATE_HZ);
+	ZoomPhasorRe = 1.0f;
+	ZoomPhasorIm = 0.0f;
+
+	ZoomCenterHz = fCenterHz;
+	ZoomSpanHz = fSpanHz;
+	ZoomDecimation = Decimation;
+
+	memset(ZoomHistory, 0, sizeof(ZoomHistory));
+	ZoomHistoryIdx = 0;
+	ZoomPhase = 0;
+	ZoomFill = 0;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_zoom_analyse() function runs the complex FFT on a full ZoomBuffer and latches the
+// strongest bin inside the span.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ping_zoom_analyse(void)
+{
+	uint32_t nIdx, MaxIdx, nHalfSpan;
+	int32_t Bin;
+	float fZoomBinSize, fMax, fEnergy;
+
+	PING_PROFILE_BEGIN(PING_PROFILE_FFT);
+	arm_cfft_f32(&PING_ZOOM_CFFT_INSTANCE, ZoomBuffer, 0, 1);
+	PING_PROFILE_END(PING_PROFILE_FFT);
+
+	PING_PROFILE_BEGIN(PING_PROFILE_MAGNITUDE);
+	arm_cmplx_mag_f32(ZoomBuffer, ZoomMagnitude, PING_ZOOM_FFT_SIZE);
+	PING_PROFILE_END(PING_PROFILE_MAGNITUDE);
+	arm_power_f32(ZoomBuffer, 2 * PING_ZOOM_FFT_SIZE, &fEnergy);
+
+	// Only the bins within +/- ZoomSpanHz / 2 are free of the filter roll-off
+	fZoomBinSize = (float) PING_SAMPLE_RATE_HZ / (ZoomDecimation * PING_ZOOM_FFT_SIZE);
+	nHalfSpan = MIN((uint32_t) (ZoomSpanHz / (2.0f * fZoomBinSize)), PING_ZOOM_FFT_SIZE / 2 - 1);
+
+	MaxIdx = 0;
+	fMax = ZoomMagnitude[0];
+
+	for(nIdx=1; nIdx <= nHalfSpan; nIdx++)
+	{
+		if(ZoomMagnitude[nIdx] > fMax)
+		{
+			fMax = ZoomMagnitude[nIdx];
+			MaxIdx = nIdx;
+		}
+
+		if(ZoomMagnitude[PING_ZOOM_FFT_SIZE - nIdx] > fMax)
+		{
+			fMax = ZoomMagnitude[PING_ZOOM_FFT_SIZE - nIdx];
+			MaxIdx = PING_ZOOM_FFT_SIZE - nIdx;
+		}
+	}
+
+	// As for the Goertzel bank, the band alone cannot tell a tone from noise
+	if((fEnergy <= 0.0f) || (fMax * fMax < PING_ZOOM_DOMINANCE * fEnergy))
+	{
+		ZoomDominantIndex = PING_NO_DOMINANT_BIN;
+		memset(&ZoomPeak, 0, sizeof(ZoomPeak));
+		return;
+	}
+
+	// Rectangular window, and a tone of amplitude A leaves A / 2 at baseband
+	ping_peak_ratio(ZoomMagnitude[(MaxIdx + PING_ZOOM_FFT_SIZE - 1) % PING_ZOOM_FFT_SIZE],
+		fMax,
+		ZoomMagnitude[(MaxIdx + 1) % PING_ZOOM_FFT_SIZE],
+		0, fZoomBinSize, 2.0f / PING_ZOOM_FFT_SIZE, &ZoomPeak);
+
+	Bin = (MaxIdx < PING_ZOOM_FFT_SIZE / 2) ? (int32_t) MaxIdx : (int32_t) MaxIdx - PING_ZOOM_FFT_SIZE;
+	ZoomPeak.fFrequency += ZoomCenterHz + Bin * fZoomBinSize;
+
+	// Report the full FFT bin the peak falls in, like every other mode
+	ZoomPeak.Index = (uint32_t) (ZoomPeak.fFrequency / PING_BIN_SIZE_HZ + 0.5f);
+	ZoomDominantIndex = ZoomPeak.Index;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_zoom_push() function mixes, filters and decimates captured samples into the zoom
+// FFT buffer, and analyses it whenever it is full.
+//
+// Parameter(s):
+//
+//	pSamples		mono float samples, consecutive with the previous call
+//	nSamples		number of samples
+//
+// Returns true when a new zoom spectrum has been analysed
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_zoom_push(const float *pSamples, uint32_t nSamples)
+{
+	uint32_t nIdx, nJdx;
+	float fRe, fIm, fMag;
+	const float *pHistory;
+	bool bAnalysed = false;
+
+	for(nIdx=0; nIdx < nSamples; nIdx++)
+	{
+		// Mix down and store twice, so the newest nZoomTaps samples always start at ZoomHistoryIdx + 1
+		fRe = pSamples[nIdx] * ZoomPhasorRe;
+		fIm = pSamples[nIdx] * ZoomPhasorIm;
+
+		ZoomHistory[2 * ZoomHistoryIdx] = fRe;
+		ZoomHistory[2 * ZoomHistoryIdx + 1] = fIm;
+		ZoomHistory[2 * (ZoomHistoryIdx + nZoomTaps)] = fRe;
+		ZoomHistory[2 * (ZoomHistoryIdx + nZoomTaps) + 1] = fIm;
+
+		if(++ZoomHistoryIdx >= nZoomTaps)
+		{
+			ZoomHistoryIdx = 0;
+		}
+
+		fRe = ZoomPhasorRe * ZoomStepRe - ZoomPhasorIm * ZoomStepIm;
+		ZoomPhasorIm = ZoomPhasorRe * ZoomStepIm + ZoomPhasorIm * ZoomStepRe;
+		ZoomPhasorRe = fRe;
+
+		if(++ZoomPhase < ZoomDecimation)
+		{
+			continue;
+		}
+
+		ZoomPhase = 0;
+
+		// The FIR is symmetric, so the order of the taps does not matter
+		pHistory = &ZoomHistory[2 * ZoomHistoryIdx];
+		fRe = 0.0f;
+		fIm = 0.0f;
+
+		for(nJdx=0; nJdx < nZoomTaps; nJdx++)
+		{
+			fRe += ZoomCoeff[nJdx] * pHistory[2 * nJdx];
+			fIm += ZoomCoeff[nJdx] * pHistory[2 * nJdx + 1];
+		}
+
+		ZoomBuffer[2 * ZoomFill] = fRe;
+		ZoomBuffer[2 * ZoomFill + 1] = fIm;
+
+		if(++ZoomFill >= PING_ZOOM_FFT_SIZE)
+		{
+			ping_zoom_analyse();
+			ZoomFill = 0;
+			bAnalysed = true;
+		}
+	}
+
+	// Keep the oscillator on the unit circle
+	fMag = ZoomPhasorRe * ZoomPhasorRe + ZoomPhasorIm * ZoomPhasorIm;
+	arm_sqrt_f32(fMag, &fMag);
+
+	if(fMag > 0.0f)
+	{
+		ZoomPhasorRe /= fMag;
+		ZoomPhasorIm /= fMag;
+	}
+
+	return bAnalysed;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Analysis length and capture
+//
+// The analysis length FftLength is independent of the I2S frame: ping_capture_push() takes
+// the received I2S buffers one at a time, straight from the DMA memory, and collects
+// FftLength samples in the input format of the selected detector before main() runs it.
+// Buffers longer than what is still missing are cut short.  ping_fft_length_set() switches
+// to the constant FFT instances for the new length and rebuilds every table that depends on
+// it; it and ping_detector_select() also restart the Welch average and the zoom chain, so
+// no detector sets itself up on a frame.
+//
+// The deinterleave also keeps the largest sample of the input being collected.  In a quiet
+// room most inputs never come near an alarm level, ping_detect() then skips the block
+// detectors and reports no tone, counting gated and analysed inputs.  The streaming modes
+// (SDFT, Welch, zoom) need every frame for their history and are not gated.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+uint16_t PingGatePeak = PING_GATE_PEAK;
+volatile uint32_t PingGateGated = 0;			// inputs skipped by the energy gate
+volatile uint32_t PingGateAnalysed = 0;		// inputs the detector ran on
+
+static uint32_t CaptureFill = 0;
+static uint32_t CapturePeak = 0;				// largest sample of the input being collected
+static uint32_t InputPeak = 0;				// largest sample of the last complete input
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_detector_restart() function drops the input being collected and the history of
+// the streaming detectors, and sets the Welch average and the zoom chain up again.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ping_detector_restart(void)
+{
+	ping_welch_config(WelchFrames, WelchOverlapPercent);
+	ping_zoom_config(ZoomCenterHz, ZoomSpanHz);
+	CaptureFill = 0;
+	CapturePeak = 0;
+	ping_cfar_reset();
+	ping_mel_reset();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_fft_length_set() function changes the analysis length of every detector.
+//
+// Parameter(s):
+//
+//	nLength		power of two from PING_FFT_MIN_SIZE to PING_FFT_MAX_SIZE
+//
+// Returns false if the length is not supported.  A custom Goertzel bank is replaced by the
+// default bank for the new length.  The Goertzel coefficients, the sliding DFT twiddles, the
+// harmonic windows and the Welch hop are all computed here, so no detector sets itself up
+// on a frame.
+// Only call it between frames, BLE events go through ping_fft_length_request().
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool ping_fft_length_valid(uint32_t nLength)
+{
+	return (nLength >= PING_FFT_MIN_SIZE) && (nLength <= PING_FFT_MAX_SIZE) && ((nLength & (nLength - 1)) == 0);
+}
+
+bool ping_fft_length_set(uint32_t nLength)
+{
+	if(!ping_fft_length_valid(nLength))
+	{
+		return false;
+	}
+
+	FftLength = nLength;
+	ping_goertzel_config(NULL, 0, PING_BIN_SIZE_HZ);
+	ping_harmonic_config();
+
+	pFftInstance = &FftInstanceF32[FFT_LENGTH_INDEX(nLength)];
+	pFftInstanceQ15 = &FftInstanceQ15[FFT_LENGTH_INDEX(nLength)];
+	pFftInstanceQ31 = &FftInstanceQ31[FFT_LENGTH_INDEX(nLength)];
+	ping_detector_restart();
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_detector_select() function switches PingDetectorMode and restarts the capture,
+// since the new mode may want another input format or reuse DetectorScratch.
+//
+// Parameter(s):
+//
+//	nMode		one of the PING_DETECTOR_xxx modes
+//
+// Returns false if the mode does not exist.  Only call it between frames, BLE events go
+// through ping_detector_request().
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_detector_select(uint8_t nMode)
+{
+	if(nMode >= PING_DETECTOR_NUM_MODES)
+	{
+		return false;
+	}
+
+	PingDetectorMode = nMode;
+	ping_detector_restart();
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// Requests from BLE events
+//
+// The BLE commands run in the SoftDevice event handler, which preempts the analysis
+// interrupt, possibly half way through a frame; masking the interrupt would not stop a
+// frame already started.  The commands only check what they are asked for and post it,
+// the analysis interrupt applies it with ping_detector_apply() before its next frame.  A
+// request posted again before then replaces the first.
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+static volatile bool bLengthRequested = false;
+static volatile uint32_t RequestedLength;
+static volatile bool bModeRequested = false;
+static volatile uint8_t RequestedMode;
+static volatile bool bWelchRequested = false;
+static volatile uint8_t RequestedWelchFrames;
+static volatile uint8_t RequestedWelchOverlap;
+static volatile bool bZoomRequested = false;
+static volatile float RequestedZoomCenterHz;
+static volatile float RequestedZoomSpanHz;
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_fft_length_request() function posts a new analysis length, see
+// ping_fft_length_set().
+//
+// Returns false if the length is not supported
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_fft_length_request(uint32_t nLength)
+{
+	if(!ping_fft_length_valid(nLength))
+	{
+		return false;
+	}
+
+	RequestedLength = nLength;
+	bLengthRequested = true;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_detector_request() function posts a detector mode, see ping_detector_select().
+//
+// Returns false if the mode does not exist
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_detector_request(uint8_t nMode)
+{
+	if(nMode >= PING_DETECTOR_NUM_MODES)
+	{
+		return false;
+	}
+
+	RequestedMode = nMode;
+	bModeRequested = true;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_welch_request() function posts Welch parameters, see ping_welch_config().
+//
+// Returns false if a parameter is out of range
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_welch_request(uint8_t nFrames, uint8_t nOverlapPercent)
+{
+	if((nFrames == 0) || (nOverlapPercent > PING_WELCH_MAX_OVERLAP_PERCENT))
+	{
+		return false;
+	}
+
+	RequestedWelchFrames = nFrames;
+	RequestedWelchOverlap = nOverlapPercent;
+	bWelchRequested = true;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_zoom_request() function posts a zoom band, see ping_zoom_config().
+//
+// Returns the decimation the band will get, 0 if it is not supported
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_zoom_request(float fCenterHz, float fSpanHz)
+{
+	uint32_t Decimation = ping_zoom_decimation(fCenterHz, fSpanHz);
+
+	if(Decimation > 0)
+	{
+		RequestedZoomCenterHz = fCenterHz;
+		RequestedZoomSpanHz = fSpanHz;
+		bZoomRequested = true;
+	}
+
+	return Decimation;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_detector_apply() function applies the posted requests.  It is called by the
+// analysis interrupt before every frame, the BLE events that post them preempt it only
+// while the values are taken.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_detector_apply(void)
+{
+	bool bLength, bMode, bWelch, bZoom;
+	uint32_t nLength;
+	uint8_t nMode, nFrames, nOverlap;
+	float fCenterHz, fSpanHz;
+
+	CRITICAL_REGION_ENTER();
+	bLength = bLengthRequested;
+	nLength = RequestedLength;
+	bMode = bModeRequested;
+	nMode = RequestedMode;
+	bWelch = bWelchRequested;
+	nFrames = RequestedWelchFrames;
+	nOverlap = RequestedWelchOverlap;
+	bZoom = bZoomRequested;
+	fCenterHz = RequestedZoomCenterHz;
+	fSpanHz = RequestedZoomSpanHz;
+	bLengthRequested = false;
+	bModeRequested = false;
+	bWelchRequested = false;
+	bZoomRequested = false;
+	CRITICAL_REGION_EXIT();
+
+	if(bLength)
+	{
+		ping_fft_length_set(nLength);
+	}
+
+	if(bMode)
+	{
+		ping_detector_select(nMode);
+	}
+
+	if(bWelch)
+	{
+		ping_welch_config(nFrames, nOverlap);
+	}
+
+	if(bZoom)
+	{
+		ping_zoom_config(fCenterHz, fSpanHz);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The deinterleave kernels read the left channel straight out of a received I2S buffer, one
+// 32-bit stereo word per sample with the left sample in the low halfword, and write it in
+// the input format of a detector.  That is the only pass over the samples before the FFT,
+// so the energy gate takes the largest sample on the way.
+//
+// Parameter(s):
+//
+//	pStereo		received I2S buffer
+//	pDst			detector input
+//	nSamples		number of samples
+//
+// Returns the largest magnitude among the samples, in LSB
+//
+//////////////////////////////////////////////////////////////////////////////
+
+// Running extremes of the samples, kept as min and max so no sample needs an abs()
+#define PING_PEAK_TRACK(Sample)		{ nHi = MAX(nHi, (Sample)); nLo = MIN(nLo, (Sample)); }
+#define PING_PEAK_RESULT()				((uint32_t) MAX(nHi, -nLo))
+
+static uint32_t ping_deinterleave_f32(const uint32_t *pStereo, float *pDst, uint32_t nSamples)
+{
+	int32_t nHi = 0, nLo = 0;
+	int32_t nSample0, nSample1, nSample2, nSample3;
+
+	while(nSamples >= 4)
+	{
+		nSample0 = (int16_t) pStereo[0];
+		nSample1 = (int16_t) pStereo[1];
+		nSample2 = (int16_t) pStereo[2];
+		nSample3 = (int16_t) pStereo[3];
+		pDst[0] = (float) nSample0;
+		pDst[1] = (float) nSample1;
+		pDst[2] = (float) nSample2;
+		pDst[3] = (float) nSample3;
+		PING_PEAK_TRACK(nSample0);
+		PING_PEAK_TRACK(nSample1);
+		PING_PEAK_TRACK(nSample2);
+		PING_PEAK_TRACK(nSample3);
+		pStereo += 4;
+		pDst += 4;
+		nSamples -= 4;
+	}
+
+	while(nSamples > 0)
+	{
+		nSample0 = (int16_t) *pStereo++;
+		*pDst++ = (float) nSample0;
+		PING_PEAK_TRACK(nSample0);
+		nSamples--;
+	}
+
+	return PING_PEAK_RESULT();
+}
+
+static uint32_t ping_deinterleave_q15(const uint32_t *pStereo, q15_t *pDst, uint32_t nSamples)
+{
+	int32_t nHi = 0, nLo = 0;
+	int32_t nSample0;
+
+#if defined(ARM_MATH_DSP)
+	// Pack the left halfwords of two stereo words and store both samples at once
+	if((((uintptr_t) pDst) & 2) && (nSamples > 0))
+	{
+		nSample0 = (int16_t) *pStereo++;
+		*pDst++ = (q15_t) nSample0;
+		PING_PEAK_TRACK(nSample0);
+		nSamples--;
+	}
+
+	while(nSamples >= 4)
+	{
+		*__SIMD32(pDst)++ = __PKHBT(pStereo[0], pStereo[1], 16);
+		*__SIMD32(pDst)++ = __PKHBT(pStereo[2], pStereo[3], 16);
+		PING_PEAK_TRACK((int16_t) pStereo[0]);
+		PING_PEAK_TRACK((int16_t) pStereo[1]);
+		PING_PEAK_TRACK((int16_t) pStereo[2]);
+		PING_PEAK_TRACK((int16_t) pStereo[3]);
+		pStereo += 4;
+		nSamples -= 4;
+	}
+#endif
+
+	while(nSamples > 0)
+	{
+		nSample0 = (int16_t) *pStereo++;
+		*pDst++ = (q15_t) nSample0;
+		PING_PEAK_TRACK(nSample0);
+		nSamples--;
+	}
+
+	return PING_PEAK_RESULT();
+}
+
+static uint32_t ping_deinterleave_q31(const uint32_t *pStereo, q31_t *pDst, uint32_t nSamples)
+{
+	int32_t nHi = 0, nLo = 0;
+
+	// Shifting the whole stereo word drops the right channel and leaves Q15 as Q31
+	while(nSamples >= 4)
+	{
+		pDst[0] = (q31_t) (pStereo[0] << 16);
+		pDst[1] = (q31_t) (pStereo[1] << 16);
+		pDst[2] = (q31_t) (pStereo[2] << 16);
+		pDst[3] = (q31_t) (pStereo[3] << 16);
+		PING_PEAK_TRACK((int16_t) pStereo[0]);
+		PING_PEAK_TRACK((int16_t) pStereo[1]);
+		PING_PEAK_TRACK((int16_t) pStereo[2]);
+		PING_PEAK_TRACK((int16_t) pStereo[3]);
+		pStereo += 4;
+		pDst += 4;
+		nSamples -= 4;
+	}
+
+	while(nSamples > 0)
+	{
+		PING_PEAK_TRACK((int16_t) *pStereo);
+		*pDst++ = (q31_t) (*pStereo++ << 16);
+		nSamples--;
+	}
+
+	return PING_PEAK_RESULT();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_capture_push() function adds one received I2S buffer to the analysis input of the
+// selected detector.  It is called for every frame the processing loop takes from the
+// frame ring, so the detectors see every frame the ring kept.
+//
+// Parameter(s):
+//
+//	pStereo		received I2S buffer, one 32-bit stereo word per sample, left channel in
+//				the low halfword
+//	nSamples		number of stereo words in the buffer
+//
+// Returns true when the detector has a full input and ping_detect() should run
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_capture_push(const uint32_t *pStereo, uint32_t nSamples)
+{
+	uint32_t nPeak;
+
+	// The clock of the noise floor, see ping_cfar_update()
+	CaptureSamples += nSamples;
+
+	switch(PingDetectorMode)
+	{
+		case PING_DETECTOR_WELCH:
+		case PING_DETECTOR_ZOOM:
+			// These keep their own history, they only need the frame as float
+			nSamples = MIN(nSamples, PING_FFT_MAX_SIZE);
+			ping_deinterleave_f32(pStereo, fFFTin, nSamples);
+
+			if(PingDetectorMode == PING_DETECTOR_WELCH)
+			{
+				return ping_welch_push(fFFTin, nSamples);
+			}
+
+			return ping_zoom_push(fFFTin, nSamples);
+
+		case PING_DETECTOR_FFT_Q15:
+			nSamples = MIN(nSamples, FftLength - CaptureFill);
+			nPeak = ping_deinterleave_q15(pStereo, &DetectorScratch.q15.In[CaptureFill], nSamples);
+			break;
+
+		case PING_DETECTOR_FFT_Q31:
+			nSamples = MIN(nSamples, FftLength - CaptureFill);
+			nPeak = ping_deinterleave_q31(pStereo, &DetectorScratch.q31.In[CaptureFill], nSamples);
+			break;
+
+		default:
+			nSamples = MIN(nSamples, FftLength - CaptureFill);
+			nPeak = ping_deinterleave_f32(pStereo, &fFFTin[CaptureFill], nSamples);
+			break;
+	}
+
+	CaptureFill += nSamples;
+	CapturePeak = MAX(CapturePeak, nPeak);
+
+	if(CaptureFill < FftLength)
+	{
+		return false;
+	}
+
+	InputPeak = CapturePeak;
+	InputSamples = CaptureSamples;
+	CaptureFill = 0;
+	CapturePeak = 0;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_detect() function runs the detector selected by PingDetectorMode on the input
+// collected by ping_capture_push().  The block detectors skip an input quieter than
+// PingGatePeak.
+//
+// Parameter(s):
+//
+//	fBinSize		FFT bin size in Hz
+//
+// Returns the dominant FFT bin, in the same units as ping_fft().  The interpolated peak is
+// left in PingPeak.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_detect(float fBinSize)
+{
+	switch(PingDetectorMode)
+	{
+		case PING_DETECTOR_FFT:
+		case PING_DETECTOR_GOERTZEL:
+		case PING_DETECTOR_FFT_Q15:
+		case PING_DETECTOR_FFT_Q31:
+		case PING_DETECTOR_HARMONIC:
+			if(InputPeak < PingGatePeak)
+			{
+				// Too quiet to hold an alarm, the decoders still see the input as silence
+				PingGateGated++;
+				memset(&PingPeak, 0, sizeof(PingPeak));
+
+#if PING_NN_ENABLED
+				if((PingDetectorMode == PING_DETECTOR_FFT) && (FftLength == PING_MEL_FFT_SIZE))
+				{
+					ping_mel_silence();
+				}
+#endif
+
+				return PING_NO_DOMINANT_BIN;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	PingGateAnalysed++;
+
+	switch(PingDetectorMode)
+	{
+		case PING_DETECTOR_GOERTZEL:
+			return ping_goertzel(fBinSize);
+
+		case PING_DETECTOR_SDFT:
+		{
+			// Already up to date, ping_sdft_update() runs on every frame
+			PingPeak = SdftPeak;
+			return PingPeak.Index;
+		}
+
+		case PING_DETECTOR_FFT_Q15:
+			return ping_fft_q15(fBinSize);
+
+		case PING_DETECTOR_FFT_Q31:
+			return ping_fft_q31(fBinSize);
+
+		case PING_DETECTOR_WELCH:
+			// Peak of the last average latched by ping_welch_push()
+			PingPeak = WelchPeak;
+			return WelchDominantIndex;
+
+		case PING_DETECTOR_ZOOM:
+			// Peak of the last zoom spectrum analysed by ping_zoom_push()
+			PingPeak = ZoomPeak;
+			return ZoomDominantIndex;
+
+		case PING_DETECTOR_HARMONIC:
+			return ping_harmonic(fBinSize);
+
+		case PING_DETECTOR_FFT:
+		default:
+			return ping_fft(fBinSize);
+	}
+}
@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_fft.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_fft.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_FFT_H
+#define PING_FFT_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Detector modes, selected at run time through PingDetectorMode.  Every mode returns a
+// Dominant_Index-style bin number so main() does not care which one produced it.
+
+#define PING_DETECTOR_FFT				0	// Full FFT and argmax over all bins, kept for diagnostics
+#define PING_DETECTOR_GOERTZEL		1	// Goertzel filter bank at the target frequencies only
+#define PING_DETECTOR_SDFT			2	// Sliding DFT over the same bins, updated on every I2S block
+#define PING_DETECTOR_FFT_Q15			3	// Fixed-point FFT straight from the int16 capture, Q15 kernels
+#define PING_DETECTOR_FFT_Q31			4	// Fixed-point FFT straight from the int16 capture, Q31 kernels
+#define PING_DETECTOR_WELCH			5	// Peak of a Welch averaged power spectrum, Hann windowed and overlapped
+#define PING_DETECTOR_ZOOM			6	// Mix-down, decimation and a short complex FFT over the alarm band
+#define PING_DETECTOR_HARMONIC		7	// Full FFT, the fundamental whose harmonics hold the most energy
+
+#define PING_DETECTOR_NUM_MODES		8
+
+// Returned by the filter bank detectors when no monitored bin dominates the frame
+
+#define PING_NO_DOMINANT_BIN			0
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Interpolated spectral peak.  Index is the peak bin, PING_NO_DOMINANT_BIN (with the other
+// fields zero) when the detector found none.
+
+typedef struct
+{
+	uint32_t Index;
+	float fFrequency;		// Hz
+	float fAmplitude;		// amplitude of the sinusoid, input LSB
+} ping_peak_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern uint8_t PingDetectorMode;
+extern uint32_t FftLength;
+
+extern ping_peak_t PingPeak;
+
+extern float GoertzelMagnitude[PING_GOERTZEL_MAX_FILTERS];
+
+extern volatile uint32_t SdftDominantIndex;
+
+extern float WelchPsd[PING_FFT_MAX_SIZE / 2];
+extern uint8_t WelchFrames;
+extern uint8_t WelchOverlapPercent;
+
+extern float ZoomCenterHz;
+extern float ZoomSpanHz;
+extern uint32_t ZoomDecimation;
+
+extern uint16_t PingGatePeak;
+extern volatile uint32_t PingGateGated;
+extern volatile uint32_t PingGateAnalysed;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ping_peak_ratio(float fLeft, float fCentre, float fRight, uint32_t Index, float fBinSize, float fScale, ping_peak_t *pPeak);
+extern bool ping_goertzel_config(const float *pFrequencies, uint8_t nFilters, float fBinSize);
+extern uint32_t ping_goertzel(float fBinSize);
+extern void ping_sdft_update(const int16_t *pStereo, uint32_t nSamples);
+extern uint32_t ping_harmonic(float fBinSize);
+extern uint32_t ping_fft_q15(float fBinSize);
+extern uint32_t ping_fft_q31(float fBinSize);
+extern bool ping_welch_config(uint8_t nFrames, uint8_t nOverlapPercent);
+extern bool ping_welch_push(const float *pSamples, uint32_t nSamples);
+extern bool ping_zoom_config(float fCenterHz, float fSpanHz);
+extern bool ping_zoom_push(const float *pSamples, uint32_t nSamples);
+extern bool ping_fft_length_set(uint32_t nLength);
+extern bool ping_detector_select(uint8_t nMode);
+extern bool ping_fft_length_request(uint32_t nLength);
+extern bool ping_detector_request(uint8_t nMode);
+extern bool ping_welch_request(uint8_t nFrames, uint8_t nOverlapPercent);
+extern uint32_t ping_zoom_request(float fCenterHz, float fSpanHz);
+extern void ping_detector_apply(void);
+extern bool ping_capture_push(const uint32_t *pStereo, uint32_t nSamples);
+extern uint32_t ping_detect(float fBinSize);
+
+#endif //  PING_FFT_H
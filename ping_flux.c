@@ -0,0 +1,283 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_flux.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Pulse onset and offset detector from band-limited spectral flux
+//
+//	The temporal decoders measure pulses and gaps, and they can only be as exact as the tone
+//	decisions they are fed, one per detector input.  This detector finds the edges of the
+//	pulses on its own, on every I2S frame whatever the detector mode, so the edges come with
+//	one hop of resolution: PING_FLUX_HOP samples, 8.2 ms.
+//
+//	Every frame is taken through a Goertzel filter per FFT bin of the frame length over the
+//	alarm band and PING_FLUX_GUARD_BINS either side, 5 bins at the default.  The spectral
+//	flux is the rise of the bin magnitudes from the previous frame, summed over the bins
+//	that rose.  An alarm pulse moves one or two bins by far
+//	more than the noise does, while noise moves all of them a little; with only the band
+//	summed, sounds elsewhere in the spectrum do not count at all.
+//
+//	The band floor is an exponential average of the band magnitude outside pulses.  An
+//	onset is a rise of PingFluxOnset times the floor within one hop, an offset a fall of
+//	PING_FLUX_OFFSET_FRACTION of the pulse in its strongest bin, with the band falling too.
+//	The fall is measured in that bin because a tone cut short within a hop spreads over all
+//	the bins: with a few ms of the pulse left the band as a whole has hardly fallen.
+//
+//	An edge inside a hop splits its change between that hop and the next and one of them
+//	always sees at least half, so a pulse is certain to be found once it rises twice the
+//	onset over the floor.  A pulse that fades out instead of stopping ends once it is back
+//	within a quarter of its rise from the floor.
+//
+//	The edge time is counted in samples, not read from the RTC, so the intervals between
+//	edges are exact whatever the interrupt latency.  The cost is 5 multiply-adds per sample
+//	and a square root per bin and frame.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "nordic_common.h"
+#include "arm_math.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+
+#include "ping_flux.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Rise over the floor an onset needs, as a multiple of the floor, PING_FLUX_ONSET_DB from
+// ping_flux_reset() on, see ping_flux_onset_set()
+float PingFluxOnset = 0.0f;
+
+ping_flux_edge_t PingFluxEdge;			// last edge found
+bool bPingFluxPulse = false;			// between an onset and its offset
+float PingFluxFloor = 0.0f;			// band magnitude outside pulses, amplitude LSB
+volatile uint32_t PingFluxOnsets = 0;
+volatile uint32_t PingFluxOffsets = 0;
+
+static float FluxCoeff[PING_FLUX_MAX_BINS];
+static float FluxMagnitude[PING_FLUX_MAX_BINS];	// previous frame
+static uint32_t nFluxBins = 0;
+static uint32_t nFluxPulseBin = 0;			// strongest bin of the current pulse
+static float fFluxPeak = 0.0f;				// highest magnitude of that bin within the pulse
+static float fFluxLevel = 0.0f;				// band magnitude of the previous frame
+static bool bFluxSeeded = false;
+static uint32_t FluxOriginMs = 0;
+static uint32_t FluxHops = 0;				// frames since the reset
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_flux_reset() function sets up the filters for the alarm band and starts a new
+// stream, with no pulse and no floor yet and the onset of ping_config.h.
+//
+// Parameter(s):
+//
+//	OriginMs		time of the first sample of the stream, the edge times count from it
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_flux_reset(uint32_t OriginMs)
+{
+	float fBinSize = (float) PING_SAMPLE_RATE_HZ / PING_FLUX_HOP;
+	uint32_t nLo, nHi, nIdx;
+
+	nLo = (uint32_t) (PING_ALARM_FREQ_LO_HZ / fBinSize + 0.5f);
+	nHi = (uint32_t) (PING_ALARM_FREQ_HI_HZ / fBinSize + 0.5f);
+	nLo = (nLo > PING_FLUX_GUARD_BINS) ? nLo - PING_FLUX_GUARD_BINS : 1;
+	nHi = MIN(nHi + PING_FLUX_GUARD_BINS, PING_FLUX_HOP / 2 - 1);
+
+	nFluxBins = MIN(nHi - nLo + 1, PING_FLUX_MAX_BINS);
+
+	for(nIdx=0; nIdx < nFluxBins; nIdx++)
+	{
+		FluxCoeff[nIdx] = 2.0f * arm_cos_f32(2.0f * PI * (nLo + nIdx) / PING_FLUX_HOP);
+	}
+
+	ping_flux_onset_set(PING_FLUX_ONSET_DB);
+
+	memset(FluxMagnitude, 0, sizeof(FluxMagnitude));
+	memset(&PingFluxEdge, 0, sizeof(PingFluxEdge));
+	bPingFluxPulse = false;
+	PingFluxFloor = 0.0f;
+	fFluxPeak = 0.0f;
+	bFluxSeeded = false;
+	FluxOriginMs = OriginMs;
+	FluxHops = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_flux_onset_set() function sets how far the band must rise over its floor within
+// one hop to start a pulse.
+//
+// Parameter(s):
+//
+//	fOnsetDb		rise in dB of magnitude, PING_FLUX_MIN_ONSET_DB to PING_FLUX_MAX_ONSET_DB
+//
+// Returns false if the rise is out of range
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_flux_onset_set(float fOnsetDb)
+{
+	if((fOnsetDb < PING_FLUX_MIN_ONSET_DB) || (fOnsetDb > PING_FLUX_MAX_ONSET_DB))
+	{
+		return false;
+	}
+
+	PingFluxOnset = powf(10.0f, fOnsetDb / 20.0f) - 1.0f;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_flux_push() function takes the next I2S frame of the stream and looks for an
+// edge between it and the frame before.  Frames must arrive in order; push each frame the
+// ring dropped as an empty one (NULL, 0) so the edge times stay in step with the audio.
+//
+// Parameter(s):
+//
+//	pStereo		received I2S buffer, one 32-bit stereo word per sample, left channel in
+//				the low halfword, NULL for a dropped frame
+//	nSamples		number of stereo words, frames of another length than PING_FLUX_HOP only
+//				advance the time
+//
+// Returns one of the PING_FLUX_EDGE_xxx edges, the edge itself is left in PingFluxEdge
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint8_t ping_flux_push(const uint32_t *pStereo, uint32_t nSamples)
+{
+	float s0[PING_FLUX_MAX_BINS], s1[PING_FLUX_MAX_BINS], s2[PING_FLUX_MAX_BINS];
+	float fSample, fMagnitude, fRise, fLevel, fTrack, fBinFloor, fPulse, fStrongest;
+	uint32_t nIdx, nBin, nStrongest;
+	uint8_t Edge = PING_FLUX_EDGE_NONE;
+
+	FluxHops++;
+
+	if((nSamples != PING_FLUX_HOP) || (nFluxBins == 0))
+	{
+		return PING_FLUX_EDGE_NONE;
+	}
+
+	memset(s1, 0, sizeof(s1));
+	memset(s2, 0, sizeof(s2));
+
+	for(nIdx=0; nIdx < PING_FLUX_HOP; nIdx++)
+	{
+		fSample = (float) (int16_t) pStereo[nIdx];
+
+		for(nBin=0; nBin < nFluxBins; nBin++)
+		{
+			s0[nBin] = fSample + FluxCoeff[nBin] * s1[nBin] - s2[nBin];
+			s2[nBin] = s1[nBin];
+			s1[nBin] = s0[nBin];
+		}
+	}
+
+	// Magnitudes scaled to the amplitude of a sinusoid on the bin, and the rectified flux
+	fRise = 0.0f;
+	fLevel = 0.0f;
+	fPulse = 0.0f;
+	fStrongest = 0.0f;
+	nStrongest = 0;
+
+	for(nBin=0; nBin < nFluxBins; nBin++)
+	{
+		fMagnitude = s1[nBin] * s1[nBin] + s2[nBin] * s2[nBin] - FluxCoeff[nBin] * s1[nBin] * s2[nBin];
+		fMagnitude = sqrtf(MAX(fMagnitude, 0.0f)) * (2.0f / PING_FLUX_HOP);
+
+		if(fMagnitude > FluxMagnitude[nBin])
+		{
+			fRise += fMagnitude - FluxMagnitude[nBin];
+		}
+
+		if(nBin == nFluxPulseBin)
+		{
+			fPulse = FluxMagnitude[nBin] - fMagnitude;
+		}
+
+		if(fMagnitude > fStrongest)
+		{
+			fStrongest = fMagnitude;
+			nStrongest = nBin;
+		}
+
+		FluxMagnitude[nBin] = fMagnitude;
+		fLevel += fMagnitude;
+	}
+
+	if(!bFluxSeeded)
+	{
+		PingFluxFloor = fLevel;
+		fFluxLevel = fLevel;
+		bFluxSeeded = true;
+		return PING_FLUX_EDGE_NONE;
+	}
+
+	fTrack = MIN(1.0f, PING_FLUX_HOP_MS / PING_FLUX_TRACK_MS);
+	fBinFloor = PingFluxFloor / nFluxBins;
+
+	if(!bPingFluxPulse)
+	{
+		if((fRise >= PingFluxOnset * PingFluxFloor) && (fLevel >= PingFluxFloor + PING_FLUX_MIN_LEVEL))
+		{
+			bPingFluxPulse = true;
+			fFluxPeak = 0.0f;
+			Edge = PING_FLUX_EDGE_ONSET;
+			PingFluxOnsets++;
+		}
+		else
+		{
+			PingFluxFloor += fTrack * (fLevel - PingFluxFloor);
+		}
+	}
+	else
+	{
+		// The band falls as a whole at an offset; a tone that only moves between bins, as
+		// one cut off by the start of the onset hop does on the next hop, is no offset
+		if(((fPulse >= PING_FLUX_OFFSET_FRACTION * (fFluxPeak - fBinFloor)) && (fLevel < fFluxLevel)) ||
+			((fStrongest - fBinFloor) * 4.0f <= fFluxPeak - fBinFloor))
+		{
+			bPingFluxPulse = false;
+			Edge = PING_FLUX_EDGE_OFFSET;
+			PingFluxOffsets++;
+		}
+		else
+		{
+			// Forty times slower within a pulse, so a lasting rise of the noise still ends it
+			PingFluxFloor += fTrack * (fLevel - PingFluxFloor) / 40.0f;
+		}
+	}
+
+	if(bPingFluxPulse && (fStrongest > fFluxPeak))
+	{
+		// The offset is watched in the strongest bin of the pulse so far
+		fFluxPeak = fStrongest;
+		nFluxPulseBin = nStrongest;
+	}
+
+	fFluxLevel = fLevel;
+
+	if(Edge != PING_FLUX_EDGE_NONE)
+	{
+		PingFluxEdge.Type = Edge;
+		PingFluxEdge.TimeMs = FluxOriginMs + (uint32_t) (((uint64_t) FluxHops * PING_FLUX_HOP - PING_FLUX_HOP / 2) * 1000 / PING_SAMPLE_RATE_HZ);
+		PingFluxEdge.fLevel = fLevel;
+	}
+
+	return Edge;
+}
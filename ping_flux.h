@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_flux.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_flux.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_FLUX_H
+#define PING_FLUX_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Edges returned by ping_flux_push()
+
+#define PING_FLUX_EDGE_NONE			0
+#define PING_FLUX_EDGE_ONSET			1	// The band has just risen, a pulse starts
+#define PING_FLUX_EDGE_OFFSET		2	// The band has just fallen back, the pulse ends
+
+// One hop is one I2S frame
+
+#define PING_FLUX_HOP				AUDIO_FRAME_NUM_SAMPLES
+#define PING_FLUX_HOP_MS			((float) PING_FLUX_HOP * 1000.0f / PING_SAMPLE_RATE_HZ)
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// A pulse edge.  TimeMs is the middle of the hop the edge was found in, counted in samples
+// from the origin given to ping_flux_reset().
+
+typedef struct
+{
+	uint8_t Type;			// PING_FLUX_EDGE_xxx
+	uint32_t TimeMs;
+	float fLevel;			// band magnitude after the edge, amplitude LSB
+} ping_flux_edge_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern float PingFluxOnset;
+extern ping_flux_edge_t PingFluxEdge;
+extern bool bPingFluxPulse;
+extern float PingFluxFloor;
+extern volatile uint32_t PingFluxOnsets;
+extern volatile uint32_t PingFluxOffsets;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ping_flux_reset(uint32_t OriginMs);
+extern bool ping_flux_onset_set(float fOnsetDb);
+extern uint8_t ping_flux_push(const uint32_t *pStereo, uint32_t nSamples);
+
+#endif //  PING_FLUX_H
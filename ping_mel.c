@@ -0,0 +1,166 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_mel.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Log-mel energies and MFCCs from the FFT magnitude spectrum
+//
+//	Features for classifying sound events other than the alarm tones.  ping_fft() hands its
+//	magnitude spectrum over whenever FftLength is PING_MEL_FFT_SIZE, and every spectrum
+//	becomes one row of PingMfcc, so the features are always up to date without another FFT:
+//
+//		PingLogMel		natural log of the power in each of the PING_MEL_BANDS bands
+//		PingMfcc			DCT of PingLogMel, the last PING_MFCC_HISTORY spectra with the
+//						next row to be written at PingMfccHead
+//
+//	The filterbank and the DCT are constant tables in ping_tables.c.  The bands are kept
+//	sparse, so a spectrum costs PING_MEL_WEIGHTS multiply-adds for the bands, PING_MEL_BANDS
+//	logarithms and PING_MEL_BANDS * PING_MFCC_COEFFS multiply-adds for the DCT.  The
+//	classifier of ping_nn.c is fed from here.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_tables.h"
+
+#include "ping_mel.h"
+#include "ping_nn.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+float PingLogMel[PING_MEL_BANDS];
+float PingMfcc[PING_MFCC_HISTORY][PING_MFCC_COEFFS];
+uint32_t PingMfccHead = 0;
+volatile uint32_t PingMfccFrames = 0;		// spectra processed since the last reset
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_mel_reset() function clears the feature history.  Called whenever the analysis
+// length or the detector changes, the rows before would not line up in time.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_mel_reset(void)
+{
+	memset(PingLogMel, 0, sizeof(PingLogMel));
+	memset(PingMfcc, 0, sizeof(PingMfcc));
+	PingMfccHead = 0;
+	PingMfccFrames = 0;
+
+#if PING_NN_ENABLED
+	ping_nn_reset();
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_mfcc_push() function turns PingLogMel into the next row of PingMfcc.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void ping_mfcc_push(void)
+{
+	const float *pDct = PingMfccDct;
+	float *pRow = PingMfcc[PingMfccHead];
+	float fSum;
+	uint32_t nCoeff, nBand;
+
+	for(nCoeff=0; nCoeff < PING_MFCC_COEFFS; nCoeff++)
+	{
+		fSum = 0.0f;
+
+		for(nBand=0; nBand < PING_MEL_BANDS; nBand++)
+		{
+			fSum += pDct[nBand] * PingLogMel[nBand];
+		}
+
+		pRow[nCoeff] = fSum;
+		pDct += PING_MEL_BANDS;
+	}
+
+	PingMfccHead = (PingMfccHead + 1 < PING_MFCC_HISTORY) ? PingMfccHead + 1 : 0;
+	PingMfccFrames++;
+
+#if PING_NN_ENABLED
+	// The classifier takes its input from here every few rows
+	ping_nn_push();
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_mel_update() function adds one spectrum to the features.
+//
+// Parameter(s):
+//
+//	pMagnitude		magnitude spectrum, as from arm_cmplx_mag_f32()
+//	nBins			number of bins, must be PING_MEL_FFT_SIZE / 2
+//
+// Returns false, leaving the features alone, if the spectrum has another length
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_mel_update(const float *pMagnitude, uint32_t nBins)
+{
+	const float *pWeight = PingMelWeight;
+	const float *pBin;
+	float fPower;
+	uint32_t nBand, nIdx, nCount;
+
+	if(nBins != PING_MEL_FFT_SIZE / 2)
+	{
+		return false;
+	}
+
+	for(nBand=0; nBand < PING_MEL_BANDS; nBand++)
+	{
+		pBin = &pMagnitude[PingMelFirstBin[nBand]];
+		nCount = PingMelBinCount[nBand];
+		fPower = 0.0f;
+
+		for(nIdx=0; nIdx < nCount; nIdx++)
+		{
+			fPower += pWeight[nIdx] * pBin[nIdx] * pBin[nIdx];
+		}
+
+		pWeight += nCount;
+		PingLogMel[nBand] = logf(fPower + PING_MEL_POWER_FLOOR);
+	}
+
+	ping_mfcc_push();
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_mel_silence() function adds a silent spectrum to the features, for inputs the
+// energy gate kept from the FFT, so the history stays one row per input.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_mel_silence(void)
+{
+	uint32_t nBand;
+
+	for(nBand=0; nBand < PING_MEL_BANDS; nBand++)
+	{
+		PingLogMel[nBand] = logf(PING_MEL_POWER_FLOOR);
+	}
+
+	ping_mfcc_push();
+}
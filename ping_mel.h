@@ -0,0 +1,31 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_mel.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_mel.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_MEL_H
+#define PING_MEL_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern float PingLogMel[PING_MEL_BANDS];
+extern float PingMfcc[PING_MFCC_HISTORY][PING_MFCC_COEFFS];
+extern uint32_t PingMfccHead;
+extern volatile uint32_t PingMfccFrames;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ping_mel_reset(void);
+extern bool ping_mel_update(const float *pMagnitude, uint32_t nBins);
+extern void ping_mel_silence(void);
+
+#endif //  PING_MEL_H
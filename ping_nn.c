@@ -0,0 +1,283 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_nn.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Sound event classifier, an int8 DS-CNN on the MFCC history
+//
+//	A peak in the alarm band can be a smoke alarm or a microwave at the same pitch; the
+//	classifier looks at the whole MFCC history of ping_mel.c instead and scores every class
+//	of ping_nn.h.  The network is a small DS-CNN run with the CMSIS-NN q7 HWC kernels, its
+//	weights are const arrays in ping_nn_weights.c and its activations live in one static
+//	arena, so nothing is allocated at run time.
+//
+//	Every PING_NN_HOP_ROWS feature rows ping_nn_push(), called in the analysis interrupt,
+//	quantises the history into the network input.  The inference takes tens of ms, far
+//	longer than a frame, so it runs in the main loop from ping_nn_poll() and the analysis
+//	interrupt keeps going meanwhile; a hop that comes while the previous one is still
+//	pending is skipped and counted.  The scores, softmax outputs in q7, are left in
+//	PingNnScores.
+//
+//	The host build runs the same kernels on the same integers, so its scores are bit-exact
+//	with the target.  ping_nn_selftest() runs PingNnTestInput through every layer and
+//	returns a checksum of the results; the target logs it at boot and the host benchmark
+//	reports it, and both must agree with PingNnSelfTestExpected, which the generator of the
+//	weights works out on its own.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "nordic_common.h"
+
+#include "arm_math.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_tables.h"
+#include "ping_mel.h"
+#include "ping_profile.h"
+
+#include "ping_nn.h"
+
+// Left out with PING_NN_ENABLED at 0, the build then needs no CMSIS-NN
+#if PING_NN_ENABLED
+
+#include "arm_nnfunctions.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+const char * const PingNnClassName[PING_NN_CLASSES] =
+{
+	"background",
+	"smoke_alarm",
+	"co_alarm",
+	"glass_break",
+	"baby_cry",
+	"dog_bark",
+	"appliance",
+};
+
+int8_t PingNnScores[PING_NN_CLASSES];
+volatile uint32_t PingNnInferences = 0;		// inferences run since boot
+volatile uint32_t PingNnSkipped = 0;			// hops dropped because an inference was pending
+uint32_t PingNnSelfTest = 0;					// ping_nn_selftest() result at boot
+
+// Activation arena.  Layers alternate between the two maps; the pooled vector and the
+// logits go to the start of whichever map is free.
+static struct
+{
+	q15_t Col[PING_NN_COL_SIZE];
+	q7_t Map[2][PING_NN_MAP_SIZE];
+} NnArena;
+
+// Network input, written by ping_nn_push() and read by the inference while bNnPending
+static q7_t NnInput[PING_NN_INPUT_SIZE];
+static volatile bool bNnPending = false;
+static uint32_t NnRows = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_nn_run() function runs the network on one input.
+//
+// Parameter(s):
+//
+//	pInput		PING_NN_IN_Y x PING_NN_IN_X input in q7
+//	pLogits		receives the PING_NN_CLASSES outputs of the fully connected layer
+//	pScores		receives their softmax
+//
+// Returns the map after the last block, for the self test
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static const q7_t *ping_nn_run(const q7_t *pInput, q7_t *pLogits, q7_t *pScores)
+{
+	q7_t *pIn = NnArena.Map[0];
+	q7_t *pOut = NnArena.Map[1];
+	q7_t *pPooled;
+	int32_t Sum;
+	uint32_t nBlock, nChannel, nPos;
+
+	arm_convolve_HWC_q7_basic_nonsquare(pInput, PING_NN_IN_X, PING_NN_IN_Y, 1,
+		PingNnConv1Weight, PING_NN_CHANNELS, PING_NN_CONV1_KX, PING_NN_CONV1_KY,
+		PING_NN_CONV1_PAD_X, PING_NN_CONV1_PAD_Y, PING_NN_CONV1_STRIDE, PING_NN_CONV1_STRIDE,
+		PingNnConv1Bias, PingNnShift[PING_NN_LAYER_CONV1][0], PingNnShift[PING_NN_LAYER_CONV1][1],
+		pIn, PING_NN_MAP_X, PING_NN_MAP_Y, NnArena.Col, NULL);
+	arm_relu_q7(pIn, PING_NN_MAP_SIZE);
+
+	for(nBlock=0; nBlock < PING_NN_DS_BLOCKS; nBlock++)
+	{
+		arm_depthwise_separable_conv_HWC_q7_nonsquare(pIn, PING_NN_MAP_X, PING_NN_MAP_Y, PING_NN_CHANNELS,
+			PingNnDwWeight[nBlock], PING_NN_CHANNELS, PING_NN_DW_K, PING_NN_DW_K,
+			PING_NN_DW_K / 2, PING_NN_DW_K / 2, 1, 1,
+			PingNnDwBias[nBlock], PingNnShift[PING_NN_LAYER_DW(nBlock)][0], PingNnShift[PING_NN_LAYER_DW(nBlock)][1],
+			pOut, PING_NN_MAP_X, PING_NN_MAP_Y, NnArena.Col, NULL);
+		arm_relu_q7(pOut, PING_NN_MAP_SIZE);
+
+		arm_convolve_1x1_HWC_q7_fast_nonsquare(pOut, PING_NN_MAP_X, PING_NN_MAP_Y, PING_NN_CHANNELS,
+			PingNnPwWeight[nBlock], PING_NN_CHANNELS, 1, 1, 0, 0, 1, 1,
+			PingNnPwBias[nBlock], PingNnShift[PING_NN_LAYER_PW(nBlock)][0], PingNnShift[PING_NN_LAYER_PW(nBlock)][1],
+			pIn, PING_NN_MAP_X, PING_NN_MAP_Y, NnArena.Col, NULL);
+		arm_relu_q7(pIn, PING_NN_MAP_SIZE);
+	}
+
+	// Global average pooling, the activations are non-negative after the ReLU
+	pPooled = pOut;
+
+	for(nChannel=0; nChannel < PING_NN_CHANNELS; nChannel++)
+	{
+		Sum = 0;
+
+		for(nPos=0; nPos < PING_NN_MAP_Y * PING_NN_MAP_X; nPos++)
+		{
+			Sum += pIn[nPos * PING_NN_CHANNELS + nChannel];
+		}
+
+		pPooled[nChannel] = (q7_t) ((Sum + PING_NN_MAP_Y * PING_NN_MAP_X / 2) / (PING_NN_MAP_Y * PING_NN_MAP_X));
+	}
+
+	arm_fully_connected_q7(pPooled, PingNnFcWeight, PING_NN_CHANNELS, PING_NN_CLASSES,
+		PingNnShift[PING_NN_LAYER_FC][0], PingNnShift[PING_NN_LAYER_FC][1], PingNnFcBias, pLogits, NnArena.Col);
+
+	arm_softmax_q7(pLogits, PING_NN_CLASSES, pScores);
+
+	return pIn;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_nn_reset() function restarts the hop count, called with ping_mel_reset().
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_nn_reset(void)
+{
+	NnRows = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_nn_push() function is called after every new row of PingMfcc.  Every
+// PING_NN_HOP_ROWS rows, once the history is full, it quantises the history, oldest row
+// first, into the network input and leaves the inference to ping_nn_poll().
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_nn_push(void)
+{
+	const float *pRow;
+	q7_t *pInput = NnInput;
+	int32_t nValue;
+	uint32_t nRow, nCoeff, nIdx;
+
+	if(++NnRows < PING_NN_HOP_ROWS)
+	{
+		return;
+	}
+
+	NnRows = 0;
+
+	if(PingMfccFrames < PING_MFCC_HISTORY)
+	{
+		return;
+	}
+
+	if(bNnPending)
+	{
+		PingNnSkipped++;
+		return;
+	}
+
+	nRow = PingMfccHead;
+
+	for(nIdx=0; nIdx < PING_MFCC_HISTORY; nIdx++)
+	{
+		pRow = PingMfcc[nRow];
+
+		for(nCoeff=0; nCoeff < PING_MFCC_COEFFS; nCoeff++)
+		{
+			nValue = (int32_t) lrintf(pRow[nCoeff] * (1 << PING_NN_INPUT_FRAC_BITS));
+			*pInput++ = (q7_t) MAX(-128, MIN(127, nValue));
+		}
+
+		nRow = (nRow + 1 < PING_MFCC_HISTORY) ? nRow + 1 : 0;
+	}
+
+	bNnPending = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_nn_poll() function runs a pending inference.  Called from the main loop.
+//
+// Returns true if PingNnScores was updated
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_nn_poll(void)
+{
+	q7_t Logits[PING_NN_CLASSES];
+
+	if(!bNnPending)
+	{
+		return false;
+	}
+
+	PING_PROFILE_BEGIN(PING_PROFILE_NN);
+	ping_nn_run(NnInput, Logits, PingNnScores);
+	PING_PROFILE_END(PING_PROFILE_NN);
+
+	PingNnInferences++;
+	bNnPending = false;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_nn_selftest() function runs PingNnTestInput through the network.
+//
+// Returns a 32-bit FNV-1a hash of the map after the last block, the logits and the scores,
+// also left in PingNnSelfTest.  It shares the arena with ping_nn_poll(), call it from the
+// main loop or before the analysis starts.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_nn_selftest(void)
+{
+	q7_t Logits[PING_NN_CLASSES];
+	q7_t Scores[PING_NN_CLASSES];
+	const q7_t *pMap;
+	uint32_t Hash = 2166136261u;
+	uint32_t nIdx;
+
+	pMap = ping_nn_run(PingNnTestInput, Logits, Scores);
+
+	for(nIdx=0; nIdx < PING_NN_MAP_SIZE; nIdx++)
+	{
+		Hash = (Hash ^ (uint8_t) pMap[nIdx]) * 16777619u;
+	}
+
+	for(nIdx=0; nIdx < PING_NN_CLASSES; nIdx++)
+	{
+		Hash = (Hash ^ (uint8_t) Logits[nIdx]) * 16777619u;
+		Hash = (Hash ^ (uint8_t) Scores[nIdx]) * 16777619u;
+	}
+
+	PingNnSelfTest = Hash;
+
+	return Hash;
+}
+
+#endif // PING_NN_ENABLED
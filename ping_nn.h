@@ -0,0 +1,106 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_nn.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_nn.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_NN_H
+#define PING_NN_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Sound event classes, see PingNnClassName[]
+
+#define PING_NN_CLASS_BACKGROUND		0
+#define PING_NN_CLASS_SMOKE_ALARM	1
+#define PING_NN_CLASS_CO_ALARM		2
+#define PING_NN_CLASS_GLASS_BREAK	3
+#define PING_NN_CLASS_BABY_CRY		4
+#define PING_NN_CLASS_DOG_BARK		5
+#define PING_NN_CLASS_APPLIANCE		6
+
+#define PING_NN_CLASSES				7
+
+// DS-CNN topology.  The input is the MFCC history, PING_NN_IN_Y rows of time by PING_NN_IN_X
+// coefficients, one channel.  A strided convolution brings it to PING_NN_MAP_Y x PING_NN_MAP_X
+// x PING_NN_CHANNELS, PING_NN_DS_BLOCKS depthwise 3x3 plus pointwise 1x1 blocks keep that
+// shape, then global average pooling and a fully connected layer give the class scores.
+// tools/ping_nn_weights.py must agree with all of these.
+
+#define PING_NN_IN_Y					PING_MFCC_HISTORY
+#define PING_NN_IN_X					PING_MFCC_COEFFS
+#define PING_NN_INPUT_SIZE			(PING_NN_IN_Y * PING_NN_IN_X)
+
+#define PING_NN_CHANNELS				32
+#define PING_NN_CONV1_KY				10
+#define PING_NN_CONV1_KX				4
+#define PING_NN_CONV1_STRIDE			2
+#define PING_NN_CONV1_PAD_Y			4
+#define PING_NN_CONV1_PAD_X			1
+#define PING_NN_MAP_Y				((PING_NN_IN_Y + 2 * PING_NN_CONV1_PAD_Y - PING_NN_CONV1_KY) / PING_NN_CONV1_STRIDE + 1)
+#define PING_NN_MAP_X				((PING_NN_IN_X + 2 * PING_NN_CONV1_PAD_X - PING_NN_CONV1_KX) / PING_NN_CONV1_STRIDE + 1)
+#define PING_NN_MAP_SIZE				(PING_NN_MAP_Y * PING_NN_MAP_X * PING_NN_CHANNELS)
+
+#define PING_NN_DS_BLOCKS			4
+#define PING_NN_DW_K					3
+
+// Layers, in the order of PingNnShift[]: the first convolution, depthwise and pointwise of
+// each block, the fully connected layer
+
+#define PING_NN_LAYER_CONV1			0
+#define PING_NN_LAYER_DW(nBlock)		(1 + 2 * (nBlock))
+#define PING_NN_LAYER_PW(nBlock)		(2 + 2 * (nBlock))
+#define PING_NN_LAYER_FC				(1 + 2 * PING_NN_DS_BLOCKS)
+
+#define PING_NN_LAYERS				(2 + 2 * PING_NN_DS_BLOCKS)
+
+// im2col buffer of the kernels in q15, the depthwise convolution needing the most, and the
+// RAM of the arena plus the network input
+#define PING_NN_COL_SIZE				(2 * PING_NN_CHANNELS * PING_NN_DW_K * PING_NN_DW_K)
+#define PING_NN_RAM_BYTES			(PING_NN_COL_SIZE * 2 + PING_NN_MAP_SIZE * 2 + PING_NN_INPUT_SIZE)
+
+// Multiply-adds of one inference
+#define PING_NN_MACS					(PING_NN_MAP_Y * PING_NN_MAP_X * PING_NN_CHANNELS * \
+										(PING_NN_CONV1_KY * PING_NN_CONV1_KX + \
+										PING_NN_DS_BLOCKS * (PING_NN_DW_K * PING_NN_DW_K + PING_NN_CHANNELS)) + \
+										PING_NN_CHANNELS * PING_NN_CLASSES)
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// ping_nn_weights.c, generated by tools/ping_nn_weights.py
+extern const int8_t PingNnConv1Weight[PING_NN_CHANNELS * PING_NN_CONV1_KY * PING_NN_CONV1_KX];
+extern const int8_t PingNnConv1Bias[PING_NN_CHANNELS];
+extern const int8_t PingNnDwWeight[PING_NN_DS_BLOCKS][PING_NN_DW_K * PING_NN_DW_K * PING_NN_CHANNELS];
+extern const int8_t PingNnDwBias[PING_NN_DS_BLOCKS][PING_NN_CHANNELS];
+extern const int8_t PingNnPwWeight[PING_NN_DS_BLOCKS][PING_NN_CHANNELS * PING_NN_CHANNELS];
+extern const int8_t PingNnPwBias[PING_NN_DS_BLOCKS][PING_NN_CHANNELS];
+extern const int8_t PingNnFcWeight[PING_NN_CLASSES * PING_NN_CHANNELS];
+extern const int8_t PingNnFcBias[PING_NN_CLASSES];
+extern const uint8_t PingNnShift[PING_NN_LAYERS][2];
+extern const int8_t PingNnTestInput[PING_NN_INPUT_SIZE];
+extern const uint32_t PingNnSelfTestExpected;
+
+extern const char * const PingNnClassName[PING_NN_CLASSES];
+extern int8_t PingNnScores[PING_NN_CLASSES];
+extern volatile uint32_t PingNnInferences;
+extern volatile uint32_t PingNnSkipped;
+extern uint32_t PingNnSelfTest;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ping_nn_reset(void);
+extern void ping_nn_push(void);
+extern bool ping_nn_poll(void);
+extern uint32_t ping_nn_selftest(void);
+
+#endif //  PING_NN_H
@@ -0,0 +1,589 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_nn_weights.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Weights of the sound event classifier, kept in flash
+//
+//	Generated by tools/ping_nn_weights.py from seeded placeholders (seed 8201), do not edit.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ping_config.h"
+#include "ping_tables.h"
+#include "ping_nn.h"
+
+#if PING_NN_ENABLED
+
+// First convolution, [out][y][x], one input channel
+const int8_t PingNnConv1Weight[1280] =
+{
+	5, -7, -19, 35, -17, -24, 13, -7, 37, 8, -44, -8, -7, 31, -35, -28,
+	30, -42, 21, -57, -11, 1, -10, 20, 14, -12, -23, -50, -7, 13, -5, -22,
+	-7, -54, -19, 26, 5, 8, -10, 19, -12, -16, -24, 11, -7, 14, -12, -4,
+	-1, 33, 15, 3, 6, 15, -15, -27, -2, -13, -2, 4, 61, -14, 23, 41,
+	-18, -29, 12, 4, 23, 3, -24, -4, -6, -12, 14, -4, 11, -7, 0, 7,
+	-12, -14, -14, 18, -1, 0, 19, -2, 24, 12, -14, -3, -7, 13, -35, -25,
+	-9, 38, 25, 4, -6, 12, 2, 19, 9, 22, 22, -20, -4, -15, -3, -5,
+	25, 23, -19, 21, 27, 1, -4, 23, -23, -7, 24, -1, 2, 27, -13, -8,
+	16, -22, 19, -28, -22, 21, 18, 7, -15, 23, -29, -33, -19, -17, 0, -26,
+	23, -6, 30, -35, -10, -23, 40, -2, -22, -16, -18, 11, 1, -24, 4, -3,
+	-7, -2, -8, 16, 11, -1, -21, -2, -14, -17, 6, -14, -5, -38, -3, -22,
+	3, 34, 33, -24, -13, 27, 18, 20, 20, 14, -17, 5, -2, -10, -28, -10,
+	3, 56, 26, -9, -55, -8, -31, -12, -11, -18, -19, -38, 4, 19, -21, -38,
+	-26, -16, -18, -29, 10, 25, -10, -24, 6, 12, -7, 38, -14, -40, -12, -20,
+	-10, 8, -36, 22, 10, -29, 13, -6, 31, -30, -7, 6, 60, -10, 6, -3,
+	14, 22, 6, 2, -53, -19, 5, 5, 9, 2, -33, -10, 16, 24, -36, 14,
+	22, 8, 6, 9, 26, -39, -38, -1, 6, -1, -4, -1, -23, 16, 15, 59,
+	27, -4, 13, 10, 33, 14, -1, 8, -4, -2, 5, 21, -5, 1, -19, 12,
+	30, -48, -13, 24, 25, -3, 3, -12, 18, 4, -24, -9, 9, 10, 16, -8,
+	18, -4, 34, -59, -39, 43, 9, 4, 9, -23, 6, 0, 21, 9, 37, 2,
+	-12, 3, -18, 20, 7, 4, 2, -12, 6, -14, 8, -22, -21, -26, -25, 5,
+	23, -24, -7, -27, -4, -11, 23, 9, -19, -45, -16, -5, -29, 13, 7, -36,
+	8, -4, 8, 4, -8, 1, 5, -11, 2, -25, 17, 6, -20, -9, 22, 17,
+	20, 0, -17, 10, -49, -12, -46, 6, 8, 14, -26, 9, 6, 37, -3, 3,
+	40, -12, 10, -32, 27, -2, 5, 4, -26, 47, 0, 12, 20, 3, 2, -8,
+	12, -7, -44, 25, 45, 36, -14, -7, -1, -8, -9, 5, -7, 19, -5, 37,
+	41, -16, 20, 19, -19, 0, 9, 0, 20, -2, -4, 13, -7, 12, 1, 0,
+	-7, 21, 18, -7, -36, -16, -33, 11, -30, -31, 2, -18, 0, -2, 0, -10,
+	-20, -7, 18, 0, 9, 43, 8, -1, -6, 15, 37, -30, 32, 6, -6, 7,
+	8, -9, 23, -2, 11, -9, -27, 17, -2, -18, 12, -3, 25, -2, 14, 13,
+	-31, -12, -12, -11, 0, 9, -32, -3, 0, 13, 12, 2, -13, 13, -10, -18,
+	27, 14, 16, -2, -4, -1, 24, 24, 1, 7, 5, 3, -5, -8, -21, 1,
+	51, -7, 8, 10, 14, -17, 2, -4, -16, -15, -35, 38, -4, -3, 14, -38,
+	-20, 14, 14, 31, 1, 13, 14, 30, 37, 12, -10, -13, -26, 17, -48, 13,
+	-6, -26, -1, -1, 23, -28, -43, -30, 5, 9, 32, -8, -38, 3, 19, -22,
+	9, 14, -4, 17, 0, -19, -27, -30, -11, 2, -14, 20, 13, 1, 19, -4,
+	-38, -25, -10, 3, -1, -24, 0, -31, 2, -9, 54, -23, 7, -23, -1, 12,
+	0, -8, -4, -27, -1, 1, -14, -13, 14, -10, 9, 15, -13, 26, -7, -4,
+	6, -72, 4, -1, -7, -4, 24, 10, -21, 0, -14, -30, 23, -15, 12, 8,
+	-11, 4, -12, -3, -6, -1, 2, -38, 5, -28, 1, 28, -13, -4, -19, 7,
+	-43, 31, 17, -4, 34, 1, -5, -4, -12, -19, 30, -12, 49, 6, 6, 3,
+	-12, -24, 3, -9, 41, 32, -4, 30, -31, -18, 5, -2, 19, 36, 44, -11,
+	-5, -29, 3, 3, -18, 14, -8, 44, -24, 21, -19, -25, 10, 20, -13, -19,
+	-13, -34, -13, 30, 23, -3, -16, 0, 3, 11, 6, 13, 10, 1, 37, -26,
+	5, 20, -28, -2, -17, 14, 29, 19, 9, -28, -9, 1, -38, 1, 9, -20,
+	11, -32, -9, -10, 11, -34, -20, 11, 31, 17, -16, -17, 19, -40, 11, 7,
+	-37, 12, 1, -8, 1, -13, -15, -19, 26, 4, 14, 27, -18, 14, -22, -23,
+	-7, 18, 25, -8, 1, 0, -2, -10, -4, -7, -28, 12, -10, -21, -11, 10,
+	18, 6, 5, -11, 7, 35, 37, -9, 7, -11, 10, -4, 14, 15, -3, -28,
+	-65, 39, 31, 10, 38, 11, -9, -6, 0, 7, 8, -24, 13, 20, -10, -40,
+	-5, -17, 19, -17, 12, 27, 2, -16, 6, -3, 3, -3, 30, 39, -6, -8,
+	-27, -14, 27, 35, 20, -38, -16, -10, -31, -15, -1, 23, 42, 1, -6, 18,
+	-5, 28, -3, 16, -4, 8, -33, 2, -12, 0, -5, 23, 8, 10, -4, 8,
+	-27, 9, -27, -14, -5, 19, -13, -3, 11, -8, 46, 10, 5, -3, 16, -31,
+	9, -15, -40, 10, 24, -9, -9, 11, 3, -2, 3, -33, 15, -1, 37, -17,
+	18, 5, -36, -15, 6, -8, 15, -3, -38, 42, 5, -7, 20, 2, -2, -18,
+	-14, 46, -2, 24, -15, -61, 35, 14, 2, 25, -6, 27, 4, -19, 33, -32,
+	26, -32, 9, -33, 4, -8, 7, 27, 36, 9, -14, -8, -14, 35, -11, -5,
+	-33, -29, 3, 14, -5, -7, 10, -30, -38, -12, -5, 3, 3, 30, -37, -13,
+	5, 17, 9, 29, 4, -29, -17, -20, 3, -21, 17, 18, 2, -17, -42, 45,
+	-42, -2, 17, -1, -19, -27, 13, 4, 2, 21, 8, 11, 1, 7, -4, 13,
+	-22, -26, 8, -49, 4, -45, -23, -6, -53, 11, 9, -5, -17, -28, 7, 5,
+	10, 16, 19, -4, -13, -31, 14, -12, 22, 31, -2, 42, -18, -32, 3, 7,
+	-17, -34, 7, -18, -1, -11, -38, 14, -28, 43, 47, 12, -14, -47, 0, -27,
+	-13, -56, -29, -39, 10, 21, 2, 30, 36, -33, 18, 7, 8, 17, -14, -6,
+	13, 31, 9, 11, -5, 16, -6, -6, 17, 57, 31, -7, -30, 8, -8, 33,
+	24, 25, -5, -7, 27, 12, -11, 6, -29, 9, 17, -38, 9, 1, 7, 6,
+	-9, -11, 29, 11, 26, 14, 18, -5, 0, 11, -6, -1, -1, -7, -15, -6,
+	13, 0, 8, -34, -11, -22, -28, -15, 15, -7, 3, -17, 27, -25, 1, 11,
+	-27, -7, 5, 31, -15, 38, 0, -26, -18, -24, -7, -28, -27, 4, 30, 23,
+	5, -11, -50, -30, -8, 37, -28, 11, -14, -21, 45, -2, -37, -18, 1, -1,
+	-18, 13, 16, -10, 10, -6, 31, -16, -31, 34, -14, -1, 3, 0, 1, -32,
+	-21, 53, -35, -5, 0, -15, 10, 55, 14, -11, 20, -25, -18, -13, 11, 3,
+	-8, 5, 31, -26, 7, -9, -33, 1, 11, -23, -7, 7, -10, 13, 34, 11,
+	14, -29, -10, -5, -1, 1, 5, 20, -11, 17, -22, -21, -9, -11, -8, 12,
+	0, 0, -45, 16, 1, 22, -7, -35, -6, 13, -4, 17, 19, 8, -8, 26,
+	-39, 22, -30, -25, 3, 1, -36, -21, 2, -21, -10, -2, 15, 22, 11, 8,
+	-10, -8, -14, -36, 15, 12, -2, 8, 13, -32, -5, -25, 23, 0, 34, 2,
+	27, 15, 23, 25, 14, 2, -29, 20, -8, -8, -36, -24, -29, -11, 30, -19,
+	-19, 6, -10, 38, -23, -21, 31, -6, -15, -4, 10, -17, -7, 31, -13, 44,
+};
+
+// First convolution bias
+const int8_t PingNnConv1Bias[32] =
+{
+	-18, 33, 4, -8, 17, 6, -10, 23, 15, -71, -48, -18, -20, 1, -56, -11,
+	1, 18, 17, 0, -10, -53, -57, 20, -25, -60, -28, -62, -9, 27, -45, -33,
+};
+
+// Depthwise convolutions, [block][y][x][channel]
+const int8_t PingNnDwWeight[4][288] =
+{
+	{
+		-18, 25, -24, -5, 7, -64, 17, -17, 5, 3, -7, -36, -27, -11, 30, 45,
+		-4, 1, 20, 24, -2, -16, -15, 5, -9, -18, 35, -47, -2, 3, -8, -27,
+		7, -19, 13, -16, 18, -8, -20, 20, 2, -11, 17, 18, 17, 8, -28, 3,
+		11, -8, 9, 33, -45, -7, -15, -6, 27, 8, 13, 18, -7, 18, 25, 13,
+		-3, 16, 3, -14, -1, -26, 9, 5, 3, -1, -45, -41, 26, 5, -9, 22,
+		-23, -48, -20, -19, -5, -11, 4, -31, -6, 5, -9, 43, -8, -13, -7, -28,
+		-1, -9, -17, 27, 1, 13, -1, -11, 0, 28, -37, -2, 18, -5, -9, -29,
+		3, -15, -26, 36, -8, -14, 5, 27, -29, -39, 2, -14, -42, -46, 21, -5,
+		17, -11, -16, 29, -2, 21, 6, 5, 23, 34, 2, 0, 10, -21, -12, 10,
+		-6, -1, 13, -9, 30, -3, -11, -31, 28, 4, -27, -30, 22, 3, 12, 24,
+		-12, -11, -15, 1, -27, 5, 37, -9, -9, 7, -28, 20, 1, -10, 11, 17,
+		-26, 33, 16, 39, 1, 7, 8, 19, -42, 39, 7, -30, 17, -29, -24, -8,
+		5, -4, -7, -16, 7, -34, -46, -18, -30, -9, -2, 10, 23, -12, -35, -9,
+		2, 8, -26, 2, 21, -5, -25, -20, 9, 0, 0, -9, 16, 49, 11, 31,
+		-38, -19, -31, -4, -21, 57, 1, -18, 62, -7, 10, -10, 10, -14, -22, -25,
+		23, 15, -12, 35, -16, -18, -23, -16, 1, 37, -31, -4, 24, -24, -2, 45,
+		37, 25, -26, 23, 49, -23, -13, -22, 18, -9, 9, 19, 16, -8, 11, -2,
+		20, 30, -3, 17, 10, 9, -7, -5, -48, 21, -7, 59, 34, 10, 6, 4,
+	},
+	{
+		8, 24, 18, 9, 8, 18, -28, -32, -6, -13, 4, 13, 36, 5, 26, -19,
+		26, -31, -32, -15, 41, 16, -17, -30, -8, 28, -4, 1, -22, -12, 3, 33,
+		-21, -26, 23, 27, 10, 2, 6, 8, -12, 11, 7, 11, -7, -25, 23, -5,
+		21, 18, 2, 4, -4, -7, 40, -65, 60, -13, 37, -5, 23, 27, 23, -33,
+		0, -5, -28, 17, 10, 6, 4, -3, -17, 29, 18, -22, 9, 4, 18, -20,
+		-10, 37, 22, 9, -3, -21, -7, -15, -4, -29, 17, 18, 47, -13, 18, 37,
+		16, -26, -30, 28, 2, -9, -3, -3, -48, 19, 30, -48, 17, 24, -1, -20,
+		29, -11, -26, -18, -23, -1, -23, 0, 34, -22, -11, 0, 14, -2, -2, -26,
+		11, -7, 35, -13, 7, -3, 9, 24, -6, -58, -10, -13, 7, 16, 35, 11,
+		-15, -28, 3, 2, 10, -5, -7, -5, -14, -3, 16, -5, -20, 5, -27, -9,
+		-11, 18, 20, 3, -21, 0, 11, 6, -31, -6, -7, 21, -18, -4, 7, 11,
+		8, 7, -25, -2, 20, 17, -14, -1, 30, -41, 43, 30, -16, 0, -1, -18,
+		-21, -16, 56, 27, -3, -33, 28, -5, 3, -30, 15, 27, -15, 25, 0, -25,
+		45, -4, 26, 17, -3, -17, 6, -12, -7, -2, 2, -5, 8, 0, -23, -18,
+		17, 2, -15, -23, -4, 0, 19, 20, -12, 18, -4, 35, -19, 42, 20, -19,
+		1, -30, 22, 3, -4, 14, 1, -12, -13, -30, -16, 74, 17, 10, 11, -13,
+		29, -5, 33, -4, -10, -1, 18, -20, -5, -3, 7, -11, -23, -2, -31, 13,
+		-1, -9, 18, 2, -15, -25, 17, -5, 16, -12, -15, -29, -25, -17, -25, -22,
+	},
+	{
+		-28, -31, -4, 6, 17, 8, 2, 55, 12, -14, 12, -6, -13, 15, 20, 16,
+		20, 36, -1, -4, -7, -4, -12, 15, 5, 10, -21, -9, 10, -10, 6, 3,
+		24, 2, -35, -4, 11, -15, -44, -15, -29, -25, 13, 34, 10, 31, -30, 19,
+		-10, 24, 11, 13, 3, 18, 9, -23, 10, -22, -15, -14, 4, 10, -28, 18,
+		0, 34, 19, -5, -17, -18, -13, -43, -47, 11, -10, 4, -11, -9, 4, -5,
+		-12, -12, -37, 24, 2, 10, -36, -28, 26, -49, 24, 1, 3, -14, 1, -6,
+		-4, -8, -3, 4, -22, 18, -11, -16, -4, -1, 28, 1, -26, 26, 46, 1,
+		7, 3, -24, -11, 3, -3, -22, 14, 6, 8, 11, -3, -2, -37, -27, -6,
+		3, 19, -6, 0, 34, 28, -10, 17, 18, 18, 43, 3, -44, -1, 9, -51,
+		-18, 0, 23, -3, -16, -11, 15, -12, -19, -11, -45, -7, 30, -5, 46, -5,
+		-12, 9, -10, -10, 28, -6, -3, 15, -12, 3, 10, -28, -26, -10, -40, 21,
+		-7, 3, -23, -18, -21, -23, -5, 15, 8, 27, 31, -52, -13, -11, -3, -9,
+		-15, 22, -28, -17, -11, 39, -24, 3, 15, -34, -30, 13, -24, 15, -25, 60,
+		-10, -1, 6, 3, -16, -17, 44, 20, -16, 6, -31, 22, -23, 47, -27, 9,
+		0, -1, -17, -3, -44, 13, -31, -2, -9, -9, 41, 16, 76, 29, 7, 22,
+		18, -5, 9, 26, -36, 1, -27, -5, -15, 41, -36, -16, -17, 14, 44, 17,
+		-25, 6, 22, -9, -34, -17, -7, 0, 23, 9, -6, -42, 0, -5, 14, -13,
+		-4, -26, -33, 1, -17, 14, 27, -2, 34, -10, 6, -46, -8, -27, -22, -1,
+	},
+	{
+		-8, 29, 14, -29, 19, -10, 17, -14, 3, -27, -5, -12, 13, 4, 1, -3,
+		7, -5, -12, -6, -14, 14, -35, -11, 10, 16, -12, -5, -22, 13, 30, 31,
+		19, 0, -47, -21, 23, 11, -34, -4, -10, -20, -4, 39, 11, 16, -4, 11,
+		0, -13, 42, 30, -25, -5, -4, 0, 37, -9, 12, 26, -3, 21, -9, 18,
+		-24, -67, -18, -2, -9, 23, -28, 9, 21, -3, -13, 9, 13, 11, 46, 7,
+		11, 2, 17, -1, -36, -22, 7, 22, 29, -9, 24, 30, -3, -27, 14, -7,
+		32, -23, 11, 10, 49, -15, 24, -12, -21, -25, -18, -13, 45, 21, -25, -15,
+		26, 31, -20, 1, -51, 5, 6, 14, 3, -31, -36, 25, 1, -16, -4, 5,
+		-8, 8, 20, 18, -38, -24, -13, -25, 44, 44, 31, -20, -19, -38, 11, -17,
+		-2, 19, 20, 23, -3, 2, -28, -32, 33, -15, -5, 18, -27, 13, 9, -16,
+		5, 29, 31, -11, -7, -18, -10, 21, 22, 21, 11, 5, -15, 13, -23, 11,
+		-16, 26, 1, 9, 21, 12, 16, -30, 19, -27, 45, 39, 10, 35, -8, -9,
+		3, 31, 36, -5, -36, -19, 33, 6, 24, 30, -7, 1, -21, -23, 19, -7,
+		5, 8, 4, 23, -3, -15, -36, 8, 2, 12, -16, 18, 18, 6, 27, -15,
+		-28, 9, -30, -48, 0, 50, 7, -13, -3, -34, 27, 15, 18, 7, -38, -13,
+		3, -43, 19, 0, 5, -52, 3, -19, -19, 47, 20, -3, 12, 27, 12, -16,
+		17, -12, -28, 0, -13, 0, 2, -35, 22, -33, 14, -16, 5, 4, 9, 11,
+		11, -38, -13, 51, -25, -30, 6, -29, -32, -13, 8, 3, 1, -5, 19, -16,
+	},
+};
+
+// Depthwise convolution biases
+const int8_t PingNnDwBias[4][32] =
+{
+	{
+		23, 19, -14, -15, -5, -25, 36, 25, -19, -25, -53, -9, 12, -18, 21, 48,
+		-22, 37, 3, 9, 12, -13, -39, 11, 20, -1, 8, -18, -28, 8, 10, -16,
+	},
+	{
+		1, -57, 0, -23, 5, 29, -31, 20, -5, 7, 34, -28, 20, -49, -72, 2,
+		-10, -22, -10, 31, -14, -10, 9, -7, -28, 18, -9, -29, 45, -34, 49, 15,
+	},
+	{
+		31, 25, 11, 9, 7, -13, -23, 22, 43, 1, -10, 17, -36, 8, -18, 28,
+		-28, -17, 16, -15, -27, 57, -36, -27, 20, 23, 22, -18, 40, -52, 66, -55,
+	},
+	{
+		-14, 25, -49, -37, -19, 51, -23, 13, -16, 3, 45, 9, -13, 61, 7, 20,
+		-58, 20, 34, -39, 1, 17, -40, -15, -42, -43, 19, 3, -34, 16, 56, 10,
+	},
+};
+
+// Pointwise convolutions, [block][out][in]
+const int8_t PingNnPwWeight[4][1024] =
+{
+	{
+		12, 39, -41, 15, 1, -23, 0, 13, 21, -20, 16, -11, -13, -62, -22, -12,
+		-20, -6, -18, -6, 8, -1, -22, -11, 15, -20, 21, -23, 14, 19, 4, -19,
+		56, 2, -16, 15, -5, 0, 15, 5, -8, 46, 20, 10, -21, 13, 18, -25,
+		-4, 38, -14, 4, -19, 6, -20, -31, 22, -2, 27, -23, 19, 5, -15, -2,
+		0, 4, 15, -9, 6, 10, 14, -8, 17, 34, 9, -19, -2, -30, 3, 16,
+		-80, -21, -8, 44, -12, 19, 3, 2, 16, -50, 3, -22, 9, 5, 9, 10,
+		-10, -22, -5, -21, 35, -33, -16, -31, -4, -33, 10, -22, -15, 20, -1, -13,
+		24, 14, 6, -10, -32, -15, -12, 35, 1, 44, 0, 0, 17, 18, -1, -1,
+		-9, 16, 31, 17, 1, 32, 40, 24, -23, 7, -16, -2, 59, -16, 28, -2,
+		-29, -16, -36, 13, -17, 0, -10, -6, -5, 21, -12, -28, 2, -4, -10, 29,
+		44, -33, 2, 80, -25, 14, -16, -18, 2, -22, -51, 23, 21, 29, -6, -20,
+		3, 28, 4, -9, -3, -34, 15, 6, 9, -4, 10, 4, -29, 6, -16, -13,
+		-6, 40, 11, 0, 0, 3, 11, -16, -26, 1, 14, -13, -10, 7, 4, -52,
+		32, -37, -10, -6, 36, 2, -37, 6, -12, 3, 44, 17, -29, 2, 15, 25,
+		-8, -18, 43, -14, -40, -9, -31, -32, -8, 20, 43, -10, 14, -38, -26, -5,
+		-22, -3, 3, -23, 44, 20, 36, -11, 7, -28, -32, -16, -59, -20, 2, 4,
+		2, -5, -36, -1, -3, -20, -3, -16, 12, -23, -25, 23, 2, 20, -10, -9,
+		9, -22, -10, 34, -25, 0, 14, 15, -42, -4, -11, -19, -17, -5, -5, -1,
+		23, 24, -11, -16, 9, 48, -15, -27, 20, 5, 3, -12, -9, 29, -29, -18,
+		-5, -7, 20, 13, -12, 36, 13, 28, 20, -20, -30, -26, -14, -28, -18, -16,
+		17, 7, 23, 13, -11, 0, 1, -18, 4, 12, 10, -25, 2, 4, 21, 6,
+		-49, 8, -4, -13, 26, 0, 19, -28, 15, -17, -18, 7, -22, 14, 44, 0,
+		7, -3, 19, 7, 16, 8, 30, -27, 5, 14, 27, 0, 11, -11, 15, 15,
+		2, 44, 11, -24, -15, -10, -29, -44, -13, 14, 13, 10, 21, -15, 22, 18,
+		-5, 11, -23, 14, -12, -63, -7, -28, -25, 16, 7, -13, -18, -22, -24, 26,
+		24, 27, -15, 28, -7, -34, -19, -14, 48, -2, 17, 25, -10, -27, 9, 24,
+		-22, -8, 1, -8, 31, 21, -11, 21, 16, -8, 23, 2, -11, 27, -19, -8,
+		-41, 24, -11, -31, -28, 24, 0, -12, -34, -33, 11, 19, 17, 32, 0, 39,
+		-30, 21, -25, -19, -39, -39, -40, -17, -20, -25, -52, -6, 56, -10, 6, -9,
+		6, 19, 7, 30, 14, 0, -4, 7, 1, 23, 25, -14, 12, -11, 0, 20,
+		-18, 2, 9, 34, -15, -21, -27, -2, -27, 24, 36, 18, -7, -16, -8, 28,
+		-31, 8, 22, 7, -12, 34, 15, 12, 27, -20, -27, -18, -5, 29, 3, -6,
+		7, 3, -18, 19, 16, -18, -5, -4, 7, 42, 3, 7, -22, 10, 20, 27,
+		4, 24, -11, 41, -21, -35, 6, 19, -7, -23, 18, -6, 48, -8, 11, -47,
+		-9, -17, -18, 29, 17, 32, -20, -1, -32, -35, -11, 7, 38, 5, 30, -1,
+		-30, 9, 38, 18, -1, 20, 29, -49, 33, 36, 12, 10, -3, 22, -55, 19,
+		-5, 29, -9, 0, -1, 19, 5, -22, 15, 1, 11, 27, -1, -33, 2, -10,
+		-37, -42, -13, 22, -10, 7, -41, -15, -14, 27, -5, 16, -13, -3, -2, -22,
+		31, -22, 19, -7, -24, -3, -9, -29, 17, 51, -14, 25, 12, 10, -4, 15,
+		-3, -35, 12, 28, 38, 16, 5, -17, -30, -41, 33, -14, 23, 28, 18, -24,
+		-6, -25, -9, 11, -25, 13, 1, 1, -10, -22, -6, -8, -3, -31, 31, 33,
+		-26, 40, -20, 14, 16, 19, -13, 28, 27, -15, 0, 20, -1, -9, -14, 2,
+		8, 5, 38, 0, 0, 7, -8, -30, 15, 2, 24, 43, -21, -50, 5, 17,
+		20, -2, 11, 6, 34, -6, 18, 7, -8, -19, 44, 34, 10, 22, 56, -34,
+		14, 19, 1, 32, -23, -58, 20, -12, 4, 25, 16, -55, -50, 21, 7, -13,
+		13, -30, -29, 23, -38, 28, 34, 10, 1, 20, 22, 23, 37, 5, -15, -12,
+		6, 26, -11, -29, -34, 46, 4, -4, 26, 9, 20, 18, -24, 8, -19, -29,
+		-33, 4, 20, 8, -9, -58, 2, -18, 3, -13, -49, 24, -16, -24, -1, -31,
+		5, 1, -4, -19, 8, 18, -15, -1, 39, 23, 7, 5, -5, 17, -37, 13,
+		-14, 28, 40, -4, 14, -35, 10, -1, -19, -2, -16, 26, 44, -25, -18, 15,
+		60, -15, 44, -4, -4, 3, -23, -11, 5, 34, -15, -11, -4, 4, -6, 2,
+		-14, 14, 14, 14, 40, 31, 18, -57, -2, 14, 40, 7, -28, 43, -4, -17,
+		27, 20, 17, 1, -40, -10, 12, 0, -1, 30, -16, -16, 7, -11, 22, 27,
+		8, -35, -19, -9, 43, -36, -17, -16, -18, -45, -1, -15, -7, -21, -2, 14,
+		7, 18, -14, 4, -19, 15, 26, -35, 46, -18, -29, -9, 24, 8, 41, -4,
+		-19, -24, -60, 32, -23, 0, -12, 26, -7, 24, 3, -18, 11, 27, -28, -5,
+		-16, 39, 10, 29, -26, -9, -31, 23, 8, 9, -37, 55, -12, -1, 44, -24,
+		-7, -14, -25, -6, -22, 20, 18, -3, -26, -5, -33, 2, 22, -17, 15, 6,
+		-21, 11, 35, 6, -11, -3, 26, 5, -17, 21, 4, 20, -13, 42, 13, -40,
+		3, -5, 23, -18, -24, -9, -17, -4, 27, -11, -4, 11, 17, 33, -35, 38,
+		-17, 4, -71, -19, -18, 9, 27, 21, -37, 19, 7, 27, -47, -46, 55, 19,
+		-5, -70, -18, 16, 5, 3, -16, 17, -21, -12, 21, 29, 26, 32, 11, 12,
+		32, 34, 6, 10, 21, -63, -37, -44, -14, 0, 16, -6, 0, -16, -5, -7,
+		19, -20, 4, -9, -27, 29, 15, 10, 10, -6, 12, 23, -16, -24, 0, 8,
+	},
+	{
+		42, -5, 43, -1, -14, -3, -44, -18, -64, -27, -12, 12, -12, -4, 21, -6,
+		11, 30, -1, -14, -34, 29, 35, -5, 20, 28, 6, 6, -23, -23, 5, 20,
+		-39, 3, -7, -7, -28, -4, 75, -8, -18, 8, -14, -10, 53, 9, -6, 21,
+		37, -1, -5, -53, 9, 9, 9, 7, -1, -28, 21, 39, 25, 3, 1, -32,
+		30, -22, 2, -17, -21, -11, 17, 22, 17, -29, 2, 13, 50, 28, -6, 5,
+		13, 13, 16, -23, -37, -4, 9, 14, 40, 9, -4, -14, 15, 35, 16, 29,
+		-39, -41, 0, 2, 31, 5, -5, 7, -36, -29, -37, 31, -4, 13, -15, -25,
+		5, -27, -18, -1, 10, -29, -26, 26, 8, 30, 21, -11, -14, -39, 4, 24,
+		28, 2, -3, -2, -6, -3, 1, -40, 39, -27, -23, 20, 42, 10, -14, -24,
+		14, -15, -6, -5, -41, 12, -8, 1, -21, -9, 6, -33, 16, 20, -24, -1,
+		37, 50, 4, -38, -4, 0, 1, 12, 3, -30, -9, 9, -14, -2, -39, 14,
+		38, -5, -17, -19, 8, -16, 36, -9, -22, -14, 18, -15, -20, 9, 3, 29,
+		-1, 28, -16, 1, 29, -17, -15, 11, 25, -11, 51, -5, -30, -9, 37, -22,
+		7, 46, -20, 12, -27, 42, 6, 18, -31, 1, -39, -37, -33, -5, 1, 3,
+		5, -9, 31, 19, -18, -20, -7, -33, 1, 3, -7, 15, -11, 16, 10, 5,
+		-39, 10, 1, 5, -33, 41, -9, 37, 7, -5, 21, -12, 9, 6, -17, 5,
+		-39, 3, -2, 25, -21, -13, 23, -10, 25, -23, -23, 25, 31, -38, 18, 41,
+		12, -2, 40, 2, 17, -9, 12, 17, -1, -13, -11, 19, -11, -2, 19, -21,
+		-7, -33, 29, 10, -9, 19, -11, -33, 0, 20, -9, 33, 25, 7, -2, 49,
+		2, 22, 24, -36, -18, 46, -5, 29, -3, 16, -13, 7, 42, 8, 7, 31,
+		23, 28, -8, -14, 11, 33, -24, -2, 1, -39, 10, -2, -16, -18, 16, 10,
+		15, 0, 5, 14, -25, 10, -5, -26, 24, 30, -7, 6, 11, -13, -14, 2,
+		0, 34, 1, -6, 6, 19, 6, -26, -28, -5, -7, -3, 13, 9, -19, -15,
+		-20, 25, -9, -7, 30, 33, -1, -1, 19, -27, -31, 23, -33, 4, -21, -8,
+		2, -6, 6, -11, -41, -25, 16, -20, -37, -10, -23, -1, 30, 30, 34, -16,
+		-8, 28, 5, 0, 14, 1, 15, -11, -8, -6, 2, 40, -9, 0, 17, 20,
+		24, 0, -27, -14, 23, -48, -16, 1, 19, -8, 10, 35, -1, 2, 29, -22,
+		-45, 22, -5, -27, 7, 31, 9, 1, 12, 15, -20, -23, -3, 4, 23, -25,
+		4, 0, -9, 42, 28, -19, -31, -37, 18, 22, 8, -9, -13, -15, 9, 6,
+		14, -25, 28, 37, 1, -35, 2, 20, 19, -24, -33, -33, 7, -34, -61, -32,
+		-7, -7, 8, 20, -37, -3, 15, -8, -4, 25, 33, 9, 7, 31, 21, 1,
+		3, -4, 5, 8, -15, 8, -15, -4, 5, -14, -19, 31, 25, -12, -28, -2,
+		1, 28, 40, 5, -3, 11, 39, 4, -13, -37, -10, -9, 7, -16, -14, -12,
+		6, 5, -5, -1, 0, 7, 19, -17, -28, -19, -24, -51, 2, 34, 21, -25,
+		-12, -50, 1, -26, -51, -25, -23, -28, -10, -16, 3, 4, -4, -31, -34, 47,
+		6, 7, -7, 3, 14, -9, -41, 19, -22, 13, -8, -14, 18, -35, 6, 32,
+		10, 15, -1, 17, 26, -13, 2, -11, 3, 0, 0, -19, -13, -16, -3, 40,
+		-7, -5, -4, -17, 34, -12, -20, -1, 30, 0, -10, 50, 25, -4, -25, -18,
+		41, -55, -56, -5, -4, 18, 1, -5, -18, -25, -14, 35, -2, 3, -41, -8,
+		-7, 4, -38, 27, -10, -13, 1, -33, -64, 2, -24, 7, -43, 34, 14, 15,
+		-18, -4, -34, -48, 25, -21, -3, -21, -24, 13, -5, 15, 4, 33, -25, -2,
+		31, -41, 34, 49, -8, -33, -14, 30, 12, 35, -44, 32, 3, 0, 3, -29,
+		13, 11, -33, -37, -37, 4, -4, 14, -5, -42, -6, -14, 32, 6, 19, 10,
+		2, 8, -40, -20, 3, -25, -29, -12, -2, 2, -12, 28, 15, -12, -6, 8,
+		-18, -6, 25, -19, 4, 4, 2, 12, 9, -2, 8, -50, -2, -45, 9, 10,
+		6, -22, 20, 16, -28, 11, 35, -8, -21, -2, -3, 27, 15, 5, -9, 17,
+		14, -5, 13, 11, 36, 1, 9, 14, -14, -36, 9, 7, -30, 10, -1, 8,
+		32, 19, -30, 23, 3, -17, -20, 13, -22, -18, 0, 7, -10, -16, -19, 2,
+		-38, -12, 13, 51, 14, -15, -11, -21, -34, -19, 2, 8, -12, -9, 44, -2,
+		5, 41, -25, -16, 24, 35, -4, -60, -4, 1, -25, -36, 25, 8, -8, -3,
+		33, 29, -16, 22, -7, 6, -9, 19, 17, 24, 17, 6, -28, -9, -6, 12,
+		-8, 28, 1, 26, -1, 31, -12, -16, 6, 30, 27, -14, -19, 21, -11, -10,
+		3, 5, -2, -8, -22, -2, 34, -18, -17, 5, 16, -14, 24, -15, -4, 6,
+		34, -15, 11, 21, 2, -20, -8, -46, 4, 28, -9, -4, 11, -20, -22, 15,
+		18, 11, -12, -52, 18, -6, 9, -27, 38, 29, 20, 7, 7, 39, 14, 38,
+		-77, -23, 29, -55, -9, -21, -6, 28, 0, 48, -18, -15, -36, 22, 22, -21,
+		13, 25, -27, -4, -10, -18, 9, -21, 12, 15, -23, -17, 1, 6, -25, -15,
+		5, -51, -39, -1, 36, -16, -10, -28, 22, 18, 23, 9, -6, -3, 17, -31,
+		38, -9, 1, 0, -32, 0, -9, 32, -13, -7, -18, -5, 9, -22, 37, -1,
+		-30, -39, -20, 7, 19, -5, -29, -14, 33, 48, 1, 21, -21, 17, 1, 32,
+		-2, 44, -3, 13, -18, -16, 16, 2, 6, 7, -25, 18, -57, 8, -17, -8,
+		9, -4, -8, 3, 9, -3, -29, -27, -41, -2, -22, 32, 10, -19, 9, 5,
+		-48, 1, 7, -1, -19, 13, 26, -11, 5, -26, -14, -37, -37, -5, -27, -5,
+		9, -19, -17, 18, 1, 12, 61, -38, -15, 36, 29, 51, 18, 25, 16, 27,
+	},
+	{
+		12, -19, -35, 30, -28, -4, -10, 5, -29, -43, -22, -25, -23, -15, -7, 4,
+		-21, 7, 4, -37, 9, -32, -27, 11, 13, -10, -42, -23, -26, -18, -3, -17,
+		-48, 1, -10, -29, -39, 2, -15, 2, -43, 13, 6, -18, -52, -21, 3, -20,
+		-8, 34, 29, 6, 22, -17, 28, -26, -3, 5, -15, -44, -12, -10, 2, -41,
+		23, 0, 5, -6, 42, 46, -29, -12, 12, -72, -36, 45, -19, 47, 5, 4,
+		-2, 17, 47, 24, -25, -26, -8, -12, 41, 20, 9, -27, 30, -12, 17, 19,
+		10, 36, 34, 38, -21, -12, 29, 0, -46, 7, -30, -28, -8, 30, -27, -13,
+		-3, 60, 13, -40, 1, 38, 50, 0, -5, -2, 10, 5, 4, 25, 11, -15,
+		-9, -27, 9, 16, 4, -6, -23, 10, -21, -24, 13, -9, -1, 5, -45, 12,
+		16, -4, -18, 14, -16, -21, -6, -3, 19, 9, 0, -7, -30, 29, 2, -48,
+		8, -4, 28, 11, 12, 1, -36, 18, -27, -2, 16, 1, 9, 9, -30, 18,
+		3, 11, 27, 13, -29, 33, -21, -16, 0, -25, -22, 30, -2, 53, 22, -32,
+		-5, -38, -6, 4, -8, -5, 5, -1, -24, -32, 9, 12, -12, 13, 7, -6,
+		15, -19, 19, 2, -42, -20, 0, -22, -29, 41, -21, 1, 8, 24, 22, -22,
+		-38, -22, 3, 41, 10, 26, 7, -23, 27, -22, -6, 60, -19, -22, -29, -9,
+		-33, -40, -2, 26, -2, -7, -62, -1, -20, -2, 4, -19, -10, -9, 35, 44,
+		-56, 40, -27, -7, -23, -17, -35, 11, 24, 37, 8, 13, -6, -6, 26, -26,
+		52, 51, -4, -4, -39, 67, -23, -13, 4, 10, -14, 3, -32, 63, -25, -27,
+		48, 21, -28, -14, 7, -9, 23, -12, 16, 16, -27, -27, 17, 28, -39, -1,
+		5, -19, -39, -26, -2, -18, -12, -50, -11, -32, 28, 18, 21, 31, 22, -44,
+		17, 6, -27, 10, 2, 60, -7, -11, 31, 7, -58, -4, 8, 19, 26, 6,
+		-10, -5, 27, -12, -18, 8, -26, -12, -19, 10, -14, -6, 9, 27, 14, 6,
+		-6, -40, 16, 32, -3, -34, 9, 32, -11, 10, -21, 4, -50, 5, 9, 24,
+		-2, 6, 6, 6, -53, 37, 2, -29, -45, 28, -4, 11, -24, -13, 44, -22,
+		5, 25, -4, -27, 49, -1, -34, -14, 14, 21, -58, 4, -18, 24, 29, -25,
+		-17, 14, 34, -15, 11, -35, 5, -5, -3, 0, 1, 27, -2, -5, 14, 2,
+		-30, -15, -12, -46, 37, 1, -10, 34, 9, 38, 2, 22, 0, -9, -45, 8,
+		15, 26, 31, 24, 36, 46, -3, -36, 22, -7, 48, 23, 16, 2, -33, 21,
+		-33, -13, -10, 17, -1, -5, 48, 3, -20, -35, -3, 41, -15, -46, -10, -26,
+		24, 24, -9, -18, -55, -32, 10, 22, -56, 40, -10, 33, -17, -30, -28, -23,
+		-10, 10, -27, 11, 4, -23, -9, 13, -16, 14, 9, -11, -2, 3, -21, 29,
+		5, 16, 22, 0, -65, -2, 21, -46, -22, -4, 5, 5, 37, 1, -1, 15,
+		-1, -10, 4, -1, 48, 2, -51, 4, 1, 7, 2, 29, 9, 35, -23, -14,
+		-29, -28, -22, -10, -19, -14, -29, 7, -20, -50, 7, 11, -17, 22, 5, -16,
+		-11, -6, -29, -31, 26, -27, 8, 16, 10, 16, 2, 27, -21, -1, 14, 36,
+		-42, -26, 32, 8, -25, 18, 18, -5, 23, -12, -25, -21, 51, -3, 10, -6,
+		11, -15, 37, 10, -30, 6, 53, 6, -39, 30, 20, 19, 7, -18, 6, -14,
+		-27, -34, 4, 13, -18, 18, -25, 18, -34, -7, 7, -29, 73, -8, 5, 6,
+		34, 22, -7, -12, 19, -12, -35, 16, 29, 22, 15, 16, -12, 8, -5, -26,
+		-14, 16, -29, -10, -11, 0, -27, -31, 7, 5, -17, -23, -28, -26, -8, 34,
+		-3, -7, 9, 5, -9, 29, 52, 16, -5, 21, 5, -28, 27, -17, 29, -7,
+		-31, 7, -2, 15, 10, 36, -20, 6, 36, 46, -22, -26, -7, -15, 31, -27,
+		16, 32, 22, 2, -4, 26, -37, -8, -49, -1, 16, -17, 5, -30, 14, 15,
+		-14, 11, -3, 1, -22, -11, 12, -8, -16, -17, 37, 44, -7, -3, 26, -35,
+		-3, -2, 31, -17, 19, -38, 1, -30, 10, -24, -11, 17, 1, -4, 3, 1,
+		-12, 25, 30, -31, -4, -13, 3, -13, -15, 19, -28, -13, -4, -13, 5, 28,
+		2, 6, 2, 25, 0, 12, 22, 1, -35, 0, 13, -24, 37, 30, -4, 17,
+		8, -4, -23, 9, 1, 11, 40, 8, -40, -28, 40, -14, -33, -27, -18, 53,
+		-22, 4, 21, 1, -7, 3, 15, 4, -48, -9, -21, -7, -1, 6, -11, 16,
+		28, 37, 3, 7, 31, 32, 16, -15, -4, -13, 27, 24, 20, 3, -30, -53,
+		-1, 16, -20, 34, 26, -56, 13, 17, 30, -12, 7, 41, 26, 6, -12, 12,
+		-5, 7, -19, -20, 41, 5, -8, -6, -20, -62, -3, 39, -16, 9, -30, 0,
+		-3, -56, -5, 21, -21, 1, 2, -27, 35, 25, 52, 13, 20, 4, -4, 4,
+		-30, -11, -54, 12, 30, -9, -19, 5, -28, 4, -31, 8, -2, 12, 46, 15,
+		-21, 9, -14, -23, -7, 26, -1, 17, -4, -6, -17, 28, 6, -18, -16, -20,
+		-9, 5, 49, -23, 10, -35, 37, 16, 20, -15, 11, -3, -4, 22, -9, 2,
+		15, -17, -11, 8, 13, 11, 1, 10, 43, 10, -38, 48, -9, -19, -10, -3,
+		-10, -18, -18, 6, -15, -22, -15, -26, 22, -7, -16, -16, 15, -2, -41, -1,
+		-44, 18, 24, -11, 8, -27, -16, -34, -9, 8, -6, 6, -21, 0, 17, -1,
+		10, -18, -16, 6, 7, -38, 7, 17, -4, 20, 18, 6, 29, 43, -6, -22,
+		4, -7, -28, 10, -16, 14, -14, 23, 26, -4, 6, -4, -14, 19, -16, 26,
+		7, -25, -34, 41, 0, 11, -19, 0, 16, -5, 6, 4, -15, 48, 55, 8,
+		59, 5, 0, 16, 26, -2, 26, -24, 10, -8, 18, -14, 3, 27, 0, 6,
+		-55, -11, 14, 25, 1, 16, -13, 0, -6, 35, 3, 7, -20, -11, -18, 17,
+	},
+	{
+		38, 26, 19, 12, 34, -52, -24, 0, -36, -14, 36, -22, 48, 14, 24, -5,
+		33, 7, 57, -5, 29, 21, 37, -47, -36, 59, -24, -2, 25, 20, 14, -5,
+		-20, 26, 15, -5, -3, -25, 8, -14, -8, -18, 3, -20, -4, -5, 6, -17,
+		61, 0, 3, -20, 16, 17, 18, -37, -10, 0, -23, -45, 28, -33, -2, -11,
+		11, 16, 2, 22, 2, -29, 22, -24, 13, -7, 5, -16, -12, -30, -15, -15,
+		-3, -24, 44, -28, -26, 10, 4, -51, 8, -17, -21, 14, 9, -28, -15, 10,
+		3, 23, -62, -16, -24, -18, -55, 20, 10, 22, -8, -21, 4, 23, 0, -43,
+		4, -31, 0, -6, 14, -3, 44, 6, 15, -17, 15, 11, -21, -7, 7, -31,
+		0, -8, -1, -5, -8, 14, -37, -8, -1, -22, -28, 25, -12, 22, -40, -39,
+		-25, -5, -25, 7, -26, 11, 13, -33, -21, 1, -36, 39, 8, 12, 24, 34,
+		22, -32, -39, -6, 17, 22, 0, 24, 2, 3, -7, -11, -25, 8, 37, 2,
+		-4, -65, 3, 2, 65, 34, -18, 17, -3, 4, 12, 14, -5, 16, 28, -17,
+		-4, 10, 23, -29, 37, -27, 28, 51, -29, 5, -28, 13, -31, 6, -16, 10,
+		4, 11, 7, 2, 26, -60, -6, -8, 16, 15, -7, -39, 13, 10, -2, 12,
+		0, -19, -9, 11, 4, -15, 20, 17, -11, -13, 8, -22, 26, 23, 28, 28,
+		-25, 6, 14, -36, 31, -4, 30, -68, 23, -21, -4, -11, 18, 24, 19, 30,
+		-11, 3, -19, -6, -32, 11, -22, -7, -14, -3, -29, -19, 10, -19, 19, 8,
+		3, -21, -17, -35, 7, -2, -8, -18, -15, 27, -30, 3, -6, -17, -33, 12,
+		30, 8, -5, 27, -26, 26, 13, 22, -24, 32, -5, 24, -15, -22, 4, 7,
+		34, -32, 6, 11, 23, -12, 43, 22, -34, -14, -33, 11, 12, -22, 18, -12,
+		18, 1, 9, 7, -14, 9, 42, 8, 3, 39, 14, 8, 51, -44, 11, 4,
+		1, -17, 22, 1, 15, -20, -22, 26, -21, 39, -25, 28, -35, 2, -29, -36,
+		36, -10, -12, 11, -23, -42, -8, -29, 28, -6, 3, -32, -25, -2, -17, 38,
+		-18, -12, 1, 17, -24, -21, -7, 10, 19, 13, 16, -2, 12, 7, 51, 21,
+		-14, 26, 28, -32, -12, -25, -6, 17, 24, 2, 3, 0, -31, 23, -63, 3,
+		4, -1, -31, -4, -9, 9, -11, 56, -11, 22, 19, 24, 16, 14, -21, -20,
+		43, -17, 8, -2, 14, 29, 5, 6, -14, 38, 19, 5, 30, -33, 30, 3,
+		-5, -1, 22, -25, -22, 24, 6, 41, -6, 8, 17, -38, -12, -28, -15, -2,
+		-25, -37, 10, 11, 7, 13, -18, -7, 3, -6, -35, 22, 22, 15, -37, -14,
+		-15, 28, -6, 26, 5, -24, 10, 14, 8, -23, -15, -5, -22, -33, -13, 78,
+		-12, -9, -8, 69, -5, 3, 0, -21, -13, 28, 12, -4, 2, -4, -14, -8,
+		-41, 23, 8, -15, 17, -14, -44, -15, 6, -13, -30, -37, -2, 7, 0, 17,
+		17, -4, 6, 29, 6, -16, 18, -23, 1, -22, 7, 24, 15, 14, -36, 35,
+		-13, -30, -30, 17, -18, 10, 23, -13, 19, -11, -40, 17, -17, -28, -29, -12,
+		28, 31, -44, -2, 15, -8, 1, 35, -35, -13, -29, -6, -2, 7, 32, -41,
+		17, 7, -40, 2, 23, -9, -41, 4, -25, -13, 16, 13, 33, -3, -9, 32,
+		20, 19, -1, -26, 30, -22, -4, 25, 9, -11, -36, -10, -17, -33, 28, 0,
+		-8, -9, -5, -17, -12, -21, -27, -30, 9, -20, 12, -5, -16, -37, 4, -17,
+		6, 28, -3, 28, 0, -1, 5, 8, 17, -11, 7, 33, 15, 42, 42, 16,
+		13, 27, -45, -30, -11, 19, -17, -44, 9, 16, 10, 21, 3, -22, 24, -10,
+		-27, 19, -17, -31, 21, -1, 3, -8, 27, -6, -48, 10, 24, -6, -15, 10,
+		23, -8, 15, -40, 12, -11, 12, -17, 17, 19, -28, -1, -6, -11, 24, -10,
+		-3, 1, -15, -14, -47, 19, -3, -13, 5, -11, -44, -19, 24, 9, 9, -18,
+		8, -4, -9, 10, -7, -25, 6, -2, 10, 22, 3, -3, -38, 58, -32, 22,
+		16, 30, -17, 17, 18, -11, -24, -20, 28, 21, 70, 22, 2, -17, -23, -15,
+		14, -9, 42, -4, 51, -29, -40, 3, 13, -1, -21, 4, 12, 18, -9, 5,
+		8, 35, 39, 3, 36, -18, -1, 7, 8, 1, 12, 29, -13, 11, -21, 37,
+		37, -14, -13, 7, -2, -29, -65, 10, -34, -40, -6, 6, 9, -12, 26, -15,
+		16, 14, 5, -10, -3, 28, -30, -1, -4, 11, -17, -48, 7, -48, -40, 8,
+		-3, 17, 10, 58, -2, 10, 5, 5, -3, -73, -2, 2, -14, 21, -4, -21,
+		37, 2, 21, -20, 8, -2, 0, 18, -9, -22, 24, -38, -12, 3, 3, -27,
+		-32, 7, 5, -23, 0, 32, -9, -22, -7, -8, -6, 1, -13, -10, -26, 24,
+		42, -13, -17, -37, -25, -10, -21, -13, -30, 44, -33, 13, 20, 9, 10, -16,
+		3, 35, 4, 4, 44, -9, -60, 21, 3, 41, 0, -6, 29, 45, 9, 9,
+		-20, 8, -6, 30, -21, -5, -17, 11, -13, -11, 1, 35, 40, 58, 21, 23,
+		-11, 0, -11, -19, 57, 1, 21, -44, 24, 66, 14, -4, 9, -53, -11, 16,
+		-19, 4, -35, -8, -26, -35, 19, 37, 8, 0, 26, -14, -35, 13, -4, -6,
+		1, -12, -15, -34, 8, 11, -10, -22, 13, 2, -20, -27, -2, 46, -17, -11,
+		-2, -12, -25, -16, -4, 11, -28, 40, -20, -2, 20, -11, -26, 32, -2, 54,
+		-26, -10, -12, 48, 24, -42, 10, -16, -17, 31, 26, -6, -17, 19, -11, 16,
+		-35, 21, -26, 11, -26, 19, 39, 4, 17, 22, -15, 1, -5, -22, -11, -2,
+		-45, -31, 20, -35, 8, -1, 6, 16, -55, -7, 6, 2, -44, -20, 16, 16,
+		-13, 2, -24, -22, 19, -1, -3, -10, -14, 4, 46, 9, -35, 3, -24, -4,
+		26, -8, -18, -17, 16, 36, 21, -11, 14, 15, -26, -1, 7, 1, 11, -52,
+	},
+};
+
+// Pointwise convolution biases
+const int8_t PingNnPwBias[4][32] =
+{
+	{
+		21, -2, -23, 15, 28, 1, 5, -14, -5, 2, -5, -11, 14, 17, -11, 29,
+		12, 9, 1, -8, 23, 28, -29, 10, 16, -22, -21, -25, 2, 53, -13, -75,
+	},
+	{
+		37, 3, 31, 48, -28, 70, -27, 23, -40, 10, 68, 23, -31, -8, 11, 28,
+		-7, -4, -32, -6, -10, 3, 36, -5, 20, 11, 7, -35, -19, -8, -14, -24,
+	},
+	{
+		18, 2, -41, 35, -6, -14, 8, -12, 72, -3, 34, 45, -16, -49, -37, -35,
+		5, 17, 11, -41, 13, 5, -8, 17, 2, 29, 18, -14, -28, -61, 32, 3,
+	},
+	{
+		73, -8, 52, 21, -39, -54, 23, -1, -65, -60, -8, -32, 85, 56, 37, -2,
+		-8, 47, -72, 106, 78, -79, -16, -63, 79, -68, 7, -47, -51, 45, 80, -18,
+	},
+};
+
+// Fully connected layer, [class][channel]
+const int8_t PingNnFcWeight[224] =
+{
+	27, 36, 9, -41, 3, 16, -54, -83, -24, 70, -58, 59, 10, -2, -59, -14,
+	6, 38, -29, -33, 33, -5, 19, -60, -41, 13, 18, 33, -102, -50, -52, -12,
+	-53, -26, -2, -52, -7, 79, -62, 44, 62, 20, 2, 7, 62, 53, -31, 54,
+	2, -6, 69, -37, 14, -35, 1, 41, -42, -20, -27, 5, -34, 42, 38, -6,
+	25, -66, 48, 45, 0, 32, -18, -5, 26, 14, 52, -71, 41, -52, 19, 38,
+	-60, -14, -81, 23, -50, -51, -69, -28, -41, -50, 7, -79, -21, 19, -43, 10,
+	47, 74, -21, 8, -33, 3, 3, -59, 107, 18, -43, 36, -1, 24, 37, 55,
+	44, 2, 90, -7, 11, 14, -86, -28, 90, -21, -24, 90, -12, 6, -20, 55,
+	-79, 2, 77, 2, -14, 57, 55, 39, -107, 8, 22, 53, 28, 8, -3, -19,
+	79, -30, 43, -24, -16, -28, 31, -43, -41, 18, -59, -59, -9, -66, -14, 53,
+	-29, -44, 8, -45, -5, -115, -35, -15, 76, -27, 22, 20, 73, 0, -30, 87,
+	68, -15, -30, 18, 53, 23, 42, -74, -65, -23, 28, 31, -85, 59, 6, -25,
+	48, 61, 10, 77, -76, 17, -36, 56, -73, 37, -77, 39, 8, -12, -10, -24,
+	-44, 14, 76, -40, 27, -32, 20, -11, -67, 76, -54, 98, -30, 37, 23, 38,
+};
+
+// Fully connected bias
+const int8_t PingNnFcBias[7] =
+{
+	24, -117, -41, 42, -111, 120, -67,
+};
+
+// Bias left shift and output right shift of each layer, PING_NN_LAYER_xxx order
+const uint8_t PingNnShift[10][2] =
+{
+	{ 0, 6 },		// conv1
+	{ 0, 6 },		// dw1
+	{ 1, 7 },		// pw1
+	{ 0, 6 },		// dw2
+	{ 1, 7 },		// pw2
+	{ 0, 6 },		// dw3
+	{ 1, 7 },		// pw3
+	{ 0, 6 },		// dw4
+	{ 0, 7 },		// pw4
+	{ 0, 8 },		// fc
+};
+
+// Self test input, [y][x] in the input format
+const int8_t PingNnTestInput[490] =
+{
+	8, 24, 56, 37, 1, -7, -38, -50, -36, -5, 22, 41, 57, 38, -2, -33,
+	-42, -30, -19, 20, 23, 50, 33, 20, -11, -36, -48, -26, -4, 15, 34, 32,
+	22, 3, -35, -36, -34, -12, -1, 40, 37, 36, 17, -17, -30, -32, -33, 0,
+	26, 34, 40, 16, -11, -24, -37, -54, -1, 14, 34, 47, 37, 19, -8, -47,
+	-28, -30, -10, 30, 40, 36, 38, 9, -16, -43, -26, 15, 21, 32, 36, 25,
+	6, -20, -31, -47, -17, -4, 22, 33, 27, 3, 0, -51, -47, -20, 2, 21,
+	34, 43, 18, -5, -48, -33, -28, -13, 21, 38, 41, 31, -2, -26, -43, -18,
+	-10, 5, 37, 46, 16, 0, -29, -35, -37, -18, -3, 16, 51, 42, 13, -14,
+	-22, -57, -26, -7, 31, 49, 43, 27, -22, -26, -30, -28, 3, 11, 33, 32,
+	15, 1, -21, -45, -55, -17, 12, 31, 44, 8, -4, -18, -40, -38, -2, 13,
+	46, 24, 41, 6, -41, -33, -33, -8, 18, 28, 47, 20, -5, -33, -32, -32,
+	-9, 7, 41, 43, 37, 2, -32, -39, -34, -17, 3, 43, 54, 12, 8, -8,
+	-50, -21, -15, 6, 26, 36, 16, 3, -13, -36, -34, -26, 13, 31, 35, 34,
+	5, -14, -33, -30, -22, 13, 23, 43, 20, 0, -28, -45, -35, -8, 10, 35,
+	32, 30, -4, -21, -47, -33, -25, -5, 41, 46, 21, -4, -33, -41, -52, -18,
+	13, 31, 45, 12, 3, -35, -40, -31, -18, 21, 43, 41, 23, 3, -27, -42,
+	-39, 0, 29, 28, 41, 27, -5, -22, -43, -33, -7, 26, 32, 34, -4, -23,
+	-38, -50, -36, -7, 27, 45, 43, 11, -18, -47, -41, -7, 23, 41, 46, 12,
+	11, -16, -42, -25, -3, 32, 40, 34, 29, 1, -32, -42, -32, -3, 21, 43,
+	45, 23, 0, -32, -35, -28, 1, 25, 36, 22, 14, -7, -26, -43, -20, -2,
+	22, 34, 24, 1, -35, -25, -29, -12, 23, 40, 30, 22, 2, -32, -45, -35,
+	-3, 6, 32, 43, 19, -6, -26, -54, -26, 17, 24, 32, 39, 2, -24, -43,
+	-34, -24, 24, 38, 36, 34, -6, -25, -50, -41, -6, 39, 37, 25, 2, -17,
+	-29, -44, -19, 12, 25, 48, 27, 7, -26, -37, -39, -13, 31, 35, 21, 6,
+	-18, -39, -43, -29, -2, 31, 36, 18, -6, -20, -29, -36, -10, 22, 36, 34,
+	12, -22, -34, -52, -25, 0, 19, 44, 36, 11, -36, -56, -35, -1, 10, 38,
+	25, 23, -12, -33, -32, -22, 8, 46, 43, 32, -11, -35, -54, -40, 17, 40,
+	47, 43, 19, -18, -30, -33, -26, -5, 36, 50, 27, -12, -27, -38, -34, -23,
+	20, 36, 36, 16, -18, -49, -41, -23, 8, 40, 42, 29, -8, -31, -44, -22,
+	21, 40, 31, 41, 0, -16, -38, -15, -7, 26, 48, 45, 19, -1, -31, -25,
+	-14, 27, 31, 43, 31, 0, -28, -34, -24, 10,
+};
+
+// What ping_nn_selftest() must return with these weights
+const uint32_t PingNnSelfTestExpected = 0xae793806;
+
+#endif // PING_NN_ENABLED
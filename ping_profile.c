@@ -0,0 +1,216 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_profile.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Cycle accurate profiling of the audio pipeline
+//
+//	Code between PING_PROFILE_BEGIN(scope) and PING_PROFILE_END(scope) is timed with the
+//	DWT cycle counter and folded into per scope min, max, mean and a log2 histogram.  A scope
+//	must only be used from one interrupt level, its begin stamp is not shared.  With
+//	PING_PROFILE_ENABLED at 0 the markers compile to nothing.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "app_util_platform.h"
+
+//  Support for NRF Log Functions
+#include "nrf_log.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+
+#include "ping_profile.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+ping_profile_scope_t PingProfile[PING_PROFILE_NUM_SCOPES];
+
+const char * const PingProfileName[PING_PROFILE_NUM_SCOPES] =
+{
+	"i2s_isr",
+	"frame",
+	"capture",
+	"detect",
+	"fft",
+	"magnitude",
+	"peak",
+	"features",
+	"nn",
+	"flux",
+	"siren",
+	"harmonic",
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_profile_init() function starts the cycle counter and clears the statistics.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_profile_init(void)
+{
+#if defined(__arm__)
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	ping_profile_reset();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_profile_reset() function clears the statistics of every scope.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_profile_reset(void)
+{
+	uint8_t nIdx;
+
+	CRITICAL_REGION_ENTER();
+
+	memset(PingProfile, 0, sizeof(PingProfile));
+
+	for(nIdx=0; nIdx < PING_PROFILE_NUM_SCOPES; nIdx++)
+	{
+		PingProfile[nIdx].Min = UINT32_MAX;
+	}
+
+	CRITICAL_REGION_EXIT();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_profile_record() function adds one run to the statistics of a scope, normally
+// through PING_PROFILE_END().
+//
+// Parameter(s):
+//
+//	nScope		one of the PING_PROFILE_xxx scopes
+//	Ticks		duration of the run in timestamp ticks
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_profile_record(uint8_t nScope, uint32_t Ticks)
+{
+	ping_profile_scope_t *pScope = &PingProfile[nScope];
+	uint32_t Microseconds = Ticks / PING_PROFILE_TICKS_PER_US;
+	uint32_t nBin = 0;
+
+	pScope->Count++;
+	pScope->Sum += Ticks;
+	pScope->Min = MIN(pScope->Min, Ticks);
+	pScope->Max = MAX(pScope->Max, Ticks);
+
+	if(Microseconds > 1)
+	{
+		nBin = MIN(31 - __builtin_clz(Microseconds), PING_PROFILE_HIST_BINS - 1);
+	}
+
+	pScope->Histogram[nBin]++;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_profile_format() function prints the statistics of one scope, times in usec
+// with one decimal.
+//
+// Parameter(s):
+//
+//	nScope		one of the PING_PROFILE_xxx scopes
+//	bHistogram	print the histogram counts instead of min, mean and max
+//	pBuf		output buffer
+//	nSize		size of pBuf
+//
+// Returns the length of the text, without the terminator
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_profile_format(uint8_t nScope, bool bHistogram, char *pBuf, uint32_t nSize)
+{
+	ping_profile_scope_t Scope;
+	uint32_t Min, Mean, Max;
+	uint32_t nLength;
+	uint32_t nIdx;
+	int nWritten;
+
+	// Take a consistent copy, the scope may be updated from an interrupt
+	CRITICAL_REGION_ENTER();
+	Scope = PingProfile[nScope];
+	CRITICAL_REGION_EXIT();
+
+	if(bHistogram)
+	{
+		nWritten = snprintf(pBuf, nSize, "%s hist", PingProfileName[nScope]);
+		nLength = (nWritten > 0) ? MIN((uint32_t) nWritten, nSize - 1) : 0;
+
+		for(nIdx=0; nIdx < PING_PROFILE_HIST_BINS; nIdx++)
+		{
+			nWritten = snprintf(&pBuf[nLength], nSize - nLength, " %lu", (unsigned long) Scope.Histogram[nIdx]);
+			nLength = (nWritten > 0) ? MIN(nLength + nWritten, nSize - 1) : nLength;
+		}
+
+		return nLength;
+	}
+
+	if(Scope.Count == 0)
+	{
+		nWritten = snprintf(pBuf, nSize, "%s n=0", PingProfileName[nScope]);
+		return (nWritten > 0) ? MIN((uint32_t) nWritten, nSize - 1) : 0;
+	}
+
+	// Tenths of a usec
+	Min = (uint32_t) ((uint64_t) Scope.Min * 10 / PING_PROFILE_TICKS_PER_US);
+	Mean = (uint32_t) (Scope.Sum * 10 / ((uint64_t) Scope.Count * PING_PROFILE_TICKS_PER_US));
+	Max = (uint32_t) ((uint64_t) Scope.Max * 10 / PING_PROFILE_TICKS_PER_US);
+
+	nWritten = snprintf(pBuf, nSize, "%s n=%lu min=%lu.%lu mean=%lu.%lu max=%lu.%lu us",
+		PingProfileName[nScope], (unsigned long) Scope.Count,
+		(unsigned long) (Min / 10), (unsigned long) (Min % 10),
+		(unsigned long) (Mean / 10), (unsigned long) (Mean % 10),
+		(unsigned long) (Max / 10), (unsigned long) (Max % 10));
+
+	return (nWritten > 0) ? MIN((uint32_t) nWritten, nSize - 1) : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_profile_dump() function writes the statistics of every scope that has run to
+// the log.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_profile_dump(void)
+{
+	char cLine[128];
+	uint8_t nIdx;
+
+	for(nIdx=0; nIdx < PING_PROFILE_NUM_SCOPES; nIdx++)
+	{
+		if(PingProfile[nIdx].Count == 0)
+		{
+			continue;
+		}
+
+		ping_profile_format(nIdx, false, cLine, sizeof(cLine));
+		NRF_LOG_RAW_INFO("%s\r\n", NRF_LOG_PUSH(cLine));
+
+		ping_profile_format(nIdx, true, cLine, sizeof(cLine));
+		NRF_LOG_RAW_INFO("%s\r\n", NRF_LOG_PUSH(cLine));
+	}
+}
@@ -0,0 +1,110 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_profile.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_profile.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_PROFILE_H
+#define PING_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// PING_PROFILE_ENABLED and PING_PROFILE_HIST_BINS, the markers below depend on them
+#include "ping_config.h"
+
+#if defined(__arm__)
+#include "nrf.h"
+#else
+#include <time.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Profiled scopes, see PingProfileName[] for the names used in the dumps
+
+#define PING_PROFILE_I2S_ISR			0	// I2S buffer rotation and hand-over
+#define PING_PROFILE_FRAME			1	// Everything done for one frame in the analysis interrupt
+#define PING_PROFILE_CAPTURE			2	// Deinterleave and conversion into the detector input
+#define PING_PROFILE_DETECT			3	// ping_detect(), whatever the mode
+#define PING_PROFILE_FFT				4	// The FFT alone, all FFT based modes
+#define PING_PROFILE_MAGNITUDE		5	// Magnitude and argmax over the FFT output
+#define PING_PROFILE_PEAK			6	// Peak interpolation
+#define PING_PROFILE_FEATURES		7	// Mel energies and MFCCs from the FFT magnitude
+#define PING_PROFILE_NN				8	// One classifier inference, in the main loop
+#define PING_PROFILE_FLUX			9	// Pulse edge detector, on every frame
+#define PING_PROFILE_SIREN			10	// Siren sweep tracker, on every frame
+#define PING_PROFILE_HARMONIC		11	// Harmonic sum over the candidate fundamentals
+
+#define PING_PROFILE_NUM_SCOPES		12
+
+// Timestamp source: the DWT cycle counter on target, 64 ticks per usec at 64 MHz, and the
+// monotonic clock in ns on a host build.  Both are 32 bits and only used for differences.
+
+#if defined(__arm__)
+#define PING_PROFILE_TICKS_PER_US		64
+#else
+#define PING_PROFILE_TICKS_PER_US		1000
+#endif
+
+#if PING_PROFILE_ENABLED
+#define PING_PROFILE_BEGIN(nScope)		(PingProfile[nScope].Begin = ping_profile_now())
+#define PING_PROFILE_END(nScope)		ping_profile_record((nScope), ping_profile_now() - PingProfile[nScope].Begin)
+#else
+#define PING_PROFILE_BEGIN(nScope)		((void) 0)
+#define PING_PROFILE_END(nScope)		((void) 0)
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Statistics of one scope, in timestamp ticks.  Histogram bin 0 counts runs under 2 usec,
+// bin n runs of 2^n to 2^(n+1) usec, the last bin everything longer.
+
+typedef struct
+{
+	uint32_t Begin;
+	uint32_t Count;
+	uint32_t Min;
+	uint32_t Max;
+	uint64_t Sum;
+	uint32_t Histogram[PING_PROFILE_HIST_BINS];
+} ping_profile_scope_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern ping_profile_scope_t PingProfile[PING_PROFILE_NUM_SCOPES];
+extern const char * const PingProfileName[PING_PROFILE_NUM_SCOPES];
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t ping_profile_now(void)
+{
+#if defined(__arm__)
+	return DWT->CYCCNT;
+#else
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return (uint32_t) ((uint64_t) Now.tv_sec * 1000000000u + Now.tv_nsec);
+#endif
+}
+
+extern void ping_profile_init(void);
+extern void ping_profile_reset(void);
+extern void ping_profile_record(uint8_t nScope, uint32_t Ticks);
+extern uint32_t ping_profile_format(uint8_t nScope, bool bHistogram, char *pBuf, uint32_t nSize);
+extern void ping_profile_dump(void);
+
+#endif //  PING_PROFILE_H
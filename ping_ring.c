@@ -0,0 +1,265 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_ring.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	I2S receive buffer pool shared by the I2S interrupt and the
+//						processing loop
+//
+//	The I2S DMA writes straight into a pool of PING_RING_BUFFERS frame buffers, nothing is
+//	copied.  Buffers move between two single producer, single consumer queues of pointers:
+//
+//	Free	processing loop -> I2S interrupt, buffers the DMA may fill next
+//	Filled	I2S interrupt -> processing loop, received frames in arrival order
+//
+//	Two buffers are always with the I2S peripheral (one being filled, one queued), the rest
+//	are either waiting in Filled or owned by the consumer until ping_ring_release().  Each
+//	side writes only its own queue index, no locking is needed.  When the interrupt finds no
+//	free buffer it keeps the frame it has just received out of Filled and hands it straight
+//	back to the DMA, which drops that frame and counts an overrun.  The next frame queued
+//	carries the number dropped right before it, see ping_ring_dropped().
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <string.h>
+
+#include "nrf.h"
+#include "nordic_common.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+
+#include "ping_ring.h"
+
+#if (PING_RING_BUFFERS & (PING_RING_BUFFERS - 1)) != 0
+#error "PING_RING_BUFFERS must be a power of two"
+#endif
+
+#if PING_RING_BUFFERS < 4
+#error "PING_RING_BUFFERS must leave the consumer at least two buffers next to the two the DMA holds"
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// The DMA buffers themselves, one I2S frame each
+static uint32_t RingBuffer[PING_RING_BUFFERS][AUDIO_FRAME_NUM_SAMPLES];
+
+// A queue of buffer pointers.  Head and Tail are free running counts, the entry is the count
+// modulo PING_RING_BUFFERS; every queue can hold the whole pool, so a push never fails.
+typedef struct
+{
+	uint32_t *pEntry[PING_RING_BUFFERS];
+	volatile uint32_t Head;		// written by the producer only
+	volatile uint32_t Tail;		// written by the consumer only
+} ping_ring_queue_t;
+
+static ping_ring_queue_t RingFree;
+static ping_ring_queue_t RingFilled;
+
+// Frames dropped right before each entry of Filled, and those not yet given to an entry.
+// Both are written by the producer only, like Filled.Head.
+static uint32_t RingDropped[PING_RING_BUFFERS];
+static uint32_t RingDropPending = 0;
+
+volatile uint32_t PingRingOverruns = 0;		// frames dropped because the consumer held every buffer
+// Peeks that found no frame waiting.  The consumer is woken once per frame and drains the
+// ring, so these are mostly wake-ups whose frame an earlier pass already took, not lost
+// audio; dropped frames are the overruns.
+volatile uint32_t PingRingEmptyPeeks = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The RingPush() and RingPop() functions move one buffer pointer through a queue.  The
+// barriers keep the entry and the buffer contents ahead of the index the other side reads.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void RingPush(ping_ring_queue_t *pQueue, uint32_t *pBuffer)
+{
+	uint32_t Head = pQueue->Head;
+
+	pQueue->pEntry[Head & (PING_RING_BUFFERS - 1)] = pBuffer;
+	__DMB();
+	pQueue->Head = Head + 1;
+}
+
+static uint32_t *RingPop(ping_ring_queue_t *pQueue)
+{
+	uint32_t Tail = pQueue->Tail;
+	uint32_t *pBuffer;
+
+	if(pQueue->Head == Tail)
+	{
+		return NULL;
+	}
+
+	__DMB();
+	pBuffer = pQueue->pEntry[Tail & (PING_RING_BUFFERS - 1)];
+	__DMB();
+	pQueue->Tail = Tail + 1;
+
+	return pBuffer;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_ring_start() function returns every buffer to the pool.  Call it right before
+// nrf_drv_i2s_start(), with the I2S peripheral stopped and no frame held by the consumer.
+//
+// Returns the first RX buffer, for nrf_drv_i2s_start()
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t *ping_ring_start(void)
+{
+	uint32_t nIdx;
+
+	memset(&RingFree, 0, sizeof(RingFree));
+	memset(&RingFilled, 0, sizeof(RingFilled));
+	memset(RingDropped, 0, sizeof(RingDropped));
+	RingDropPending = 0;
+
+	for(nIdx=1; nIdx < PING_RING_BUFFERS; nIdx++)
+	{
+		RingPush(&RingFree, RingBuffer[nIdx]);
+	}
+
+	return RingBuffer[0];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_ring_supply() function takes the RX buffer the I2S peripheral has just released
+// and returns the one to pass to nrf_drv_i2s_next_buffers_set().  Called from the I2S
+// interrupt on every NRFX_I2S_STATUS_NEXT_BUFFERS_NEEDED event.
+//
+// Parameter(s):
+//
+//	pReleased		filled RX buffer, NULL on the first request after the start
+//	bPublish		false to recycle the frame without queuing it, while the I2S only runs
+//				to provide a clock
+//
+// Returns the next RX buffer for the DMA
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t *ping_ring_supply(uint32_t *pReleased, bool bPublish)
+{
+	uint32_t *pNext;
+
+	if((pReleased != NULL) && !bPublish)
+	{
+		return pReleased;
+	}
+
+	pNext = RingPop(&RingFree);
+
+	if(pNext == NULL)
+	{
+		// The consumer holds everything else, reuse the frame just received
+		PingRingOverruns++;
+		RingDropPending++;
+		return pReleased;
+	}
+
+	if(pReleased != NULL)
+	{
+		// Ownership passes to the processing loop, RingPush() orders the count before Head
+		RingDropped[RingFilled.Head & (PING_RING_BUFFERS - 1)] = RingDropPending;
+		RingDropPending = 0;
+		RingPush(&RingFilled, pReleased);
+	}
+
+	return pNext;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_ring_peek() function returns the oldest received frame without removing it.
+// Consumer side; the frame belongs to the caller until ping_ring_release().
+//
+// Parameter(s):
+//
+//	pSamples		receives the number of stereo words in the frame
+//
+// Returns the frame, or NULL if none is waiting
+//
+//////////////////////////////////////////////////////////////////////////////
+
+const uint32_t *ping_ring_peek(uint32_t *pSamples)
+{
+	uint32_t Tail = RingFilled.Tail;
+
+	if(RingFilled.Head == Tail)
+	{
+		PingRingEmptyPeeks++;
+		return NULL;
+	}
+
+	__DMB();
+
+	*pSamples = AUDIO_FRAME_NUM_SAMPLES;
+
+	return RingFilled.pEntry[Tail & (PING_RING_BUFFERS - 1)];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_ring_dropped() function returns the number of frames the ring dropped right
+// before the one returned by ping_ring_peek(), so the consumer can keep its frame count
+// in step with the audio.  Call it between ping_ring_peek() and ping_ring_release().
+//
+// Returns the frames dropped, 0 if none or if no frame is waiting
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_ring_dropped(void)
+{
+	uint32_t Tail = RingFilled.Tail;
+
+	if(RingFilled.Head == Tail)
+	{
+		return 0;
+	}
+
+	__DMB();
+
+	return RingDropped[Tail & (PING_RING_BUFFERS - 1)];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_ring_release() function hands the frame returned by ping_ring_peek() back to the
+// I2S interrupt for refilling.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_ring_release(void)
+{
+	uint32_t *pBuffer = RingPop(&RingFilled);
+
+	if(pBuffer != NULL)
+	{
+		RingPush(&RingFree, pBuffer);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_ring_count() function returns the number of frames waiting for the consumer.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t ping_ring_count(void)
+{
+	return RingFilled.Head - RingFilled.Tail;
+}
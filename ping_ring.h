@@ -0,0 +1,32 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_ring.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_ring.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_RING_H
+#define PING_RING_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern volatile uint32_t PingRingOverruns;
+extern volatile uint32_t PingRingEmptyPeeks;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern uint32_t *ping_ring_start(void);
+extern uint32_t *ping_ring_supply(uint32_t *pReleased, bool bPublish);
+extern const uint32_t *ping_ring_peek(uint32_t *pSamples);
+extern uint32_t ping_ring_dropped(void);
+extern void ping_ring_release(void);
+extern uint32_t ping_ring_count(void);
+
+#endif //  PING_RING_H
@@ -0,0 +1,548 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_siren.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Siren sweep tracker, frame to frame peak tracking
+//
+//	Sirens do not hold a frequency, they sweep it: a wail rises and falls over seconds, a
+//	yelp several times a second, both over roughly an octave below 2 kHz.  A fixed bin
+//	window only sees them passing through, so this tracker follows the peak from one I2S
+//	frame to the next, whatever the detector mode, and reports each rise and fall.
+//
+//	Every frame is taken through a Goertzel filter per FFT bin of the frame length from
+//	PING_SIREN_FREQ_LO_HZ to PING_SIREN_FREQ_HI_HZ, plus a guard bin either side.  The
+//	strongest bin is a measurement if it stands PING_SIREN_PEAK_RATIO over the average of
+//	the other bins, leaving out the two its tone spreads into, and is interpolated with its
+//	larger neighbour as the rectangular window bank detector does.
+//
+//	An alpha-beta tracker keeps the frequency and its rate of change.  Each measurement
+//	within PING_SIREN_GATE_HZ of the prediction corrects both; anything else is a miss and
+//	the track coasts on the prediction, until PING_SIREN_MAX_MISSES in a row drop it and the
+//	next measurement starts a new one.
+//
+//	A sweep ends when the tracked frequency turns back by PING_SIREN_TURN_HZ from its
+//	furthest point, a margin well over the tracking noise; the rate itself is too noisy
+//	at the few Hz per hop of a wail to split the track by its sign.  The turn is only seen
+//	some hops after it happened, so the points of each sweep are summed up to its furthest
+//	point and the ones after it are handed on to the next sweep.  Least squares lines
+//	through the measured points in Hz and in log2 Hz tell a linear sweep from an
+//	exponential one, whichever fits better; the mean rate then picks the class in
+//	PingSirenRange[].
+//
+//	The sweep times are in ms from the origin given to ping_siren_reset(), worked out from
+//	the number of hops pushed like the pulse edges, so they do not drift with the time the
+//	frames are processed.  The cost is 15 multiply-
+//	adds per sample at the default band and a few dozen operations per frame.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "nordic_common.h"
+#include "arm_math.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+#include "ping_fft.h"
+
+#include "ping_siren.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// Least squares sums of the points of a sweep, t in hops from the sweep origin
+typedef struct
+{
+	float fN;
+	float fT, fTT;
+	float fF, fFF, fTF;		// f in Hz
+	float fL, fLL, fTL;		// log2 f
+} ping_siren_sums_t;
+
+ping_siren_range_t PingSirenRange[PING_SIREN_NUM_CLASSES] =
+{
+	{ PING_SIREN_WAIL_MIN_HZ_S, PING_SIREN_WAIL_MAX_HZ_S },
+	{ PING_SIREN_YELP_MIN_HZ_S, PING_SIREN_YELP_MAX_HZ_S },
+};
+
+const char * const PingSirenClassName[PING_SIREN_NUM_CLASSES] =
+{
+	"wail",
+	"yelp",
+};
+
+ping_siren_sweep_t PingSirenSweep;			// last sweep reported
+bool bPingSirenTrack = false;				// a peak is being tracked
+float PingSirenFrequency = 0.0f;			// tracked frequency, Hz
+float PingSirenRate = 0.0f;				// tracked rate, Hz per second
+volatile uint32_t PingSirenSweeps[PING_SIREN_NUM_CLASSES];
+
+static float SirenCoeff[PING_SIREN_MAX_BINS];
+static uint32_t nSirenBins = 0;
+static uint32_t nSirenFirstBin = 0;
+static float fSirenVelocity = 0.0f;		// Hz per hop
+static uint32_t nSirenMisses = 0;
+static uint32_t SirenOriginMs = 0;
+static uint32_t SirenHops = 0;				// frames since the reset
+
+static int8_t SweepDir = 0;				// +1 rising, -1 falling, 0 neither
+static uint32_t SweepOrigin = 0;			// hop t counts from
+static uint32_t SweepFirstHop = 0;
+static uint32_t SweepLastHop = 0;
+static uint32_t SweepExtremeHop = 0;		// furthest point so far
+static uint32_t SweepTailHop = 0;			// first point after it, 0 for none
+static float fSweepExtreme = 0.0f;		// tracked frequency there
+static float fSweepLast = 0.0f;
+static float fSweepLow = 0.0f;				// range of the tracked frequency, until the direction is known
+static float fSweepHigh = 0.0f;
+static ping_siren_sums_t SweepSums;		// every point
+static ping_siren_sums_t SweepCheck;		// the points up to the furthest one
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The SumsAdd() function adds a point to the least squares sums of a sweep.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static void SumsAdd(ping_siren_sums_t *pSums, float fT, float fF)
+{
+	float fL = log2f(fF);
+
+	pSums->fN += 1.0f;
+	pSums->fT += fT;
+	pSums->fTT += fT * fT;
+	pSums->fF += fF;
+	pSums->fFF += fF * fF;
+	pSums->fTF += fT * fF;
+	pSums->fL += fL;
+	pSums->fLL += fL * fL;
+	pSums->fTL += fT * fL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The SumsFit() function fits a line y = a + b * t to the points of a sweep, in Hz or in
+// log2 Hz.
+//
+// Parameter(s):
+//
+//	bLog			fit log2 f instead of f
+//	pSlope		receives b, per hop
+//	pIntercept	receives a
+//
+// Returns the coefficient of determination, 0 for fewer than three points or a flat line
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static float SumsFit(const ping_siren_sums_t *pSums, bool bLog, float *pSlope, float *pIntercept)
+{
+	float fY = bLog ? pSums->fL : pSums->fF;
+	float fYY = bLog ? pSums->fLL : pSums->fFF;
+	float fTY = bLog ? pSums->fTL : pSums->fTF;
+	float fStt, fSyy, fSty;
+
+	*pSlope = 0.0f;
+	*pIntercept = 0.0f;
+
+	if(pSums->fN < 3.0f)
+	{
+		return 0.0f;
+	}
+
+	// n times the (co)variances
+	fStt = pSums->fN * pSums->fTT - pSums->fT * pSums->fT;
+	fSyy = pSums->fN * fYY - fY * fY;
+	fSty = pSums->fN * fTY - pSums->fT * fY;
+
+	if((fStt <= 0.0f) || (fSyy <= 0.0f))
+	{
+		return 0.0f;
+	}
+
+	*pSlope = fSty / fStt;
+	*pIntercept = (fY - *pSlope * pSums->fT) / pSums->fN;
+
+	return MIN(1.0f, (fSty / fStt) * (fSty / fSyy));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The HopTime() function converts a hop to the time of its middle sample.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static uint32_t HopTime(uint32_t Hop)
+{
+	return SirenOriginMs + (uint32_t) (((uint64_t) Hop * PING_SIREN_HOP - PING_SIREN_HOP / 2) * 1000 / PING_SAMPLE_RATE_HZ);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The SweepEnd() function closes the current sweep at its furthest point and starts the
+// next one with the points after it.
+//
+// Parameter(s):
+//
+//	Dir			direction of the next sweep
+//
+// Returns true if the closed sweep qualifies, it is then left in PingSirenSweep
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool SweepEnd(int8_t Dir)
+{
+	float fSlope[2], fIntercept[2], fFit[2];
+	float fStart, fEnd, fSeconds, fRate, fDelta;
+	uint8_t Shape, Class;
+	bool bSweep = false;
+
+	if((SweepDir != 0) && (SweepExtremeHop > SweepFirstHop))
+	{
+		fFit[PING_SIREN_SHAPE_LINEAR] = SumsFit(&SweepCheck, false, &fSlope[0], &fIntercept[0]);
+		fFit[PING_SIREN_SHAPE_EXPONENTIAL] = SumsFit(&SweepCheck, true, &fSlope[1], &fIntercept[1]);
+		Shape = (fFit[PING_SIREN_SHAPE_EXPONENTIAL] > fFit[PING_SIREN_SHAPE_LINEAR]) ? PING_SIREN_SHAPE_EXPONENTIAL : PING_SIREN_SHAPE_LINEAR;
+
+		fStart = fIntercept[Shape] + fSlope[Shape] * (float) (SweepFirstHop - SweepOrigin);
+		fEnd = fIntercept[Shape] + fSlope[Shape] * (float) (SweepExtremeHop - SweepOrigin);
+
+		if(Shape == PING_SIREN_SHAPE_EXPONENTIAL)
+		{
+			fStart = exp2f(fStart);
+			fEnd = exp2f(fEnd);
+		}
+
+		fSeconds = (SweepExtremeHop - SweepFirstHop) * PING_SIREN_HOP_MS / 1000.0f;
+		fRate = (fEnd - fStart) / fSeconds;
+
+		for(Class=0; Class < PING_SIREN_NUM_CLASSES; Class++)
+		{
+			if((fabsf(fRate) >= PingSirenRange[Class].fMinHzS) && (fabsf(fRate) < PingSirenRange[Class].fMaxHzS))
+			{
+				break;
+			}
+		}
+
+		if((fSeconds * 1000.0f >= PING_SIREN_MIN_SWEEP_MS) && (fabsf(fEnd - fStart) >= PING_SIREN_MIN_SPAN_HZ) &&
+			(fFit[Shape] >= PING_SIREN_MIN_FIT) && ((fRate > 0.0f) == (SweepDir > 0)) && (Class < PING_SIREN_NUM_CLASSES) &&
+			(fStart > 0.0f) && (fEnd > 0.0f))
+		{
+			PingSirenSweep.Class = Class;
+			PingSirenSweep.Shape = Shape;
+			PingSirenSweep.StartMs = HopTime(SweepFirstHop);
+			PingSirenSweep.DurationMs = HopTime(SweepExtremeHop) - PingSirenSweep.StartMs;
+			PingSirenSweep.fStartHz = fStart;
+			PingSirenSweep.fEndHz = fEnd;
+			PingSirenSweep.fRateHzS = fRate;
+			PingSirenSweep.fRateOctS = log2f(fEnd / fStart) / fSeconds;
+			PingSirenSweep.fFit = fFit[Shape];
+			PingSirenSweeps[Class]++;
+			bSweep = true;
+		}
+	}
+
+	if((SweepDir != 0) && (Dir != 0) && (SweepTailHop != 0))
+	{
+		// The points past the turn start the next sweep, moved to an origin of their own
+		SweepSums.fN -= SweepCheck.fN;
+		SweepSums.fT -= SweepCheck.fT;
+		SweepSums.fTT -= SweepCheck.fTT;
+		SweepSums.fF -= SweepCheck.fF;
+		SweepSums.fFF -= SweepCheck.fFF;
+		SweepSums.fTF -= SweepCheck.fTF;
+		SweepSums.fL -= SweepCheck.fL;
+		SweepSums.fLL -= SweepCheck.fLL;
+		SweepSums.fTL -= SweepCheck.fTL;
+
+		fDelta = (float) (SweepTailHop - SweepOrigin);
+		SweepSums.fTT += fDelta * (SweepSums.fN * fDelta - 2.0f * SweepSums.fT);
+		SweepSums.fT -= SweepSums.fN * fDelta;
+		SweepSums.fTF -= fDelta * SweepSums.fF;
+		SweepSums.fTL -= fDelta * SweepSums.fL;
+
+		SweepOrigin = SweepTailHop;
+		SweepFirstHop = SweepTailHop;
+	}
+	else
+	{
+		memset(&SweepSums, 0, sizeof(SweepSums));
+		SweepOrigin = SirenHops;
+		SweepFirstHop = SirenHops;
+	}
+
+	// Until a point goes further, the last one is the furthest
+	SweepCheck = SweepSums;
+	SweepExtremeHop = SweepLastHop;
+	fSweepExtreme = fSweepLast;
+	SweepTailHop = 0;
+	SweepDir = Dir;
+
+	return bSweep;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The SweepAdd() function adds a point to the current sweep, and closes the sweep first if
+// the track has turned back from its furthest point by PING_SIREN_TURN_HZ.  A new sweep
+// takes the direction the track first moves that far in.
+//
+// Parameter(s):
+//
+//	fMeasured	measured peak, what the sweep is fitted to
+//	fTracked		tracked frequency, what turns are told from
+//
+// Returns true if a sweep was closed and qualifies, it is then left in PingSirenSweep
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool SweepAdd(float fMeasured, float fTracked)
+{
+	bool bSweep = false;
+	bool bFurthest;
+
+	if((SweepDir != 0) && ((fSweepExtreme - fTracked) * SweepDir >= PING_SIREN_TURN_HZ))
+	{
+		bSweep = SweepEnd((int8_t) -SweepDir);
+	}
+
+	if(SweepSums.fN == 0.0f)
+	{
+		fSweepLow = fTracked;
+		fSweepHigh = fTracked;
+	}
+
+	fSweepLow = MIN(fSweepLow, fTracked);
+	fSweepHigh = MAX(fSweepHigh, fTracked);
+
+	bFurthest = (SweepSums.fN == 0.0f) || ((fTracked - fSweepExtreme) * SweepDir > 0.0f);
+
+	if(SweepDir == 0)
+	{
+		if(fTracked - fSweepLow >= PING_SIREN_TURN_HZ)
+			SweepDir = 1;
+		else if(fSweepHigh - fTracked >= PING_SIREN_TURN_HZ)
+			SweepDir = -1;
+
+		bFurthest = bFurthest || (SweepDir != 0);
+	}
+
+	SumsAdd(&SweepSums, (float) (SirenHops - SweepOrigin), fMeasured);
+	SweepLastHop = SirenHops;
+	fSweepLast = fTracked;
+
+	if(bFurthest)
+	{
+		SweepCheck = SweepSums;
+		SweepExtremeHop = SirenHops;
+		fSweepExtreme = fTracked;
+		SweepTailHop = 0;
+	}
+	else if(SweepTailHop == 0)
+	{
+		SweepTailHop = SirenHops;
+	}
+
+	return bSweep;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_siren_reset() function sets up the filters for the siren band and starts a new
+// stream, with no track.
+//
+// Parameter(s):
+//
+//	OriginMs		time of the first sample of the stream, the sweep times count from it
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_siren_reset(uint32_t OriginMs)
+{
+	float fBinSize = (float) PING_SAMPLE_RATE_HZ / PING_SIREN_HOP;
+	uint32_t nLo, nHi, nIdx;
+
+	// One guard bin either side, the interpolation needs both neighbours of a peak
+	nLo = (uint32_t) (PING_SIREN_FREQ_LO_HZ / fBinSize + 0.5f);
+	nHi = (uint32_t) (PING_SIREN_FREQ_HI_HZ / fBinSize + 0.5f);
+	nLo = MAX(nLo, 2) - 1;
+	nHi = MIN(nHi + 1, PING_SIREN_HOP / 2 - 1);
+
+	nSirenFirstBin = nLo;
+	nSirenBins = MIN(nHi - nLo + 1, PING_SIREN_MAX_BINS);
+
+	for(nIdx=0; nIdx < nSirenBins; nIdx++)
+	{
+		SirenCoeff[nIdx] = 2.0f * arm_cos_f32(2.0f * PI * (nLo + nIdx) / PING_SIREN_HOP);
+	}
+
+	memset(&PingSirenSweep, 0, sizeof(PingSirenSweep));
+	bPingSirenTrack = false;
+	PingSirenFrequency = 0.0f;
+	PingSirenRate = 0.0f;
+	fSirenVelocity = 0.0f;
+	nSirenMisses = 0;
+	SirenOriginMs = OriginMs;
+	SirenHops = 0;
+
+	SweepDir = 0;
+	SweepLastHop = 0;
+	fSweepLast = 0.0f;
+	SweepEnd(0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_siren_range_set() function sets the mean rate range of a sweep class.
+//
+// Parameter(s):
+//
+//	Class		PING_SIREN_CLASS_xxx
+//	fMinHzS		lowest rate, Hz per second
+//	fMaxHzS		highest rate, no faster than the gate lets the tracker follow
+//
+// Returns false if the range is empty or out of reach
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool ping_siren_range_set(uint8_t Class, float fMinHzS, float fMaxHzS)
+{
+	if((Class >= PING_SIREN_NUM_CLASSES) || (fMinHzS <= 0.0f) || (fMinHzS >= fMaxHzS) ||
+		(fMaxHzS > PING_SIREN_GATE_HZ * 1000.0f / PING_SIREN_HOP_MS))
+	{
+		return false;
+	}
+
+	PingSirenRange[Class].fMinHzS = fMinHzS;
+	PingSirenRange[Class].fMaxHzS = fMaxHzS;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_siren_push() function takes the next I2S frame of the stream, updates the track
+// and looks for the end of a sweep.  Frames must arrive in order; push each frame the ring
+// dropped as an empty one (NULL, 0) so the sweep times stay in step with the audio.
+//
+// Parameter(s):
+//
+//	pStereo		received I2S buffer, one 32-bit stereo word per sample, left channel in
+//				the low halfword, NULL for a dropped frame
+//	nSamples		number of stereo words, frames of another length than PING_SIREN_HOP
+//				count as frames without a peak
+//
+// Returns one of the PING_SIREN_EVT_xxx events, a sweep is left in PingSirenSweep
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint8_t ping_siren_push(const uint32_t *pStereo, uint32_t nSamples)
+{
+	float s0[PING_SIREN_MAX_BINS], s1[PING_SIREN_MAX_BINS], s2[PING_SIREN_MAX_BINS];
+	float Magnitude[PING_SIREN_MAX_BINS];
+	float fSample, fLevel, fPredicted, fResidual;
+	uint32_t nIdx, nBin, nMax;
+	ping_peak_t Peak;
+	bool bPeak = false;
+	uint8_t Event = PING_SIREN_EVT_NONE;
+
+	SirenHops++;
+
+	if((nSamples == PING_SIREN_HOP) && (nSirenBins > 3))
+	{
+		memset(s1, 0, sizeof(s1));
+		memset(s2, 0, sizeof(s2));
+
+		for(nIdx=0; nIdx < PING_SIREN_HOP; nIdx++)
+		{
+			fSample = (float) (int16_t) pStereo[nIdx];
+
+			for(nBin=0; nBin < nSirenBins; nBin++)
+			{
+				s0[nBin] = fSample + SirenCoeff[nBin] * s1[nBin] - s2[nBin];
+				s2[nBin] = s1[nBin];
+				s1[nBin] = s0[nBin];
+			}
+		}
+
+		// Magnitudes scaled to the amplitude of a sinusoid on the bin, strongest inner bin
+		fLevel = 0.0f;
+		nMax = 1;
+
+		for(nBin=0; nBin < nSirenBins; nBin++)
+		{
+			Magnitude[nBin] = s1[nBin] * s1[nBin] + s2[nBin] * s2[nBin] - SirenCoeff[nBin] * s1[nBin] * s2[nBin];
+			Magnitude[nBin] = sqrtf(MAX(Magnitude[nBin], 0.0f)) * (2.0f / PING_SIREN_HOP);
+			fLevel += Magnitude[nBin];
+
+			if((nBin > 0) && (nBin + 1 < nSirenBins) && (Magnitude[nBin] > Magnitude[nMax]))
+			{
+				nMax = nBin;
+			}
+		}
+
+		// The rest of the band, without the peak and the neighbours its tone spreads into
+		fLevel -= Magnitude[nMax - 1] + Magnitude[nMax] + Magnitude[nMax + 1];
+
+		if((Magnitude[nMax] >= PING_SIREN_MIN_LEVEL) && (Magnitude[nMax] * (nSirenBins - 3) >= PING_SIREN_PEAK_RATIO * fLevel))
+		{
+			ping_peak_ratio(Magnitude[nMax - 1], Magnitude[nMax], Magnitude[nMax + 1], nSirenFirstBin + nMax,
+				(float) PING_SAMPLE_RATE_HZ / PING_SIREN_HOP, 1.0f, &Peak);
+			bPeak = true;
+		}
+	}
+
+	if(bPingSirenTrack)
+	{
+		fPredicted = PingSirenFrequency + fSirenVelocity;
+		fResidual = bPeak ? Peak.fFrequency - fPredicted : 0.0f;
+
+		if(bPeak && (fabsf(fResidual) <= PING_SIREN_GATE_HZ))
+		{
+			PingSirenFrequency = fPredicted + PING_SIREN_ALPHA * fResidual;
+			fSirenVelocity += PING_SIREN_BETA * fResidual;
+			PingSirenRate = fSirenVelocity * 1000.0f / PING_SIREN_HOP_MS;
+			nSirenMisses = 0;
+
+			return SweepAdd(Peak.fFrequency, PingSirenFrequency) ? PING_SIREN_EVT_SWEEP : PING_SIREN_EVT_NONE;
+		}
+
+		// Coast on the prediction
+		PingSirenFrequency = fPredicted;
+
+		if(++nSirenMisses <= PING_SIREN_MAX_MISSES)
+		{
+			return PING_SIREN_EVT_NONE;
+		}
+
+		bPingSirenTrack = false;
+		PingSirenRate = 0.0f;
+
+		if(SweepEnd(0))
+		{
+			Event = PING_SIREN_EVT_SWEEP;
+		}
+	}
+
+	if(bPeak)
+	{
+		// A new track, steady until the rate says otherwise
+		bPingSirenTrack = true;
+		PingSirenFrequency = Peak.fFrequency;
+		fSirenVelocity = 0.0f;
+		nSirenMisses = 0;
+		SweepEnd(0);
+		SweepAdd(Peak.fFrequency, PingSirenFrequency);
+	}
+
+	return Event;
+}
@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_siren.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_siren.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_SIREN_H
+#define PING_SIREN_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Events returned by ping_siren_push()
+
+#define PING_SIREN_EVT_NONE			0
+#define PING_SIREN_EVT_SWEEP			1	// A sweep has just ended, see PingSirenSweep
+
+// Sweep classes, each with its own rate range, see ping_siren_range_set()
+
+#define PING_SIREN_CLASS_WAIL		0	// Slow sweep, seconds per rise or fall
+#define PING_SIREN_CLASS_YELP		1	// Fast sweep, a few per second
+
+#define PING_SIREN_NUM_CLASSES		2
+
+// Sweep shapes
+
+#define PING_SIREN_SHAPE_LINEAR		0	// Constant rate in Hz per second
+#define PING_SIREN_SHAPE_EXPONENTIAL	1	// Constant rate in octaves per second
+
+// One hop is one I2S frame, as for the pulse edge detector
+
+#define PING_SIREN_HOP				AUDIO_FRAME_NUM_SAMPLES
+#define PING_SIREN_HOP_MS			((float) PING_SIREN_HOP * 1000.0f / PING_SAMPLE_RATE_HZ)
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Rate range of a sweep class, magnitude of the mean rate in Hz per second
+
+typedef struct
+{
+	float fMinHzS;
+	float fMaxHzS;
+} ping_siren_range_t;
+
+// A rise or fall of the tracked peak.  StartMs is the middle of the first hop of the sweep
+// in ms from the origin given to ping_siren_reset(), DurationMs runs to the middle of the
+// last; both come from the hop count.  The start and end frequencies come from the fitted
+// shape.
+
+typedef struct
+{
+	uint8_t Class;			// PING_SIREN_CLASS_xxx
+	uint8_t Shape;			// PING_SIREN_SHAPE_xxx
+	uint32_t StartMs;
+	uint32_t DurationMs;
+	float fStartHz;
+	float fEndHz;
+	float fRateHzS;			// mean rate, negative for a fall
+	float fRateOctS;			// the same in octaves per second
+	float fFit;				// coefficient of determination of the fitted shape
+} ping_siren_sweep_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern ping_siren_range_t PingSirenRange[PING_SIREN_NUM_CLASSES];
+extern const char * const PingSirenClassName[PING_SIREN_NUM_CLASSES];
+extern ping_siren_sweep_t PingSirenSweep;
+extern bool bPingSirenTrack;
+extern float PingSirenFrequency;
+extern float PingSirenRate;
+extern volatile uint32_t PingSirenSweeps[PING_SIREN_NUM_CLASSES];
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ping_siren_reset(uint32_t OriginMs);
+extern bool ping_siren_range_set(uint8_t Class, float fMinHzS, float fMaxHzS);
+extern uint8_t ping_siren_push(const uint32_t *pStereo, uint32_t nSamples);
+
+#endif //  PING_SIREN_H
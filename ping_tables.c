@@ -0,0 +1,273 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_tables.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Constant tables for the detectors, kept in flash
+//
+//	Generated by tools/ping_tables.py, do not edit.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#include "ping_tables.h"
+
+// Periodic Hann window of PING_HANN_TABLE_LENGTH points, samples 0 to N / 2
+const float PingHannHalf[1025] =
+{
+	0.000000000e+00f, 2.353095212e-06f, 9.412358699e-06f, 2.117772402e-05f, 3.764908043e-05f, 5.882627289e-05f, 8.470910209e-05f, 1.152973244e-04f,
+	1.505906519e-04f, 1.905887524e-04f, 2.352912495e-04f, 2.846977223e-04f, 3.388077058e-04f, 3.976206908e-04f, 4.611361237e-04f, 5.293534066e-04f,
+	6.022718974e-04f, 6.798909099e-04f, 7.622097134e-04f, 8.492275331e-04f, 9.409435499e-04f, 1.037356901e-03f, 1.138466678e-03f, 1.244271930e-03f,
+	1.354771661e-03f, 1.469964830e-03f, 1.589850354e-03f, 1.714427105e-03f, 1.843693909e-03f, 1.977649549e-03f, 2.116292766e-03f, 2.259622254e-03f,
+	2.407636664e-03f, 2.560334603e-03f, 2.717714633e-03f, 2.879775273e-03f, 3.046514999e-03f, 3.217932240e-03f, 3.394025383e-03f, 3.574792770e-03f,
+	3.760232701e-03f, 3.950343429e-03f, 4.145123165e-03f, 4.344570077e-03f, 4.548682286e-03f, 4.757457872e-03f, 4.970894869e-03f, 5.188991268e-03f,
+	5.411745018e-03f, 5.639154020e-03f, 5.871216135e-03f, 6.107929178e-03f, 6.349290921e-03f, 6.595299093e-03f, 6.845951378e-03f, 7.101245416e-03f,
+	7.361178806e-03f, 7.625749099e-03f, 7.894953807e-03f, 8.168790394e-03f, 8.447256284e-03f, 8.730348856e-03f, 9.018065445e-03f, 9.310403343e-03f,
+	9.607359798e-03f, 9.908932016e-03f, 1.021511716e-02f, 1.052591234e-02f, 1.084131464e-02f, 1.116132109e-02f, 1.148592867e-02f, 1.181513433e-02f,
+	1.214893498e-02f, 1.248732747e-02f, 1.283030861e-02f, 1.317787517e-02f, 1.353002390e-02f, 1.388675146e-02f, 1.424805451e-02f, 1.461392964e-02f,
+	1.498437340e-02f, 1.535938232e-02f, 1.573895286e-02f, 1.612308145e-02f, 1.651176448e-02f, 1.690499828e-02f, 1.730277915e-02f, 1.770510336e-02f,
+	1.811196710e-02f, 1.852336656e-02f, 1.893929787e-02f, 1.935975709e-02f, 1.978474029e-02f, 2.021424346e-02f, 2.064826255e-02f, 2.108679349e-02f,
+	2.152983213e-02f, 2.197737433e-02f, 2.242941585e-02f, 2.288595245e-02f, 2.334697982e-02f, 2.381249364e-02f, 2.428248952e-02f, 2.475696303e-02f,
+	2.523590970e-02f, 2.571932504e-02f, 2.620720449e-02f, 2.669954346e-02f, 2.719633731e-02f, 2.769758137e-02f, 2.820327092e-02f, 2.871340120e-02f,
+	2.922796741e-02f, 2.974696470e-02f, 3.027038820e-02f, 3.079823297e-02f, 3.133049404e-02f, 3.186716641e-02f, 3.240824503e-02f, 3.295372480e-02f,
+	3.350360058e-02f, 3.405786721e-02f, 3.461651946e-02f, 3.517955208e-02f, 3.574695976e-02f, 3.631873717e-02f, 3.689487893e-02f, 3.747537961e-02f,
+	3.806023374e-02f, 3.864943583e-02f, 3.924298033e-02f, 3.984086165e-02f, 4.044307415e-02f, 4.104961219e-02f, 4.166047004e-02f, 4.227564196e-02f,
+	4.289512215e-02f, 4.351890479e-02f, 4.414698400e-02f, 4.477935387e-02f, 4.541600845e-02f, 4.605694176e-02f, 4.670214774e-02f, 4.735162034e-02f,
+	4.800535344e-02f, 4.866334088e-02f, 4.932557648e-02f, 4.999205399e-02f, 5.066276715e-02f, 5.133770965e-02f, 5.201687512e-02f, 5.270025718e-02f,
+	5.338784940e-02f, 5.407964530e-02f, 5.477563838e-02f, 5.547582207e-02f, 5.618018980e-02f, 5.688873493e-02f, 5.760145078e-02f, 5.831833067e-02f,
+	5.903936783e-02f, 5.976455547e-02f, 6.049388679e-02f, 6.122735490e-02f, 6.196495290e-02f, 6.270667386e-02f, 6.345251079e-02f, 6.420245667e-02f,
+	6.495650445e-02f, 6.571464701e-02f, 6.647687724e-02f, 6.724318795e-02f, 6.801357194e-02f, 6.878802194e-02f, 6.956653068e-02f, 7.034909082e-02f,
+	7.113569500e-02f, 7.192633581e-02f, 7.272100582e-02f, 7.351969753e-02f, 7.432240345e-02f, 7.512911600e-02f, 7.593982760e-02f, 7.675453061e-02f,
+	7.757321738e-02f, 7.839588018e-02f, 7.922251128e-02f, 8.005310290e-02f, 8.088764722e-02f, 8.172613639e-02f, 8.256856251e-02f, 8.341491765e-02f,
+	8.426519385e-02f, 8.511938310e-02f, 8.597747737e-02f, 8.683946858e-02f, 8.770534861e-02f, 8.857510931e-02f, 8.944874250e-02f, 9.032623996e-02f,
+	9.120759342e-02f, 9.209279460e-02f, 9.298183515e-02f, 9.387470671e-02f, 9.477140087e-02f, 9.567190921e-02f, 9.657622323e-02f, 9.748433443e-02f,
+	9.839623426e-02f, 9.931191414e-02f, 1.002313654e-01f, 1.011545795e-01f, 1.020815477e-01f, 1.030122612e-01f, 1.039467113e-01f, 1.048848893e-01f,
+	1.058267862e-01f, 1.067723932e-01f, 1.077217014e-01f, 1.086747019e-01f, 1.096313857e-01f, 1.105917438e-01f, 1.115557672e-01f, 1.125234467e-01f,
+	1.134947733e-01f, 1.144697379e-01f, 1.154483312e-01f, 1.164305440e-01f, 1.174163672e-01f, 1.184057914e-01f, 1.193988073e-01f, 1.203954055e-01f,
+	1.213955767e-01f, 1.223993116e-01f, 1.234066005e-01f, 1.244174340e-01f, 1.254318027e-01f, 1.264496970e-01f, 1.274711073e-01f, 1.284960239e-01f,
+	1.295244373e-01f, 1.305563378e-01f, 1.315917156e-01f, 1.326305610e-01f, 1.336728642e-01f, 1.347186154e-01f, 1.357678048e-01f, 1.368204225e-01f,
+	1.378764585e-01f, 1.389359030e-01f, 1.399987460e-01f, 1.410649775e-01f, 1.421345874e-01f, 1.432075656e-01f, 1.442839021e-01f, 1.453635868e-01f,
+	1.464466094e-01f, 1.475329598e-01f, 1.486226278e-01f, 1.497156030e-01f, 1.508118753e-01f, 1.519114343e-01f, 1.530142696e-01f, 1.541203708e-01f,
+	1.552297276e-01f, 1.563423296e-01f, 1.574581661e-01f, 1.585772268e-01f, 1.596995011e-01f, 1.608249784e-01f, 1.619536482e-01f, 1.630854998e-01f,
+	1.642205226e-01f, 1.653587058e-01f, 1.665000388e-01f, 1.676445109e-01f, 1.687921112e-01f, 1.699428290e-01f, 1.710966534e-01f, 1.722535735e-01f,
+	1.734135785e-01f, 1.745766575e-01f, 1.757427995e-01f, 1.769119935e-01f, 1.780842286e-01f, 1.792594936e-01f, 1.804377776e-01f, 1.816190694e-01f,
+	1.828033579e-01f, 1.839906320e-01f, 1.851808805e-01f, 1.863740923e-01f, 1.875702559e-01f, 1.887693603e-01f, 1.899713941e-01f, 1.911763460e-01f,
+	1.923842047e-01f, 1.935949588e-01f, 1.948085969e-01f, 1.960251075e-01f, 1.972444793e-01f, 1.984667007e-01f, 1.996917603e-01f, 2.009196465e-01f,
+	2.021503478e-01f, 2.033838525e-01f, 2.046201491e-01f, 2.058592259e-01f, 2.071010713e-01f, 2.083456735e-01f, 2.095930210e-01f, 2.108431018e-01f,
+	2.120959043e-01f, 2.133514167e-01f, 2.146096271e-01f, 2.158705237e-01f, 2.171340946e-01f, 2.184003280e-01f, 2.196692119e-01f, 2.209407344e-01f,
+	2.222148835e-01f, 2.234916472e-01f, 2.247710135e-01f, 2.260529704e-01f, 2.273375058e-01f, 2.286246076e-01f, 2.299142636e-01f, 2.312064619e-01f,
+	2.325011901e-01f, 2.337984361e-01f, 2.350981877e-01f, 2.364004326e-01f, 2.377051587e-01f, 2.390123535e-01f, 2.403220049e-01f, 2.416341005e-01f,
+	2.429486279e-01f, 2.442655748e-01f, 2.455849287e-01f, 2.469066773e-01f, 2.482308081e-01f, 2.495573087e-01f, 2.508861665e-01f, 2.522173691e-01f,
+	2.535509039e-01f, 2.548867584e-01f, 2.562249199e-01f, 2.575653760e-01f, 2.589081140e-01f, 2.602531212e-01f, 2.616003850e-01f, 2.629498927e-01f,
+	2.643016316e-01f, 2.656555890e-01f, 2.670117521e-01f, 2.683701082e-01f, 2.697306445e-01f, 2.710933482e-01f, 2.724582064e-01f, 2.738252064e-01f,
+	2.751943352e-01f, 2.765655799e-01f, 2.779389277e-01f, 2.793143656e-01f, 2.806918807e-01f, 2.820714600e-01f, 2.834530906e-01f, 2.848367593e-01f,
+	2.862224533e-01f, 2.876101594e-01f, 2.889998646e-01f, 2.903915558e-01f, 2.917852200e-01f, 2.931808439e-01f, 2.945784145e-01f, 2.959779186e-01f,
+	2.973793430e-01f, 2.987826746e-01f, 3.001879001e-01f, 3.015950063e-01f, 3.030039800e-01f, 3.044148078e-01f, 3.058274767e-01f, 3.072419731e-01f,
+	3.086582838e-01f, 3.100763955e-01f, 3.114962949e-01f, 3.129179685e-01f, 3.143414030e-01f, 3.157665850e-01f, 3.171935011e-01f, 3.186221378e-01f,
+	3.200524817e-01f, 3.214845194e-01f, 3.229182373e-01f, 3.243536220e-01f, 3.257906599e-01f, 3.272293375e-01f, 3.286696413e-01f, 3.301115578e-01f,
+	3.315550733e-01f, 3.330001743e-01f, 3.344468471e-01f, 3.358950782e-01f, 3.373448539e-01f, 3.387961606e-01f, 3.402489846e-01f, 3.417033122e-01f,
+	3.431591298e-01f, 3.446164236e-01f, 3.460751800e-01f, 3.475353851e-01f, 3.489970253e-01f, 3.504600868e-01f, 3.519245559e-01f, 3.533904187e-01f,
+	3.548576614e-01f, 3.563262702e-01f, 3.577962314e-01f, 3.592675310e-01f, 3.607401553e-01f, 3.622140903e-01f, 3.636893223e-01f, 3.651658372e-01f,
+	3.666436213e-01f, 3.681226605e-01f, 3.696029410e-01f, 3.710844489e-01f, 3.725671702e-01f, 3.740510909e-01f, 3.755361971e-01f, 3.770224748e-01f,
+	3.785099100e-01f, 3.799984888e-01f, 3.814881970e-01f, 3.829790207e-01f, 3.844709459e-01f, 3.859639584e-01f, 3.874580443e-01f, 3.889531895e-01f,
+	3.904493799e-01f, 3.919466015e-01f, 3.934448400e-01f, 3.949440816e-01f, 3.964443119e-01f, 3.979455170e-01f, 3.994476826e-01f, 4.009507946e-01f,
+	4.024548390e-01f, 4.039598015e-01f, 4.054656679e-01f, 4.069724242e-01f, 4.084800560e-01f, 4.099885493e-01f, 4.114978898e-01f, 4.130080633e-01f,
+	4.145190556e-01f, 4.160308525e-01f, 4.175434398e-01f, 4.190568031e-01f, 4.205709283e-01f, 4.220858012e-01f, 4.236014074e-01f, 4.251177327e-01f,
+	4.266347628e-01f, 4.281524834e-01f, 4.296708803e-01f, 4.311899392e-01f, 4.327096457e-01f, 4.342299856e-01f, 4.357509446e-01f, 4.372725083e-01f,
+	4.387946624e-01f, 4.403173926e-01f, 4.418406845e-01f, 4.433645239e-01f, 4.448888964e-01f, 4.464137875e-01f, 4.479391831e-01f, 4.494650686e-01f,
+	4.509914298e-01f, 4.525182523e-01f, 4.540455218e-01f, 4.555732237e-01f, 4.571013438e-01f, 4.586298677e-01f, 4.601587810e-01f, 4.616880693e-01f,
+	4.632177182e-01f, 4.647477133e-01f, 4.662780402e-01f, 4.678086845e-01f, 4.693396318e-01f, 4.708708677e-01f, 4.724023778e-01f, 4.739341477e-01f,
+	4.754661628e-01f, 4.769984089e-01f, 4.785308715e-01f, 4.800635362e-01f, 4.815963885e-01f, 4.831294141e-01f, 4.846625984e-01f, 4.861959271e-01f,
+	4.877293857e-01f, 4.892629599e-01f, 4.907966350e-01f, 4.923303969e-01f, 4.938642309e-01f, 4.953981226e-01f, 4.969320577e-01f, 4.984660216e-01f,
+	5.000000000e-01f, 5.015339784e-01f, 5.030679423e-01f, 5.046018774e-01f, 5.061357691e-01f, 5.076696031e-01f, 5.092033650e-01f, 5.107370401e-01f,
+	5.122706143e-01f, 5.138040729e-01f, 5.153374016e-01f, 5.168705859e-01f, 5.184036115e-01f, 5.199364638e-01f, 5.214691285e-01f, 5.230015911e-01f,
+	5.245338372e-01f, 5.260658523e-01f, 5.275976222e-01f, 5.291291323e-01f, 5.306603682e-01f, 5.321913155e-01f, 5.337219598e-01f, 5.352522867e-01f,
+	5.367822818e-01f, 5.383119307e-01f, 5.398412190e-01f, 5.413701323e-01f, 5.428986562e-01f, 5.444267763e-01f, 5.459544782e-01f, 5.474817477e-01f,
+	5.490085702e-01f, 5.505349314e-01f, 5.520608169e-01f, 5.535862125e-01f, 5.551111036e-01f, 5.566354761e-01f, 5.581593155e-01f, 5.596826074e-01f,
+	5.612053376e-01f, 5.627274917e-01f, 5.642490554e-01f, 5.657700144e-01f, 5.672903543e-01f, 5.688100608e-01f, 5.703291197e-01f, 5.718475166e-01f,
+	5.733652372e-01f, 5.748822673e-01f, 5.763985926e-01f, 5.779141988e-01f, 5.794290717e-01f, 5.809431969e-01f, 5.824565602e-01f, 5.839691475e-01f,
+	5.854809444e-01f, 5.869919367e-01f, 5.885021102e-01f, 5.900114507e-01f, 5.915199440e-01f, 5.930275758e-01f, 5.945343321e-01f, 5.960401985e-01f,
+	5.975451610e-01f, 5.990492054e-01f, 6.005523174e-01f, 6.020544830e-01f, 6.035556881e-01f, 6.050559184e-01f, 6.065551600e-01f, 6.080533985e-01f,
+	6.095506201e-01f, 6.110468105e-01f, 6.125419557e-01f, 6.140360416e-01f, 6.155290541e-01f, 6.170209793e-01f, 6.185118030e-01f, 6.200015112e-01f,
+	6.214900900e-01f, 6.229775252e-01f, 6.244638029e-01f, 6.259489091e-01f, 6.274328298e-01f, 6.289155511e-01f, 6.303970590e-01f, 6.318773395e-01f,
+	6.333563787e-01f, 6.348341628e-01f, 6.363106777e-01f, 6.377859097e-01f, 6.392598447e-01f, 6.407324690e-01f, 6.422037686e-01f, 6.436737298e-01f,
+	6.451423386e-01f, 6.466095813e-01f, 6.480754441e-01f, 6.495399132e-01f, 6.510029747e-01f, 6.524646149e-01f, 6.539248200e-01f, 6.553835764e-01f,
+	6.568408702e-01f, 6.582966878e-01f, 6.597510154e-01f, 6.612038394e-01f, 6.626551461e-01f, 6.641049218e-01f, 6.655531529e-01f, 6.669998257e-01f,
+	6.684449267e-01f, 6.698884422e-01f, 6.713303587e-01f, 6.727706625e-01f, 6.742093401e-01f, 6.756463780e-01f, 6.770817627e-01f, 6.785154806e-01f,
+	6.799475183e-01f, 6.813778622e-01f, 6.828064989e-01f, 6.842334150e-01f, 6.856585970e-01f, 6.870820315e-01f, 6.885037051e-01f, 6.899236045e-01f,
+	6.913417162e-01f, 6.927580269e-01f, 6.941725233e-01f, 6.955851922e-01f, 6.969960200e-01f, 6.984049937e-01f, 6.998120999e-01f, 7.012173254e-01f,
+	7.026206570e-01f, 7.040220814e-01f, 7.054215855e-01f, 7.068191561e-01f, 7.082147800e-01f, 7.096084442e-01f, 7.110001354e-01f, 7.123898406e-01f,
+	7.137775467e-01f, 7.151632407e-01f, 7.165469094e-01f, 7.179285400e-01f, 7.193081193e-01f, 7.206856344e-01f, 7.220610723e-01f, 7.234344201e-01f,
+	7.248056648e-01f, 7.261747936e-01f, 7.275417936e-01f, 7.289066518e-01f, 7.302693555e-01f, 7.316298918e-01f, 7.329882479e-01f, 7.343444110e-01f,
+	7.356983684e-01f, 7.370501073e-01f, 7.383996150e-01f, 7.397468788e-01f, 7.410918860e-01f, 7.424346240e-01f, 7.437750801e-01f, 7.451132416e-01f,
+	7.464490961e-01f, 7.477826309e-01f, 7.491138335e-01f, 7.504426913e-01f, 7.517691919e-01f, 7.530933227e-01f, 7.544150713e-01f, 7.557344252e-01f,
+	7.570513721e-01f, 7.583658995e-01f, 7.596779951e-01f, 7.609876465e-01f, 7.622948413e-01f, 7.635995674e-01f, 7.649018123e-01f, 7.662015639e-01f,
+	7.674988099e-01f, 7.687935381e-01f, 7.700857364e-01f, 7.713753924e-01f, 7.726624942e-01f, 7.739470296e-01f, 7.752289865e-01f, 7.765083528e-01f,
+	7.777851165e-01f, 7.790592656e-01f, 7.803307881e-01f, 7.815996720e-01f, 7.828659054e-01f, 7.841294763e-01f, 7.853903729e-01f, 7.866485833e-01f,
+	7.879040957e-01f, 7.891568982e-01f, 7.904069790e-01f, 7.916543265e-01f, 7.928989287e-01f, 7.941407741e-01f, 7.953798509e-01f, 7.966161475e-01f,
+	7.978496522e-01f, 7.990803535e-01f, 8.003082397e-01f, 8.015332993e-01f, 8.027555207e-01f, 8.039748925e-01f, 8.051914031e-01f, 8.064050412e-01f,
+	8.076157953e-01f, 8.088236540e-01f, 8.100286059e-01f, 8.112306397e-01f, 8.124297441e-01f, 8.136259077e-01f, 8.148191195e-01f, 8.160093680e-01f,
+	8.171966421e-01f, 8.183809306e-01f, 8.195622224e-01f, 8.207405064e-01f, 8.219157714e-01f, 8.230880065e-01f, 8.242572005e-01f, 8.254233425e-01f,
+	8.265864215e-01f, 8.277464265e-01f, 8.289033466e-01f, 8.300571710e-01f, 8.312078888e-01f, 8.323554891e-01f, 8.334999612e-01f, 8.346412942e-01f,
+	8.357794774e-01f, 8.369145002e-01f, 8.380463518e-01f, 8.391750216e-01f, 8.403004989e-01f, 8.414227732e-01f, 8.425418339e-01f, 8.436576704e-01f,
+	8.447702724e-01f, 8.458796292e-01f, 8.469857304e-01f, 8.480885657e-01f, 8.491881247e-01f, 8.502843970e-01f, 8.513773722e-01f, 8.524670402e-01f,
+	8.535533906e-01f, 8.546364132e-01f, 8.557160979e-01f, 8.567924344e-01f, 8.578654126e-01f, 8.589350225e-01f, 8.600012540e-01f, 8.610640970e-01f,
+	8.621235415e-01f, 8.631795775e-01f, 8.642321952e-01f, 8.652813846e-01f, 8.663271358e-01f, 8.673694390e-01f, 8.684082844e-01f, 8.694436622e-01f,
+	8.704755627e-01f, 8.715039761e-01f, 8.725288927e-01f, 8.735503030e-01f, 8.745681973e-01f, 8.755825660e-01f, 8.765933995e-01f, 8.776006884e-01f,
+	8.786044233e-01f, 8.796045945e-01f, 8.806011927e-01f, 8.815942086e-01f, 8.825836328e-01f, 8.835694560e-01f, 8.845516688e-01f, 8.855302621e-01f,
+	8.865052267e-01f, 8.874765533e-01f, 8.884442328e-01f, 8.894082562e-01f, 8.903686143e-01f, 8.913252981e-01f, 8.922782986e-01f, 8.932276068e-01f,
+	8.941732138e-01f, 8.951151107e-01f, 8.960532887e-01f, 8.969877388e-01f, 8.979184523e-01f, 8.988454205e-01f, 8.997686346e-01f, 9.006880859e-01f,
+	9.016037657e-01f, 9.025156656e-01f, 9.034237768e-01f, 9.043280908e-01f, 9.052285991e-01f, 9.061252933e-01f, 9.070181649e-01f, 9.079072054e-01f,
+	9.087924066e-01f, 9.096737600e-01f, 9.105512575e-01f, 9.114248907e-01f, 9.122946514e-01f, 9.131605314e-01f, 9.140225226e-01f, 9.148806169e-01f,
+	9.157348062e-01f, 9.165850824e-01f, 9.174314375e-01f, 9.182738636e-01f, 9.191123528e-01f, 9.199468971e-01f, 9.207774887e-01f, 9.216041198e-01f,
+	9.224267826e-01f, 9.232454694e-01f, 9.240601724e-01f, 9.248708840e-01f, 9.256775966e-01f, 9.264803025e-01f, 9.272789942e-01f, 9.280736642e-01f,
+	9.288643050e-01f, 9.296509092e-01f, 9.304334693e-01f, 9.312119781e-01f, 9.319864281e-01f, 9.327568120e-01f, 9.335231228e-01f, 9.342853530e-01f,
+	9.350434956e-01f, 9.357975433e-01f, 9.365474892e-01f, 9.372933261e-01f, 9.380350471e-01f, 9.387726451e-01f, 9.395061132e-01f, 9.402354445e-01f,
+	9.409606322e-01f, 9.416816693e-01f, 9.423985492e-01f, 9.431112651e-01f, 9.438198102e-01f, 9.445241779e-01f, 9.452243616e-01f, 9.459203547e-01f,
+	9.466121506e-01f, 9.472997428e-01f, 9.479831249e-01f, 9.486622904e-01f, 9.493372328e-01f, 9.500079460e-01f, 9.506744235e-01f, 9.513366591e-01f,
+	9.519946466e-01f, 9.526483797e-01f, 9.532978523e-01f, 9.539430582e-01f, 9.545839915e-01f, 9.552206461e-01f, 9.558530160e-01f, 9.564810952e-01f,
+	9.571048779e-01f, 9.577243580e-01f, 9.583395300e-01f, 9.589503878e-01f, 9.595569258e-01f, 9.601591384e-01f, 9.607570197e-01f, 9.613505642e-01f,
+	9.619397663e-01f, 9.625246204e-01f, 9.631051211e-01f, 9.636812628e-01f, 9.642530402e-01f, 9.648204479e-01f, 9.653834805e-01f, 9.659421328e-01f,
+	9.664963994e-01f, 9.670462752e-01f, 9.675917550e-01f, 9.681328336e-01f, 9.686695060e-01f, 9.692017670e-01f, 9.697296118e-01f, 9.702530353e-01f,
+	9.707720326e-01f, 9.712865988e-01f, 9.717967291e-01f, 9.723024186e-01f, 9.728036627e-01f, 9.733004565e-01f, 9.737927955e-01f, 9.742806750e-01f,
+	9.747640903e-01f, 9.752430370e-01f, 9.757175105e-01f, 9.761875064e-01f, 9.766530202e-01f, 9.771140476e-01f, 9.775705842e-01f, 9.780226257e-01f,
+	9.784701679e-01f, 9.789132065e-01f, 9.793517374e-01f, 9.797857565e-01f, 9.802152597e-01f, 9.806402429e-01f, 9.810607021e-01f, 9.814766334e-01f,
+	9.818880329e-01f, 9.822948966e-01f, 9.826972208e-01f, 9.830950017e-01f, 9.834882355e-01f, 9.838769185e-01f, 9.842610471e-01f, 9.846406177e-01f,
+	9.850156266e-01f, 9.853860704e-01f, 9.857519455e-01f, 9.861132485e-01f, 9.864699761e-01f, 9.868221248e-01f, 9.871696914e-01f, 9.875126725e-01f,
+	9.878510650e-01f, 9.881848657e-01f, 9.885140713e-01f, 9.888386789e-01f, 9.891586854e-01f, 9.894740877e-01f, 9.897848828e-01f, 9.900910680e-01f,
+	9.903926402e-01f, 9.906895967e-01f, 9.909819346e-01f, 9.912696511e-01f, 9.915527437e-01f, 9.918312096e-01f, 9.921050462e-01f, 9.923742509e-01f,
+	9.926388212e-01f, 9.928987546e-01f, 9.931540486e-01f, 9.934047009e-01f, 9.936507091e-01f, 9.938920708e-01f, 9.941287839e-01f, 9.943608460e-01f,
+	9.945882550e-01f, 9.948110087e-01f, 9.950291051e-01f, 9.952425421e-01f, 9.954513177e-01f, 9.956554299e-01f, 9.958548768e-01f, 9.960496566e-01f,
+	9.962397673e-01f, 9.964252072e-01f, 9.966059746e-01f, 9.967820678e-01f, 9.969534850e-01f, 9.971202247e-01f, 9.972822854e-01f, 9.974396654e-01f,
+	9.975923633e-01f, 9.977403777e-01f, 9.978837072e-01f, 9.980223505e-01f, 9.981563061e-01f, 9.982855729e-01f, 9.984101496e-01f, 9.985300352e-01f,
+	9.986452283e-01f, 9.987557281e-01f, 9.988615333e-01f, 9.989626431e-01f, 9.990590565e-01f, 9.991507725e-01f, 9.992377903e-01f, 9.993201091e-01f,
+	9.993977281e-01f, 9.994706466e-01f, 9.995388639e-01f, 9.996023793e-01f, 9.996611923e-01f, 9.997153023e-01f, 9.997647088e-01f, 9.998094112e-01f,
+	9.998494093e-01f, 9.998847027e-01f, 9.999152909e-01f, 9.999411737e-01f, 9.999623509e-01f, 9.999788223e-01f, 9.999905876e-01f, 9.999976469e-01f,
+	1.000000000e+00f,
+};
+
+// First FFT bin of each mel band at PING_MEL_FFT_SIZE points, 100 to 15000 Hz
+const uint16_t PingMelFirstBin[32] =
+{
+	2, 3, 5, 6, 8, 10, 12, 14, 16, 19, 21, 24, 28, 31, 35, 40,
+	45, 50, 56, 62, 69, 76, 84, 93, 103, 114, 126, 139, 153, 168, 185, 204,
+};
+
+// Number of FFT bins in each mel band
+const uint8_t PingMelBinCount[32] =
+{
+	3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 7, 7, 7, 9, 10, 10,
+	11, 12, 13, 14, 15, 17, 19, 21, 23, 25, 27, 29, 32, 36, 39, 42,
+};
+
+// Triangle weights of the mel bands, band after band; PING_MEL_WEIGHTS = 465
+const float PingMelWeight[465] =
+{
+	2.922448686e-01f, 9.082198636e-01f, 1.697335991e-01f, 9.178013637e-02f, 8.302664009e-01f, 4.803063690e-01f, 5.196936310e-01f, 8.222952076e-01f,
+	2.057139473e-01f, 1.777047924e-01f, 7.942860527e-01f, 6.245729668e-01f, 6.117630338e-02f, 3.754270332e-01f, 9.388236966e-01f, 5.410997814e-01f,
+	2.630015838e-02f, 4.589002186e-01f, 9.736998416e-01f, 5.536371502e-01f, 8.324272116e-02f, 4.463628498e-01f, 9.167572788e-01f, 6.462429293e-01f,
+	2.164234247e-01f, 3.537570707e-01f, 7.835765753e-01f, 8.050108767e-01f, 4.122664157e-01f, 1.952195466e-02f, 1.949891233e-01f, 5.877335843e-01f,
+	9.804780453e-01f, 6.589706364e-01f, 3.001032281e-01f, 3.410293636e-01f, 6.998967719e-01f, 9.463046557e-01f, 6.183921590e-01f, 2.904796623e-01f,
+	5.369534435e-02f, 3.816078410e-01f, 7.095203377e-01f, 9.657960186e-01f, 6.661683483e-01f, 3.665406781e-01f, 6.691300792e-02f, 3.420398145e-02f,
+	3.338316517e-01f, 6.334593219e-01f, 9.330869921e-01f, 7.873586619e-01f, 5.135760471e-01f, 2.397934323e-01f, 2.126413381e-01f, 4.864239529e-01f,
+	7.602065677e-01f, 9.689426306e-01f, 7.187757481e-01f, 4.686088657e-01f, 2.184419832e-01f, 3.105736943e-02f, 2.812242519e-01f, 5.313911343e-01f,
+	7.815580168e-01f, 9.710116030e-01f, 7.424234250e-01f, 5.138352470e-01f, 2.852470691e-01f, 5.665889109e-02f, 2.898839701e-02f, 2.575765750e-01f,
+	4.861647530e-01f, 7.147529309e-01f, 9.433411089e-01f, 8.429008586e-01f, 6.340300657e-01f, 4.251592727e-01f, 2.162884797e-01f, 7.417686766e-03f,
+	1.570991414e-01f, 3.659699343e-01f, 5.748407273e-01f, 7.837115203e-01f, 9.925823132e-01f, 8.159236824e-01f, 6.250695073e-01f, 4.342153322e-01f,
+	2.433611570e-01f, 5.250698188e-02f, 1.840763176e-01f, 3.749304927e-01f, 5.657846678e-01f, 7.566388430e-01f, 9.474930181e-01f, 8.735862536e-01f,
+	6.991946326e-01f, 5.248030116e-01f, 3.504113905e-01f, 1.760197695e-01f, 1.628148497e-03f, 1.264137464e-01f, 3.008053674e-01f, 4.751969884e-01f,
+	6.495886095e-01f, 8.239802305e-01f, 9.983718515e-01f, 8.421386275e-01f, 6.827895462e-01f, 5.234404648e-01f, 3.640913835e-01f, 2.047423021e-01f,
+	4.539322077e-02f, 1.578613725e-01f, 3.172104538e-01f, 4.765595352e-01f, 6.359086165e-01f, 7.952576979e-01f, 9.546067792e-01f, 8.958736573e-01f,
+	7.502695876e-01f, 6.046655180e-01f, 4.590614484e-01f, 3.134573788e-01f, 1.678533091e-01f, 2.224923952e-02f, 1.041263427e-01f, 2.497304124e-01f,
+	3.953344820e-01f, 5.409385516e-01f, 6.865426212e-01f, 8.321466909e-01f, 9.777507605e-01f, 8.872854169e-01f, 7.542407523e-01f, 6.211960876e-01f,
+	4.881514230e-01f, 3.551067583e-01f, 2.220620937e-01f, 8.901742901e-02f, 1.127145831e-01f, 2.457592477e-01f, 3.788039124e-01f, 5.118485770e-01f,
+	6.448932417e-01f, 7.779379063e-01f, 9.109825710e-01f, 9.597704321e-01f, 8.382018329e-01f, 7.166332336e-01f, 5.950646343e-01f, 4.734960351e-01f,
+	3.519274358e-01f, 2.303588365e-01f, 1.087902373e-01f, 4.022956787e-02f, 1.617981671e-01f, 2.833667664e-01f, 4.049353657e-01f, 5.265039649e-01f,
+	6.480725642e-01f, 7.696411635e-01f, 8.912097627e-01f, 9.883238642e-01f, 8.772414366e-01f, 7.661590090e-01f, 6.550765814e-01f, 5.439941538e-01f,
+	4.329117262e-01f, 3.218292986e-01f, 2.107468711e-01f, 9.966444346e-02f, 1.167613579e-02f, 1.227585634e-01f, 2.338409910e-01f, 3.449234186e-01f,
+	4.560058462e-01f, 5.670882738e-01f, 6.781707014e-01f, 7.892531289e-01f, 9.003355565e-01f, 9.895668996e-01f, 8.880661355e-01f, 7.865653714e-01f,
+	6.850646072e-01f, 5.835638431e-01f, 4.820630790e-01f, 3.805623148e-01f, 2.790615507e-01f, 1.775607866e-01f, 7.606002245e-02f, 1.043310036e-02f,
+	1.119338645e-01f, 2.134346286e-01f, 3.149353928e-01f, 4.164361569e-01f, 5.179369210e-01f, 6.194376852e-01f, 7.209384493e-01f, 8.224392134e-01f,
+	9.239399776e-01f, 9.767537064e-01f, 8.840081179e-01f, 7.912625294e-01f, 6.985169409e-01f, 6.057713524e-01f, 5.130257639e-01f, 4.202801754e-01f,
+	3.275345869e-01f, 2.347889984e-01f, 1.420434099e-01f, 4.929782140e-02f, 2.324629356e-02f, 1.159918821e-01f, 2.087374706e-01f, 3.014830591e-01f,
+	3.942286476e-01f, 4.869742361e-01f, 5.797198246e-01f, 6.724654131e-01f, 7.652110016e-01f, 8.579565901e-01f, 9.507021786e-01f, 9.602999173e-01f,
+	8.755543072e-01f, 7.908086970e-01f, 7.060630869e-01f, 6.213174767e-01f, 5.365718666e-01f, 4.518262564e-01f, 3.670806463e-01f, 2.823350361e-01f,
+	1.975894260e-01f, 1.128438158e-01f, 2.809820570e-02f, 3.970008269e-02f, 1.244456928e-01f, 2.091913030e-01f, 2.939369131e-01f, 3.786825233e-01f,
+	4.634281334e-01f, 5.481737436e-01f, 6.329193537e-01f, 7.176649639e-01f, 8.024105740e-01f, 8.871561842e-01f, 9.719017943e-01f, 9.482388442e-01f,
+	8.708031564e-01f, 7.933674686e-01f, 7.159317807e-01f, 6.384960929e-01f, 5.610604051e-01f, 4.836247172e-01f, 4.061890294e-01f, 3.287533416e-01f,
+	2.513176537e-01f, 1.738819659e-01f, 9.644627808e-02f, 1.901059025e-02f, 5.176115577e-02f, 1.291968436e-01f, 2.066325314e-01f, 2.840682193e-01f,
+	3.615039071e-01f, 4.389395949e-01f, 5.163752828e-01f, 5.938109706e-01f, 6.712466584e-01f, 7.486823463e-01f, 8.261180341e-01f, 9.035537219e-01f,
+	9.809894098e-01f, 9.466144900e-01f, 8.758581908e-01f, 8.051018915e-01f, 7.343455923e-01f, 6.635892931e-01f, 5.928329938e-01f, 5.220766946e-01f,
+	4.513203954e-01f, 3.805640961e-01f, 3.098077969e-01f, 2.390514977e-01f, 1.682951985e-01f, 9.753889922e-02f, 2.678259999e-02f, 5.338551000e-02f,
+	1.241418092e-01f, 1.948981085e-01f, 2.656544077e-01f, 3.364107069e-01f, 4.071670062e-01f, 4.779233054e-01f, 5.486796046e-01f, 6.194359039e-01f,
+	6.901922031e-01f, 7.609485023e-01f, 8.317048015e-01f, 9.024611008e-01f, 9.732174000e-01f, 9.598193506e-01f, 8.951662944e-01f, 8.305132381e-01f,
+	7.658601819e-01f, 7.012071256e-01f, 6.365540694e-01f, 5.719010132e-01f, 5.072479569e-01f, 4.425949007e-01f, 3.779418444e-01f, 3.132887882e-01f,
+	2.486357319e-01f, 1.839826757e-01f, 1.193296194e-01f, 5.467656319e-02f, 4.018064937e-02f, 1.048337056e-01f, 1.694867619e-01f, 2.341398181e-01f,
+	2.987928744e-01f, 3.634459306e-01f, 4.280989868e-01f, 4.927520431e-01f, 5.574050993e-01f, 6.220581556e-01f, 6.867112118e-01f, 7.513642681e-01f,
+	8.160173243e-01f, 8.806703806e-01f, 9.453234368e-01f, 9.908840517e-01f, 9.318077895e-01f, 8.727315274e-01f, 8.136552652e-01f, 7.545790031e-01f,
+	6.955027409e-01f, 6.364264788e-01f, 5.773502167e-01f, 5.182739545e-01f, 4.591976924e-01f, 4.001214302e-01f, 3.410451681e-01f, 2.819689059e-01f,
+	2.228926438e-01f, 1.638163816e-01f, 1.047401195e-01f, 4.566385733e-02f, 9.115948316e-03f, 6.819221046e-02f, 1.272684726e-01f, 1.863447348e-01f,
+	2.454209969e-01f, 3.044972591e-01f, 3.635735212e-01f, 4.226497833e-01f, 4.817260455e-01f, 5.408023076e-01f, 5.998785698e-01f, 6.589548319e-01f,
+	7.180310941e-01f, 7.771073562e-01f, 8.361836184e-01f, 8.952598805e-01f, 9.543361427e-01f, 9.877445122e-01f, 9.337640053e-01f, 8.797834984e-01f,
+	8.258029915e-01f, 7.718224846e-01f, 7.178419776e-01f, 6.638614707e-01f, 6.098809638e-01f, 5.559004569e-01f, 5.019199500e-01f, 4.479394431e-01f,
+	3.939589362e-01f, 3.399784293e-01f, 2.859979224e-01f, 2.320174155e-01f, 1.780369086e-01f, 1.240564017e-01f, 7.007589476e-02f, 1.609538785e-02f,
+	1.225548781e-02f, 6.623599472e-02f, 1.202165016e-01f, 1.741970085e-01f, 2.281775154e-01f, 2.821580224e-01f, 3.361385293e-01f, 3.901190362e-01f,
+	4.440995431e-01f, 4.980800500e-01f, 5.520605569e-01f, 6.060410638e-01f, 6.600215707e-01f, 7.140020776e-01f, 7.679825845e-01f, 8.219630914e-01f,
+	8.759435983e-01f, 9.299241052e-01f, 9.839046122e-01f, 9.653827467e-01f, 9.160584493e-01f, 8.667341518e-01f, 8.174098544e-01f, 7.680855569e-01f,
+	7.187612595e-01f, 6.694369620e-01f, 6.201126646e-01f, 5.707883671e-01f, 5.214640697e-01f, 4.721397723e-01f, 4.228154748e-01f, 3.734911774e-01f,
+	3.241668799e-01f, 2.748425825e-01f, 2.255182850e-01f, 1.761939876e-01f, 1.268696902e-01f, 7.754539271e-02f, 2.822109527e-02f, 3.461725331e-02f,
+	8.394155075e-02f, 1.332658482e-01f, 1.825901456e-01f, 2.319144431e-01f, 2.812387405e-01f, 3.305630380e-01f, 3.798873354e-01f, 4.292116329e-01f,
+	4.785359303e-01f, 5.278602277e-01f, 5.771845252e-01f, 6.265088226e-01f, 6.758331201e-01f, 7.251574175e-01f, 7.744817150e-01f, 8.238060124e-01f,
+	8.731303098e-01f, 9.224546073e-01f, 9.717789047e-01f, 9.807171018e-01f, 9.356473820e-01f, 8.905776623e-01f, 8.455079425e-01f, 8.004382228e-01f,
+	7.553685030e-01f, 7.102987833e-01f, 6.652290635e-01f, 6.201593438e-01f, 5.750896240e-01f, 5.300199043e-01f, 4.849501845e-01f, 4.398804648e-01f,
+	3.948107450e-01f, 3.497410253e-01f, 3.046713055e-01f, 2.596015858e-01f, 2.145318660e-01f, 1.694621463e-01f, 1.243924265e-01f, 7.932270676e-02f,
+	3.425298701e-02f,
+};
+
+// Orthonormal DCT-II from PING_MEL_BANDS log energies to PING_MFCC_COEFFS coefficients, row per coefficient
+const float PingMfccDct[320] =
+{
+	1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f,
+	1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f,
+	1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f,
+	1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f, 1.767766953e-01f,
+	2.496988641e-01f, 2.472941275e-01f, 2.425078133e-01f, 2.353860163e-01f, 2.259973233e-01f, 2.144321525e-01f, 2.008018829e-01f, 1.852377813e-01f,
+	1.678897387e-01f, 1.489248261e-01f, 1.285256860e-01f, 1.068887734e-01f, 8.422246335e-02f, 6.074504498e-02f, 3.668261861e-02f, 1.226691858e-02f,
+	-1.226691858e-02f, -3.668261861e-02f, -6.074504498e-02f, -8.422246335e-02f, -1.068887734e-01f, -1.285256860e-01f, -1.489248261e-01f, -1.678897387e-01f,
+	-1.852377813e-01f, -2.008018829e-01f, -2.144321525e-01f, -2.259973233e-01f, -2.353860163e-01f, -2.425078133e-01f, -2.472941275e-01f, -2.496988641e-01f,
+	2.487961817e-01f, 2.392350839e-01f, 2.204803161e-01f, 1.932526133e-01f, 1.585983210e-01f, 1.178491842e-01f, 7.257116931e-02f, 2.450428508e-02f,
+	-2.450428508e-02f, -7.257116931e-02f, -1.178491842e-01f, -1.585983210e-01f, -1.932526133e-01f, -2.204803161e-01f, -2.392350839e-01f, -2.487961817e-01f,
+	-2.487961817e-01f, -2.392350839e-01f, -2.204803161e-01f, -1.932526133e-01f, -1.585983210e-01f, -1.178491842e-01f, -7.257116931e-02f, -2.450428508e-02f,
+	2.450428508e-02f, 7.257116931e-02f, 1.178491842e-01f, 1.585983210e-01f, 1.932526133e-01f, 2.204803161e-01f, 2.392350839e-01f, 2.487961817e-01f,
+	2.472941275e-01f, 2.259973233e-01f, 1.852377813e-01f, 1.285256860e-01f, 6.074504498e-02f, -1.226691858e-02f, -8.422246335e-02f, -1.489248261e-01f,
+	-2.008018829e-01f, -2.353860163e-01f, -2.496988641e-01f, -2.425078133e-01f, -2.144321525e-01f, -1.678897387e-01f, -1.068887734e-01f, -3.668261861e-02f,
+	3.668261861e-02f, 1.068887734e-01f, 1.678897387e-01f, 2.144321525e-01f, 2.425078133e-01f, 2.496988641e-01f, 2.353860163e-01f, 2.008018829e-01f,
+	1.489248261e-01f, 8.422246335e-02f, 1.226691858e-02f, -6.074504498e-02f, -1.285256860e-01f, -1.852377813e-01f, -2.259973233e-01f, -2.472941275e-01f,
+	2.451963201e-01f, 2.078674031e-01f, 1.388925583e-01f, 4.877258050e-02f, -4.877258050e-02f, -1.388925583e-01f, -2.078674031e-01f, -2.451963201e-01f,
+	-2.451963201e-01f, -2.078674031e-01f, -1.388925583e-01f, -4.877258050e-02f, 4.877258050e-02f, 1.388925583e-01f, 2.078674031e-01f, 2.451963201e-01f,
+	2.451963201e-01f, 2.078674031e-01f, 1.388925583e-01f, 4.877258050e-02f, -4.877258050e-02f, -1.388925583e-01f, -2.078674031e-01f, -2.451963201e-01f,
+	-2.451963201e-01f, -2.078674031e-01f, -1.388925583e-01f, -4.877258050e-02f, 4.877258050e-02f, 1.388925583e-01f, 2.078674031e-01f, 2.451963201e-01f,
+	2.425078133e-01f, 1.852377813e-01f, 8.422246335e-02f, -3.668261861e-02f, -1.489248261e-01f, -2.259973233e-01f, -2.496988641e-01f, -2.144321525e-01f,
+	-1.285256860e-01f, -1.226691858e-02f, 1.068887734e-01f, 2.008018829e-01f, 2.472941275e-01f, 2.353860163e-01f, 1.678897387e-01f, 6.074504498e-02f,
+	-6.074504498e-02f, -1.678897387e-01f, -2.353860163e-01f, -2.472941275e-01f, -2.008018829e-01f, -1.068887734e-01f, 1.226691858e-02f, 1.285256860e-01f,
+	2.144321525e-01f, 2.496988641e-01f, 2.259973233e-01f, 1.489248261e-01f, 3.668261861e-02f, -8.422246335e-02f, -1.852377813e-01f, -2.425078133e-01f,
+	2.392350839e-01f, 1.585983210e-01f, 2.450428508e-02f, -1.178491842e-01f, -2.204803161e-01f, -2.487961817e-01f, -1.932526133e-01f, -7.257116931e-02f,
+	7.257116931e-02f, 1.932526133e-01f, 2.487961817e-01f, 2.204803161e-01f, 1.178491842e-01f, -2.450428508e-02f, -1.585983210e-01f, -2.392350839e-01f,
+	-2.392350839e-01f, -1.585983210e-01f, -2.450428508e-02f, 1.178491842e-01f, 2.204803161e-01f, 2.487961817e-01f, 1.932526133e-01f, 7.257116931e-02f,
+	-7.257116931e-02f, -1.932526133e-01f, -2.487961817e-01f, -2.204803161e-01f, -1.178491842e-01f, 2.450428508e-02f, 1.585983210e-01f, 2.392350839e-01f,
+	2.353860163e-01f, 1.285256860e-01f, -3.668261861e-02f, -1.852377813e-01f, -2.496988641e-01f, -2.008018829e-01f, -6.074504498e-02f, 1.068887734e-01f,
+	2.259973233e-01f, 2.425078133e-01f, 1.489248261e-01f, -1.226691858e-02f, -1.678897387e-01f, -2.472941275e-01f, -2.144321525e-01f, -8.422246335e-02f,
+	8.422246335e-02f, 2.144321525e-01f, 2.472941275e-01f, 1.678897387e-01f, 1.226691858e-02f, -1.489248261e-01f, -2.425078133e-01f, -2.259973233e-01f,
+	-1.068887734e-01f, 6.074504498e-02f, 2.008018829e-01f, 2.496988641e-01f, 1.852377813e-01f, 3.668261861e-02f, -1.285256860e-01f, -2.353860163e-01f,
+	2.309698831e-01f, 9.567085809e-02f, -9.567085809e-02f, -2.309698831e-01f, -2.309698831e-01f, -9.567085809e-02f, 9.567085809e-02f, 2.309698831e-01f,
+	2.309698831e-01f, 9.567085809e-02f, -9.567085809e-02f, -2.309698831e-01f, -2.309698831e-01f, -9.567085809e-02f, 9.567085809e-02f, 2.309698831e-01f,
+	2.309698831e-01f, 9.567085809e-02f, -9.567085809e-02f, -2.309698831e-01f, -2.309698831e-01f, -9.567085809e-02f, 9.567085809e-02f, 2.309698831e-01f,
+	2.309698831e-01f, 9.567085809e-02f, -9.567085809e-02f, -2.309698831e-01f, -2.309698831e-01f, -9.567085809e-02f, 9.567085809e-02f, 2.309698831e-01f,
+	2.259973233e-01f, 6.074504498e-02f, -1.489248261e-01f, -2.496988641e-01f, -1.678897387e-01f, 3.668261861e-02f, 2.144321525e-01f, 2.353860163e-01f,
+	8.422246335e-02f, -1.285256860e-01f, -2.472941275e-01f, -1.852377813e-01f, 1.226691858e-02f, 2.008018829e-01f, 2.425078133e-01f, 1.068887734e-01f,
+	-1.068887734e-01f, -2.425078133e-01f, -2.008018829e-01f, -1.226691858e-02f, 1.852377813e-01f, 2.472941275e-01f, 1.285256860e-01f, -8.422246335e-02f,
+	-2.353860163e-01f, -2.144321525e-01f, -3.668261861e-02f, 1.678897387e-01f, 2.496988641e-01f, 1.489248261e-01f, -6.074504498e-02f, -2.259973233e-01f,
+};
+
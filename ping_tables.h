@@ -0,0 +1,45 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_tables.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_tables.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_TABLES_H
+#define PING_TABLES_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Length the Hann table is generated for.  Shorter power of two windows take every
+// (PING_HANN_TABLE_LENGTH / N)th sample, and the second half mirrors the first.
+
+#define PING_HANN_TABLE_LENGTH		2048
+
+#define PING_HANN(n, N)		PingHannHalf[(((n) <= (N) / 2) ? (n) : (N) - (n)) * (PING_HANN_TABLE_LENGTH / (N))]
+
+// Mel filterbank for the feature stage, built for one FFT length: PING_MEL_BANDS triangles
+// from 100 Hz to 15 kHz, kept sparse as the first bin and bin count of each band with their
+// PING_MEL_WEIGHTS non-zero weights back to back.  PING_MFCC_COEFFS rows of DCT follow.
+// Changing any of these means changing tools/ping_tables.py to match.
+
+#define PING_MEL_FFT_SIZE			512
+#define PING_MEL_BANDS				32
+#define PING_MEL_WEIGHTS			465
+#define PING_MFCC_COEFFS			10
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern const float PingHannHalf[PING_HANN_TABLE_LENGTH / 2 + 1];
+extern const uint16_t PingMelFirstBin[PING_MEL_BANDS];
+extern const uint8_t PingMelBinCount[PING_MEL_BANDS];
+extern const float PingMelWeight[PING_MEL_WEIGHTS];
+extern const float PingMfccDct[PING_MFCC_COEFFS * PING_MEL_BANDS];
+
+#endif //  PING_TABLES_H
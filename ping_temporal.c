@@ -0,0 +1,208 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_temporal.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Temporal pattern decoder for ISO 8201 alarm signals
+//
+//	A single frame with the peak in the alarm bins says very little, speech and appliances
+//	do that all the time.  The decoder takes the per-frame tone present/absent decisions
+//	with their timestamps, measures the length of every tone and every silence, and only
+//	reports an alarm once the whole cadence has been seen, e.g. for the Temporal-Three (T-3)
+//	pattern: three 0.5 s pulses 0.5 s apart, then a 1.5 s pause, repeated.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "app_config.h"
+
+//  Support for NRF Log Functions
+#include "nrf_log.h"
+
+// Definitions for prototypes, macros and declarations -- Ping-Specific
+
+#include "ping_config.h"
+
+#include "ping_temporal.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Variable and Data Structure Declarations                                                                                               //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+// ISO 8201 / ANSI S3.41 Temporal-Three, used by smoke alarms
+const ping_temporal_config_t PingT3Config =
+{
+	.PulseMs			= 500,
+	.GapMs			= 500,
+	.PauseMs			= 1500,
+	.ToleranceMs		= PING_T3_TOLERANCE_MS,
+	.PulsesPerGroup	= 3,
+	.GroupsToConfirm	= PING_TEMPORAL_GROUPS_TO_CONFIRM,
+};
+
+// Temporal-Four, used by CO alarms: four 0.1 s pulses 0.1 s apart, then a 5 s pause
+const ping_temporal_config_t PingT4Config =
+{
+	.PulseMs			= 100,
+	.GapMs			= 100,
+	.PauseMs			= 5000,
+	.ToleranceMs		= PING_T4_TOLERANCE_MS,
+	.PulsesPerGroup	= 4,
+	.GroupsToConfirm	= PING_TEMPORAL_GROUPS_TO_CONFIRM,
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//  Code Begins                                                                                                                                        //
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The IsWithin() function checks a measured interval against its nominal length.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static bool IsWithin(uint32_t DurationMs, uint16_t NominalMs, uint16_t ToleranceMs)
+{
+	return ((DurationMs + ToleranceMs) >= NominalMs) && (DurationMs <= ((uint32_t) NominalMs + ToleranceMs));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The PatternReset() function drops any partially matched pattern.
+//
+// Returns PING_TEMPORAL_EVT_ENDED if a confirmed alarm has just stopped
+//
+//////////////////////////////////////////////////////////////////////////////
+
+static uint8_t PatternReset(ping_temporal_t *pDecoder)
+{
+	pDecoder->nPulses = 0;
+	pDecoder->nGroups = 0;
+
+	if(pDecoder->bConfirmed)
+	{
+		pDecoder->bConfirmed = false;
+		return PING_TEMPORAL_EVT_ENDED;
+	}
+
+	return PING_TEMPORAL_EVT_NONE;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_temporal_init() function prepares a decoder for a pattern.
+//
+// Parameter(s):
+//
+//	pDecoder		decoder state
+//	pConfig		pattern to watch for, e.g. &PingT3Config
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void ping_temporal_init(ping_temporal_t *pDecoder, const ping_temporal_config_t *pConfig)
+{
+	memset(pDecoder, 0, sizeof(ping_temporal_t));
+	pDecoder->pConfig = pConfig;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The ping_temporal_update() function feeds one tone decision to the decoder.  Decisions
+// must arrive in time order; the interval lengths are only as good as their spacing.
+//
+// Parameter(s):
+//
+//	pDecoder		decoder state
+//	bTone		true if the alarm tone is present in this frame
+//	TimeMs		timestamp of the frame in milliseconds, may wrap
+//
+// Returns one of the PING_TEMPORAL_EVT_xxx events
+//
+//////////////////////////////////////////////////////////////////////////////
+
+uint8_t ping_temporal_update(ping_temporal_t *pDecoder, bool bTone, uint32_t TimeMs)
+{
+	const ping_temporal_config_t *pConfig = pDecoder->pConfig;
+	uint32_t DurationMs;
+
+	if(!pDecoder->bStarted)
+	{
+		pDecoder->bStarted = true;
+		pDecoder->bTone = bTone;
+		pDecoder->EdgeTimeMs = TimeMs;
+		return PING_TEMPORAL_EVT_NONE;
+	}
+
+	DurationMs = TimeMs - pDecoder->EdgeTimeMs;
+
+	if(bTone == pDecoder->bTone)
+	{
+		// No edge, but give up as soon as the current interval is too long to fit the pattern
+
+		if(bTone)
+		{
+			if(DurationMs > ((uint32_t) pConfig->PulseMs + pConfig->ToleranceMs))
+				return PatternReset(pDecoder);
+		}
+		else if(pDecoder->nPulses == pConfig->PulsesPerGroup)
+		{
+			if(DurationMs > ((uint32_t) pConfig->PauseMs + pConfig->ToleranceMs))
+				return PatternReset(pDecoder);
+		}
+		else if(pDecoder->nPulses > 0)
+		{
+			if(DurationMs > ((uint32_t) pConfig->GapMs + pConfig->ToleranceMs))
+				return PatternReset(pDecoder);
+		}
+
+		return PING_TEMPORAL_EVT_NONE;
+	}
+
+	pDecoder->bTone = bTone;
+	pDecoder->EdgeTimeMs = TimeMs;
+
+	if(!bTone)
+	{
+		// End of a pulse
+
+		if(!IsWithin(DurationMs, pConfig->PulseMs, pConfig->ToleranceMs))
+		{
+			return PatternReset(pDecoder);
+		}
+
+		if(++pDecoder->nPulses == pConfig->PulsesPerGroup)
+		{
+			if(pDecoder->nGroups < UINT8_MAX)
+				pDecoder->nGroups++;
+
+			if((pDecoder->nGroups >= pConfig->GroupsToConfirm) && !pDecoder->bConfirmed)
+			{
+				pDecoder->bConfirmed = true;
+				return PING_TEMPORAL_EVT_CONFIRMED;
+			}
+		}
+	}
+	else
+	{
+		// Start of a pulse, check the silence before it
+
+		if(pDecoder->nPulses == pConfig->PulsesPerGroup)
+		{
+			if(!IsWithin(DurationMs, pConfig->PauseMs, pConfig->ToleranceMs))
+				return PatternReset(pDecoder);
+
+			pDecoder->nPulses = 0;
+		}
+		else if(pDecoder->nPulses > 0)
+		{
+			if(!IsWithin(DurationMs, pConfig->GapMs, pConfig->ToleranceMs))
+				return PatternReset(pDecoder);
+		}
+	}
+
+	return PING_TEMPORAL_EVT_NONE;
+}
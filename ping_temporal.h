@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_temporal.h
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping, LLC
+//
+//	Purpose/Functionality:	Defines and externs associated with ping_temporal.c
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PING_TEMPORAL_H
+#define PING_TEMPORAL_H
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// Events returned by ping_temporal_update()
+
+#define PING_TEMPORAL_EVT_NONE			0
+#define PING_TEMPORAL_EVT_CONFIRMED		1	// The pattern has been seen GroupsToConfirm times in a row
+#define PING_TEMPORAL_EVT_ENDED			2	// A confirmed pattern has stopped
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+// A temporal pattern: groups of PulsesPerGroup pulses separated by GapMs, each group followed
+// by PauseMs of silence.  Every interval may be off by up to ToleranceMs.
+
+typedef struct
+{
+	uint16_t PulseMs;
+	uint16_t GapMs;
+	uint16_t PauseMs;
+	uint16_t ToleranceMs;
+	uint8_t PulsesPerGroup;
+	uint8_t GroupsToConfirm;
+} ping_temporal_config_t;
+
+// Decoder state, one per pattern being watched
+
+typedef struct
+{
+	const ping_temporal_config_t *pConfig;
+	bool bStarted;
+	bool bTone;
+	bool bConfirmed;
+	uint32_t EdgeTimeMs;
+	uint8_t nPulses;
+	uint8_t nGroups;
+} ping_temporal_t;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Global Variable Prototypes and Declarations
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern const ping_temporal_config_t PingT3Config;
+extern const ping_temporal_config_t PingT4Config;
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Function Prototypes
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ping_temporal_init(ping_temporal_t *pDecoder, const ping_temporal_config_t *pConfig);
+extern uint8_t ping_temporal_update(ping_temporal_t *pDecoder, bool bTone, uint32_t TimeMs);
+
+#endif //  PING_TEMPORAL_H
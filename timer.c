@@ -18,6 +18,7 @@
 
 //  Support for NRF Log Functions 
 #include "nrf_log.h"
+#include "app_util_platform.h"
 
 // Definitions for prototypes, macros and declarations -- Ping-Specific
 
@@ -34,13 +35,19 @@
 //  Defines                                                                                                                                               //
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-
+// RTC2 counts the 32.768 kHz LFCLK with no prescaler, 30.5 us per tick.  The 24-bit counter
+// wraps every 512 s; RTC0 belongs to the SoftDevice and RTC1 to app_timer.
+#define TIMEBASE_RTC					NRF_RTC2
+#define TIMEBASE_RTC_IRQn				RTC2_IRQn
+#define TIMEBASE_RTC_IRQPriority		APP_IRQ_PRIORITY_LOWEST
+#define TIMEBASE_RTC_COUNTER_BITS		24
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 //  Variable and Data Structure Declarations                                                                                               //
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-uint32_t global_msec_counter = 0;
+// Counter wraps seen so far, the upper bits of the 64-bit tick count
+static volatile uint32_t RtcOverflows = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 //  Function Prototypes                                                                                                                              //
@@ -51,72 +58,103 @@ uint32_t global_msec_counter = 0;
 //  Code Begins                                                                                                                                        //
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-
 //////////////////////////////////////////////////////////////////////////////
 //
-// The ElapsedTimeInMilliseconds function returns the elapsed time in msec
+// The ElapsedTicks() function returns the 64-bit RTC tick count since Rtc2_Init().  It
+// works from any priority, including with interrupts disabled: a wrap whose interrupt has
+// not run yet is still pending in EVENTS_OVRFLW and is counted here.
 //
 //////////////////////////////////////////////////////////////////////////////
 
-uint32_t ElapsedTimeInMilliseconds(void)
+static uint64_t ElapsedTicks(void)
 {
-	return global_msec_counter  * (TIMER1_REPEAT_RATE / 1000);
+	uint32_t Overflows;
+	uint32_t Counter;
+
+	CRITICAL_REGION_ENTER();
+
+	Overflows = RtcOverflows;
+	Counter = TIMEBASE_RTC->COUNTER;
+
+	if(TIMEBASE_RTC->EVENTS_OVRFLW != 0)
+	{
+		// Wrapped but not counted yet, read again so the counter is from after the wrap
+		Overflows++;
+		Counter = TIMEBASE_RTC->COUNTER;
+	}
+
+	CRITICAL_REGION_EXIT();
+
+	return ((uint64_t) Overflows << TIMEBASE_RTC_COUNTER_BITS) | Counter;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 //
-// The Timer1_Init() function initializes the nRF52 timer, which we use to keep track of real time.
+// The ElapsedTimeInMicroseconds function returns the elapsed time in usec, in steps of one
+// RTC tick (1000000 / 32768 = 15625 / 512 usec).  It does not wrap in practice.
 //
-// Parameter(s):
+//////////////////////////////////////////////////////////////////////////////
+
+uint64_t ElapsedTimeInMicroseconds(void)
+{
+	return (ElapsedTicks() * 15625) >> 9;
+}
+
+//////////////////////////////////////////////////////////////////////////////
 //
-//	repeat_rate		number of microseconds between timer interrupts
+// The ElapsedTimeInMilliseconds function returns the elapsed time in msec
 //
 //////////////////////////////////////////////////////////////////////////////
 
-void Timer1_Init(uint32_t repeat_rate)
+uint32_t ElapsedTimeInMilliseconds(void)
 {
+	return (uint32_t) (ElapsedTimeInMicroseconds() / 1000);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// The Rtc2_Init() function starts the free running RTC we use to keep track of real time.
+// Nothing ticks in software: the time is read from the counter on demand and the only
+// interrupt is the counter wrap, every 512 s.  The LFCLK must already be running, which the
+// SoftDevice sees to once DoBLE() has enabled it.
+//
+//////////////////////////////////////////////////////////////////////////////
 
-	NRF_TIMER1->TASKS_STOP = 1;
+void Rtc2_Init(void)
+{
+	TIMEBASE_RTC->TASKS_STOP = 1;
+	TIMEBASE_RTC->TASKS_CLEAR = 1;
+	TIMEBASE_RTC->PRESCALER = 0;
 
-	// Create an Event-Task shortcut to clear Timer 1 on COMPARE[1] event.
-	NRF_TIMER1->SHORTS = (TIMER_SHORTS_COMPARE0_CLEAR_Enabled << TIMER_SHORTS_COMPARE0_CLEAR_Pos);
-	NRF_TIMER1->MODE = TIMER_MODE_MODE_Timer;
-	NRF_TIMER1->BITMODE = (TIMER_BITMODE_BITMODE_16Bit << TIMER_BITMODE_BITMODE_Pos);
-	NRF_TIMER1->PRESCALER = 4; // 1us resolution
-	NRF_TIMER1->INTENSET |= (TIMER_INTENSET_COMPARE0_Set << TIMER_INTENSET_COMPARE0_Pos);
+	RtcOverflows = 0;
 
-	// Sample update needs to happen as soon as possible. The earliest possible moment is MAX_SAMPLE_LEVELS
-	// ticks before changing the output duty cycle.
-	
-	NRF_TIMER1->CC[0] = repeat_rate;
-	NRF_TIMER1->TASKS_START = 1;
+	TIMEBASE_RTC->EVENTS_OVRFLW = 0;
+	TIMEBASE_RTC->EVTENCLR = 0xFFFFFFFF;
+	TIMEBASE_RTC->INTENCLR = 0xFFFFFFFF;
+	TIMEBASE_RTC->INTENSET = (RTC_INTENSET_OVRFLW_Set << RTC_INTENSET_OVRFLW_Pos);
 
-	// Timer1 enable interrupt.
+	NVIC_ClearPendingIRQ(TIMEBASE_RTC_IRQn);
+	NVIC_SetPriority(TIMEBASE_RTC_IRQn, TIMEBASE_RTC_IRQPriority);
+	NVIC_EnableIRQ(TIMEBASE_RTC_IRQn);
 
-	NVIC_EnableIRQ(TIMER1_IRQn);
+	TIMEBASE_RTC->TASKS_START = 1;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 //
-// The TIMER1_IRQHandler() function is the event-handler for a timer interrupt.  It updates
-// a number of global variables with the current time.
-//
-// Some of the counters are reset by individual routines, such as timer_lights_event.  This
-// is a holdover from when the firmware was non-tasking.
+// The RTC2_IRQHandler() function counts the RTC counter wraps.
 //
 //////////////////////////////////////////////////////////////////////////////
 
-void TIMER1_IRQHandler(void)
+void RTC2_IRQHandler(void)
 {
-	// Check if Timer 1 interrupts are enabled and if this interrupt is generated by Timer 1.
-	if ((NRF_TIMER1->EVENTS_COMPARE[0] != 0) &&
-		(NRF_TIMER1->INTENSET | (TIMER_INTENSET_COMPARE0_Set << TIMER_INTENSET_COMPARE0_Pos)))
-	{
-		NRF_TIMER1->EVENTS_COMPARE[0] = 0;
-
-		global_msec_counter++;
+	CRITICAL_REGION_ENTER();
 
+	if(TIMEBASE_RTC->EVENTS_OVRFLW != 0)
+	{
+		TIMEBASE_RTC->EVENTS_OVRFLW = 0;
+		RtcOverflows++;
 	}
-}
-
 
+	CRITICAL_REGION_EXIT();
+}
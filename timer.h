@@ -16,8 +16,8 @@
 // Function Prototypes
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
-extern uint32_t global_msec_counter;
-
-extern void Timer1_Init(uint32_t delayus);
+extern void Rtc2_Init(void);
+extern uint64_t ElapsedTimeInMicroseconds(void);
+extern uint32_t ElapsedTimeInMilliseconds(void);
 
 #endif //  TIMER_H
\ No newline at end of file
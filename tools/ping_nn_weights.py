@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+#
+#	File Name:		ping_nn_weights.py
+#	Author(s):		Jeffery Bahr, Dmitriy Antonets
+#	Copyright Notice:	Copyright, 2019, Ping LLC
+#
+#	Purpose/Functionality:	Generates ping_nn_weights.c, the int8 weights of the sound event
+#							classifier in ping_nn.c.  Run from the repository root:
+#
+#								python3 tools/ping_nn_weights.py [model.npz] > ping_nn_weights.c
+#
+#	model.npz holds the float weights of a trained model with batch norm folded in, under
+#	the names of LAYERS with "_w" and "_b" appended and in the layouts the CMSIS-NN HWC
+#	kernels read (convolutions [out][y][x][in], depthwise [y][x][channel], fully connected
+#	[out][in]); numpy is only needed to read it.  Without a model the weights are seeded
+#	placeholders: the shapes and quantisation of the real thing, useful for wiring, timing
+#	and bit-exact checks, but they classify nothing.
+#
+#	Every layer is quantised to q7 with power of two scales, the format of the CMSIS-NN q7
+#	kernels: weights and biases each get as many fractional bits as their largest value
+#	allows, activations ACTIVATION_FRAC_BITS, the input INPUT_FRAC_BITS.
+#
+#	The generator then runs PingNnTestInput through the quantised network with the integer
+#	arithmetic of the CMSIS-NN q7 reference kernels and emits the ping_nn_selftest() hash
+#	that must come out, PingNnSelfTestExpected; the nn check of ping_test compares them.
+#
+
+import math
+import random
+import sys
+
+# Must match ping_nn.h and PING_NN_INPUT_FRAC_BITS in ping_config.h
+IN_Y = 49
+IN_X = 10
+CHANNELS = 32
+CONV1_KY = 10
+CONV1_KX = 4
+DS_BLOCKS = 4
+DW_K = 3
+CLASSES = 7
+CONV1_STRIDE = 2
+CONV1_PAD_Y = 4
+CONV1_PAD_X = 1
+MAP_Y = (IN_Y + 2 * CONV1_PAD_Y - CONV1_KY) // CONV1_STRIDE + 1
+MAP_X = (IN_X + 2 * CONV1_PAD_X - CONV1_KX) // CONV1_STRIDE + 1
+INPUT_FRAC_BITS = 1
+ACTIVATION_FRAC_BITS = 2
+
+# Name, weight count, fan-in of each layer, in the order of PingNnShift[]
+LAYERS = [("conv1", CHANNELS * CONV1_KY * CONV1_KX, CONV1_KY * CONV1_KX)]
+for block in range(DS_BLOCKS):
+	LAYERS.append(("dw%d" % (block + 1), DW_K * DW_K * CHANNELS, DW_K * DW_K))
+	LAYERS.append(("pw%d" % (block + 1), CHANNELS * CHANNELS, CHANNELS))
+LAYERS.append(("fc", CLASSES * CHANNELS, CHANNELS))
+
+PLACEHOLDER_SEED = 8201
+
+
+def bias_count(name):
+	return CLASSES if name == "fc" else CHANNELS
+
+
+def placeholder_model():
+	rng = random.Random(PLACEHOLDER_SEED)
+	model = {}
+	for name, count, fan_in in LAYERS:
+		scale = 1.0 / math.sqrt(fan_in)
+		model[name + "_w"] = [rng.gauss(0.0, scale) for _ in range(count)]
+		model[name + "_b"] = [rng.gauss(0.0, 0.1) for _ in range(bias_count(name))]
+	return model
+
+
+def load_model(path):
+	import numpy
+
+	archive = numpy.load(path)
+	model = {}
+	for name, count, _ in LAYERS:
+		for suffix, expected in (("_w", count), ("_b", bias_count(name))):
+			values = archive[name + suffix].astype(float).ravel().tolist()
+			if len(values) != expected:
+				sys.exit("%s%s: %d values, expected %d" % (name, suffix, len(values), expected))
+			model[name + suffix] = values
+	return model
+
+
+def frac_bits(values):
+	# Most fractional bits that keep the largest magnitude within q7
+	largest = max(abs(value) for value in values) or 1.0
+	return max(0, min(15, 7 - int(math.ceil(math.log2(largest * 128.0 / 127.0)))))
+
+
+def quantise(values, bits):
+	return [max(-128, min(127, int(round(value * (1 << bits))))) for value in values]
+
+
+def ssat8(value):
+	return max(-128, min(127, value))
+
+
+def accumulator(bias, bias_shift, out_shift):
+	# Bias in the accumulator format plus the rounding of NN_ROUND()
+	return (bias << bias_shift) + ((1 << out_shift) >> 1)
+
+
+def convolve(image, in_x, in_y, ch_in, weight, ch_out, k_x, k_y, pad_x, pad_y, stride, bias, shift, out_x, out_y):
+	# arm_convolve_HWC_q7_basic_nonsquare(), weights [out][y][x][in]; the 1x1 fast kernel
+	# computes the same
+	out = [0] * (out_x * out_y * ch_out)
+	for channel in range(ch_out):
+		for y in range(out_y):
+			for x in range(out_x):
+				total = accumulator(bias[channel], shift[0], shift[1])
+				for m in range(k_y):
+					row = stride * y + m - pad_y
+					if row < 0 or row >= in_y:
+						continue
+					for n in range(k_x):
+						col = stride * x + n - pad_x
+						if col < 0 or col >= in_x:
+							continue
+						pixel = (row * in_x + col) * ch_in
+						kernel = channel * ch_in * k_y * k_x + (m * k_x + n) * ch_in
+						for l in range(ch_in):
+							total += image[pixel + l] * weight[kernel + l]
+				out[(y * out_x + x) * ch_out + channel] = ssat8(total >> shift[1])
+	return out
+
+
+def depthwise(image, size_x, size_y, channels, weight, k, bias, shift):
+	# arm_depthwise_separable_conv_HWC_q7_nonsquare() at stride 1 and same padding, weights
+	# [y][x][channel]
+	out = [0] * (size_x * size_y * channels)
+	for y in range(size_y):
+		for x in range(size_x):
+			for channel in range(channels):
+				total = accumulator(bias[channel], shift[0], shift[1])
+				for m in range(k):
+					row = y + m - k // 2
+					if row < 0 or row >= size_y:
+						continue
+					for n in range(k):
+						col = x + n - k // 2
+						if col < 0 or col >= size_x:
+							continue
+						total += image[(row * size_x + col) * channels + channel] * weight[(m * k + n) * channels + channel]
+				out[(y * size_x + x) * channels + channel] = ssat8(total >> shift[1])
+	return out
+
+
+def relu(values):
+	return [max(0, value) for value in values]
+
+
+def softmax(values):
+	# arm_softmax_q7()
+	base = max(values) - 8
+	total = sum(1 << max(0, min(7, value - base)) for value in values)
+	scale = (1 << 20) // total
+	return [ssat8(scale >> max(0, min(31, 13 + base - value))) for value in values]
+
+
+def selftest(weights, shifts, test_input):
+	# ping_nn_run() and the hash of ping_nn_selftest(), FNV-1a over the map after the last
+	# block, then the logits and scores class by class
+	size = MAP_Y * MAP_X
+	image = relu(convolve(test_input, IN_X, IN_Y, 1, weights["conv1"][0], CHANNELS, CONV1_KX, CONV1_KY,
+		CONV1_PAD_X, CONV1_PAD_Y, CONV1_STRIDE, weights["conv1"][1], shifts[0], MAP_X, MAP_Y))
+	for block in range(DS_BLOCKS):
+		layer = 1 + 2 * block
+		image = relu(depthwise(image, MAP_X, MAP_Y, CHANNELS, weights["dw%d" % (block + 1)][0], DW_K,
+			weights["dw%d" % (block + 1)][1], shifts[layer]))
+		image = relu(convolve(image, MAP_X, MAP_Y, CHANNELS, weights["pw%d" % (block + 1)][0], CHANNELS, 1, 1,
+			0, 0, 1, weights["pw%d" % (block + 1)][1], shifts[layer + 1], MAP_X, MAP_Y))
+	pooled = [(sum(image[pos * CHANNELS + channel] for pos in range(size)) + size // 2) // size for channel in range(CHANNELS)]
+	fc_weight, fc_bias = weights["fc"]
+	logits = [ssat8((accumulator(fc_bias[out], shifts[-1][0], shifts[-1][1]) +
+		sum(pooled[l] * fc_weight[out * CHANNELS + l] for l in range(CHANNELS))) >> shifts[-1][1]) for out in range(CLASSES)]
+	scores = softmax(logits)
+	value = 2166136261
+	for byte in image + [byte for pair in zip(logits, scores) for byte in pair]:
+		value = ((value ^ (byte & 0xff)) * 16777619) & 0xffffffff
+	return value
+
+
+def emit_int8_table(name, dims, values, comment):
+	print("// %s" % comment)
+	print("const int8_t %s%s =" % (name, "".join("[%d]" % dim for dim in dims)))
+	print("{")
+	if len(dims) == 1:
+		for start in range(0, len(values), 16):
+			print("\t%s," % ", ".join("%d" % value for value in values[start:start + 16]))
+	else:
+		for outer in range(dims[0]):
+			row = values[outer * dims[1]:(outer + 1) * dims[1]]
+			print("\t{")
+			for start in range(0, len(row), 16):
+				print("\t\t%s," % ", ".join("%d" % value for value in row[start:start + 16]))
+			print("\t},")
+	print("};")
+	print("")
+
+
+def main():
+	model = load_model(sys.argv[1]) if len(sys.argv) > 1 else placeholder_model()
+	source = sys.argv[1] if len(sys.argv) > 1 else "seeded placeholders (seed %d)" % PLACEHOLDER_SEED
+
+	print("""/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_nn_weights.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Weights of the sound event classifier, kept in flash
+//
+//	Generated by tools/ping_nn_weights.py from %s, do not edit.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ping_config.h"
+#include "ping_tables.h"
+#include "ping_nn.h"
+
+#if PING_NN_ENABLED
+""" % source)
+
+	shifts = []
+	weights = {}
+	in_bits = INPUT_FRAC_BITS
+
+	for name, _, _ in LAYERS:
+		w_bits = frac_bits(model[name + "_w"])
+		b_bits = min(frac_bits(model[name + "_b"]), in_bits + w_bits)
+		out_bits = ACTIVATION_FRAC_BITS
+		if in_bits + w_bits < out_bits:
+			sys.exit("%s: %d fractional bits in the accumulator, %d wanted out" % (name, in_bits + w_bits, out_bits))
+		weights[name] = (quantise(model[name + "_w"], w_bits), quantise(model[name + "_b"], b_bits))
+		shifts.append((in_bits + w_bits - b_bits, in_bits + w_bits - out_bits))
+		# Average pooling keeps the activation format
+		in_bits = out_bits
+
+	emit_int8_table("PingNnConv1Weight", [CHANNELS * CONV1_KY * CONV1_KX], weights["conv1"][0],
+		"First convolution, [out][y][x], one input channel")
+	emit_int8_table("PingNnConv1Bias", [CHANNELS], weights["conv1"][1], "First convolution bias")
+
+	emit_int8_table("PingNnDwWeight", [DS_BLOCKS, DW_K * DW_K * CHANNELS],
+		sum((weights["dw%d" % (block + 1)][0] for block in range(DS_BLOCKS)), []),
+		"Depthwise convolutions, [block][y][x][channel]")
+	emit_int8_table("PingNnDwBias", [DS_BLOCKS, CHANNELS],
+		sum((weights["dw%d" % (block + 1)][1] for block in range(DS_BLOCKS)), []), "Depthwise convolution biases")
+
+	emit_int8_table("PingNnPwWeight", [DS_BLOCKS, CHANNELS * CHANNELS],
+		sum((weights["pw%d" % (block + 1)][0] for block in range(DS_BLOCKS)), []),
+		"Pointwise convolutions, [block][out][in]")
+	emit_int8_table("PingNnPwBias", [DS_BLOCKS, CHANNELS],
+		sum((weights["pw%d" % (block + 1)][1] for block in range(DS_BLOCKS)), []), "Pointwise convolution biases")
+
+	emit_int8_table("PingNnFcWeight", [CLASSES * CHANNELS], weights["fc"][0], "Fully connected layer, [class][channel]")
+	emit_int8_table("PingNnFcBias", [CLASSES], weights["fc"][1], "Fully connected bias")
+
+	print("// Bias left shift and output right shift of each layer, PING_NN_LAYER_xxx order")
+	print("const uint8_t PingNnShift[%d][2] =" % len(shifts))
+	print("{")
+	for (name, _, _), (bias_shift, out_shift) in zip(LAYERS, shifts):
+		print("\t{ %d, %d },\t\t// %s" % (bias_shift, out_shift, name))
+	print("};")
+	print("")
+
+	# A fixed input for ping_nn_selftest(): a rising chirp across the coefficients with
+	# some noise, so every layer sees varied values
+	rng = random.Random(PLACEHOLDER_SEED + 1)
+	test_input = [max(-128, min(127, int(round(40.0 * math.sin(0.3 * y + 0.7 * x + 0.01 * y * y) + rng.gauss(0.0, 8.0)))))
+		for y in range(IN_Y) for x in range(IN_X)]
+	emit_int8_table("PingNnTestInput", [IN_Y * IN_X], test_input, "Self test input, [y][x] in the input format")
+
+	print("// What ping_nn_selftest() must return with these weights")
+	print("const uint32_t PingNnSelfTestExpected = 0x%08x;" % selftest(weights, shifts, test_input))
+	print("")
+	print("#endif // PING_NN_ENABLED")
+
+
+if __name__ == "__main__":
+	main()
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+#
+#	File Name:		ping_tables.py
+#	Author(s):		Jeffery Bahr, Dmitriy Antonets
+#	Copyright Notice:	Copyright, 2019, Ping LLC
+#
+#	Purpose/Functionality:	Generates ping_tables.c, the constant tables the detectors
+#							keep in flash.  Run from the repository root:
+#
+#								python3 tools/ping_tables.py > ping_tables.c
+#
+
+import math
+
+HANN_LENGTH = 2048
+
+# Mel filterbank and DCT, must match PING_MEL_xxx and PING_MFCC_xxx in ping_tables.h
+SAMPLE_RATE_HZ = 31250
+MEL_FFT_SIZE = 512
+MEL_BANDS = 32
+MEL_LO_HZ = 100.0
+MEL_HI_HZ = 15000.0
+MFCC_COEFFS = 10
+
+
+def emit_float_table(name, values, comment):
+	print("// %s" % comment)
+	print("const float %s[%d] =" % (name, len(values)))
+	print("{")
+	for start in range(0, len(values), 8):
+		row = ", ".join("%.9ef" % value for value in values[start:start + 8])
+		print("\t%s," % row)
+	print("};")
+	print("")
+
+
+def emit_int_table(name, ctype, values, comment):
+	print("// %s" % comment)
+	print("const %s %s[%d] =" % (ctype, name, len(values)))
+	print("{")
+	for start in range(0, len(values), 16):
+		row = ", ".join("%d" % value for value in values[start:start + 16])
+		print("\t%s," % row)
+	print("};")
+	print("")
+
+
+def hz_to_mel(hz):
+	return 2595.0 * math.log10(1.0 + hz / 700.0)
+
+
+def mel_to_hz(mel):
+	return 700.0 * (10.0 ** (mel / 2595.0) - 1.0)
+
+
+def mel_filterbank():
+	# Triangles with unit peak on the HTK mel scale, band b rising from edge b to edge b + 1
+	# and falling to edge b + 2.  Only the non-zero weights are kept, with the first bin and
+	# the number of bins of each band; bin 0 (DC and Nyquist packed) is left out.
+	bin_hz = float(SAMPLE_RATE_HZ) / MEL_FFT_SIZE
+	lo, hi = hz_to_mel(MEL_LO_HZ), hz_to_mel(MEL_HI_HZ)
+	edges = [mel_to_hz(lo + (hi - lo) * n / (MEL_BANDS + 1)) for n in range(MEL_BANDS + 2)]
+	first_bins, bin_counts, weights = [], [], []
+
+	for band in range(MEL_BANDS):
+		left, centre, right = edges[band], edges[band + 1], edges[band + 2]
+		band_weights = []
+		first = None
+
+		for nbin in range(1, MEL_FFT_SIZE // 2):
+			hz = nbin * bin_hz
+			if left < hz < right:
+				weight = (hz - left) / (centre - left) if hz <= centre else (right - hz) / (right - centre)
+				if first is None:
+					first = nbin
+				band_weights.append(weight)
+
+		if first is None:
+			# Narrower than a bin, take the bin nearest the centre
+			first = max(1, int(round(centre / bin_hz)))
+			band_weights = [1.0]
+
+		first_bins.append(first)
+		bin_counts.append(len(band_weights))
+		weights.extend(band_weights)
+
+	return first_bins, bin_counts, weights
+
+
+def mfcc_dct():
+	# Orthonormal DCT-II, one row of MEL_BANDS weights per coefficient
+	table = []
+	for k in range(MFCC_COEFFS):
+		scale = math.sqrt((1.0 if k == 0 else 2.0) / MEL_BANDS)
+		table.extend(scale * math.cos(math.pi * k * (n + 0.5) / MEL_BANDS) for n in range(MEL_BANDS))
+	return table
+
+
+def main():
+	print("""/////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File Name:		ping_tables.c
+//	Author(s):		Jeffery Bahr, Dmitriy Antonets
+//	Copyright Notice:	Copyright, 2019, Ping LLC
+//
+//	Purpose/Functionality:	Constant tables for the detectors, kept in flash
+//
+//	Generated by tools/ping_tables.py, do not edit.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#include "ping_tables.h"
+""")
+
+	hann = [0.5 - 0.5 * math.cos(2.0 * math.pi * n / HANN_LENGTH) for n in range(HANN_LENGTH // 2 + 1)]
+	emit_float_table("PingHannHalf", hann,
+		"Periodic Hann window of PING_HANN_TABLE_LENGTH points, samples 0 to N / 2")
+
+	first_bins, bin_counts, weights = mel_filterbank()
+	emit_int_table("PingMelFirstBin", "uint16_t", first_bins,
+		"First FFT bin of each mel band at PING_MEL_FFT_SIZE points, %g to %g Hz" % (MEL_LO_HZ, MEL_HI_HZ))
+	emit_int_table("PingMelBinCount", "uint8_t", bin_counts,
+		"Number of FFT bins in each mel band")
+	emit_float_table("PingMelWeight", weights,
+		"Triangle weights of the mel bands, band after band; PING_MEL_WEIGHTS = %d" % len(weights))
+	emit_float_table("PingMfccDct", mfcc_dct(),
+		"Orthonormal DCT-II from PING_MEL_BANDS log energies to PING_MFCC_COEFFS coefficients, row per coefficient")
+
+
+if __name__ == "__main__":
+	main()